@@ -0,0 +1,116 @@
+#include <audio-file-reading-writing/AudioFileInMemory.h>
+#include <gsl/gsl>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+// Times the reads an audio callback makes of a stimulus held in memory,
+// against reading the same audio from one interleaved buffer the way
+// AudioFileInMemory used to.
+
+class SilentAudioFileReader : public AudioFileReader {
+	long long frames_;
+	int channels_;
+public:
+	SilentAudioFileReader(long long frames, int channels) :
+		frames_{ frames },
+		channels_{ channels } {}
+
+	long long frames() override {
+		return frames_;
+	}
+
+	int channels() override {
+		return channels_;
+	}
+
+	int sampleRate() override {
+		return 48000;
+	}
+
+	void readFrames(float *x, long long n) override {
+		std::fill(x, x + n * channels_, 0.0f);
+	}
+
+	void seek(long long) override {}
+
+	bool failed() override {
+		return false;
+	}
+
+	std::string errorMessage() override {
+		return {};
+	}
+};
+
+using channel_type = AudioFrameReader::channel_type;
+using buffer_type = std::vector<channel_type::element_type>;
+
+void readInterleaved(
+	const buffer_type &buffer,
+	std::size_t &head,
+	int channels,
+	gsl::span<channel_type> audio
+) {
+	std::size_t samples{ 0 };
+	for (int i{ 0 }; i < channels; ++i) {
+		auto channel = audio[i];
+		samples = std::min(
+			gsl::narrow<std::size_t>(channel.size()),
+			(buffer.size() - head) / channels
+		);
+		for (std::size_t j{ 0 }; j < samples; ++j)
+			channel.at(j) = buffer.at(head + i + j * channels);
+	}
+	head += samples * channels;
+}
+
+template<typename F>
+double nanosecondsPerCallback(F read, int callbacks) {
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < callbacks; ++i)
+		read();
+	const std::chrono::duration<double, std::nano> elapsed =
+		std::chrono::steady_clock::now() - start;
+	return elapsed.count() / callbacks;
+}
+
+void profile(int channels) {
+	constexpr int framesPerBuffer = 256;
+	constexpr long long frames = 48000 * 60;
+	const auto callbacks = gsl::narrow<int>(frames / framesPerBuffer);
+
+	std::vector<buffer_type> buffers(channels, buffer_type(framesPerBuffer));
+	std::vector<channel_type> audio(buffers.begin(), buffers.end());
+
+	SilentAudioFileReader reader{ frames, channels };
+	AudioFileInMemory planar{ reader };
+	const auto planarCost = nanosecondsPerCallback(
+		[&]() { planar.read(audio); },
+		callbacks
+	);
+
+	SilentAudioFileReader compactReader{ frames, channels };
+	AudioFileInMemory compact{ compactReader, AudioFileInMemory::Storage::compact };
+	const auto compactCost = nanosecondsPerCallback(
+		[&]() { compact.read(audio); },
+		callbacks
+	);
+
+	buffer_type interleaved(gsl::narrow<std::size_t>(frames * channels));
+	std::size_t head{ 0 };
+	const auto interleavedCost = nanosecondsPerCallback(
+		[&]() { readInterleaved(interleaved, head, channels, audio); },
+		callbacks
+	);
+
+	std::cout << channels << " channels, " << framesPerBuffer << " frames per callback: "
+		<< interleavedCost << " ns interleaved, "
+		<< planarCost << " ns planar, "
+		<< compactCost << " ns planar compact\n";
+}
+
+int main() {
+	profile(2);
+	profile(8);
+}
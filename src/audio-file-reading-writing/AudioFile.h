@@ -11,6 +11,8 @@ public:
 	virtual int channels() = 0;
 	virtual int sampleRate() = 0;
 	virtual void readFrames(float *, long long) = 0;
+	// Reading continues from the given frame.
+	virtual void seek(long long frame) = 0;
 	virtual bool failed() = 0;
 	virtual std::string errorMessage() = 0;
 };
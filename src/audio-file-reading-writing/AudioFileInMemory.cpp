@@ -1,49 +1,41 @@
 #include "AudioFileInMemory.h"
 #include <gsl/gsl>
+#include <algorithm>
 
-AudioFileInMemory::AudioFileInMemory(AudioFileReader &reader) :
-	buffer(gsl::narrow<size_type>(reader.frames() * reader.channels())),
-	frames_{ reader.frames() },
-	channels_{ reader.channels() },
-	sampleRate_{ reader.sampleRate() }
-{
-	if (reader.failed())
-		throw FileError{ reader.errorMessage() };
-	if (buffer.size())
-		reader.readFrames(&buffer.front(), reader.frames());
-}
+AudioFileInMemory::AudioFileInMemory(AudioFileReader &reader, Storage storage) :
+	audio{ std::make_shared<const DecodedAudio>(reader, storage) } {}
+
+AudioFileInMemory::AudioFileInMemory(
+	std::shared_ptr<const DecodedAudio> audio
+) noexcept :
+	audio{ std::move(audio) } {}
 
-void AudioFileInMemory::read(gsl::span<channel_type> audio) {
-	if (audio.size() != channels_)
+void AudioFileInMemory::read(gsl::span<channel_type> x) {
+	if (x.size() != audio->channels())
 		return;
 	size_type samples{ 0 };
-	for (int i{ 0 }; i < channels_; ++i) {
-		auto channel = audio[i];
+	for (int i{ 0 }; i < audio->channels(); ++i) {
+		auto channel = x[i];
 		samples = std::min(gsl::narrow<size_type>(channel.size()), remainingFrames_());
-		for (size_type j{ 0 }; j < samples; ++j)
-			channel.at(j) = buffer.at(head + i + j * channels_);
+		audio->copy(i, head, channel.first(gsl::narrow<channel_type::index_type>(samples)));
 	}
-	head += samples * channels_;
+	head += samples;
 }
 
 bool AudioFileInMemory::complete() {
-	return complete_();
-}
-
-bool AudioFileInMemory::complete_() {
-	return head == buffer.size();
+	return remainingFrames_() == 0;
 }
 
 int AudioFileInMemory::sampleRate() {
-	return sampleRate_;
+	return audio->sampleRate();
 }
 
 int AudioFileInMemory::channels() {
-	return channels_;
+	return audio->channels();
 }
 
 long long AudioFileInMemory::frames() {
-	return frames_;
+	return audio->frames();
 }
 
 void AudioFileInMemory::reset() {
@@ -54,21 +46,34 @@ long long AudioFileInMemory::remainingFrames() {
 	return remainingFrames_();
 }
 
+void AudioFileInMemory::prepareForPlayback() {}
+
 auto AudioFileInMemory::remainingFrames_() -> size_type {
-	return (buffer.size() - head) / channels_;
+	return audio->frames() - head;
+}
+
+std::size_t AudioFileInMemory::bytes() const noexcept {
+	return audio->bytes();
+}
+
+std::shared_ptr<const DecodedAudio> AudioFileInMemory::decoded() const {
+	return audio;
 }
 
 AudioFileInMemoryFactory::AudioFileInMemoryFactory(
-	AudioFileFactory *factory
+	AudioFileFactory *factory,
+	AudioFileInMemory::Storage storage
 ) noexcept :
-	factory{ factory } {}
+	factory{ factory },
+	storage{ storage } {}
 
 std::shared_ptr<AudioFrameReader> AudioFileInMemoryFactory::make(
 	std::string filePath
 ) {
 	try {
 		return std::make_shared<AudioFileInMemory>(
-			*factory->makeReader(std::move(filePath))
+			*factory->makeReader(std::move(filePath)),
+			storage
 		);
 	}
 	catch (const AudioFileInMemory::FileError &e) {
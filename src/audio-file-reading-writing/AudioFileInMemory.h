@@ -1,22 +1,26 @@
 #pragma once
 
-#include "AudioFile.h"
+#include "DecodedAudio.h"
 #include "audio-file-reading-writing-exports.h"
 #include <spatialized-hearing-aid-simulation/AudioFrameReader.h>
-#include <common-includes/RuntimeError.h>
-#include <vector>
+#include <memory>
 
+// Reads decoded audio from its own position. Readers made from the same
+// decoded audio share it, so each one costs only its position.
 class AudioFileInMemory : public AudioFrameReader {
-	using buffer_type = std::vector<channel_type::element_type>;
-	using size_type = buffer_type::size_type;
-	buffer_type buffer;
+	using size_type = long long;
+	std::shared_ptr<const DecodedAudio> audio;
 	size_type head = 0;
-	long long frames_;
-	int channels_;
-	int sampleRate_;
 public:
-	AUDIO_FILE_READING_WRITING_API explicit AudioFileInMemory(AudioFileReader &);
-    RUNTIME_ERROR(FileError)
+	using Storage = DecodedAudio::Storage;
+	using FileError = DecodedAudio::FileError;
+	AUDIO_FILE_READING_WRITING_API explicit AudioFileInMemory(
+		AudioFileReader &,
+		Storage = Storage::full
+	);
+	AUDIO_FILE_READING_WRITING_API explicit AudioFileInMemory(
+		std::shared_ptr<const DecodedAudio>
+	) noexcept;
 	AUDIO_FILE_READING_WRITING_API void read(gsl::span<channel_type> audio) override;
 	AUDIO_FILE_READING_WRITING_API bool complete() override;
 	AUDIO_FILE_READING_WRITING_API int sampleRate() override;
@@ -24,16 +28,20 @@ public:
 	AUDIO_FILE_READING_WRITING_API long long frames() override;
 	AUDIO_FILE_READING_WRITING_API void reset() override;
     AUDIO_FILE_READING_WRITING_API long long remainingFrames() override;
+	AUDIO_FILE_READING_WRITING_API void prepareForPlayback() override;
+	AUDIO_FILE_READING_WRITING_API std::size_t bytes() const noexcept;
+	AUDIO_FILE_READING_WRITING_API std::shared_ptr<const DecodedAudio> decoded() const;
 private:
-	bool complete_();
 	size_type remainingFrames_();
 };
 
 class AudioFileInMemoryFactory : public AudioFrameReaderFactory {
 	AudioFileFactory *factory;
+	AudioFileInMemory::Storage storage;
 public:
 	AUDIO_FILE_READING_WRITING_API explicit AudioFileInMemoryFactory(
-		AudioFileFactory *
+		AudioFileFactory *,
+		AudioFileInMemory::Storage = AudioFileInMemory::Storage::full
 	) noexcept;
 	AUDIO_FILE_READING_WRITING_API 
 		std::shared_ptr<AudioFrameReader> make(std::string filePath) override;
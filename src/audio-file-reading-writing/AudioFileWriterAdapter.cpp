@@ -1,5 +1,5 @@
 #include "AudioFileWriterAdapter.h"
-#include <vector>
+#include <algorithm>
 
 AudioFileWriterAdapter::AudioFileWriterAdapter(std::shared_ptr<AudioFileWriter> writer) :
 	writer{ std::move(writer) } 
@@ -20,12 +20,19 @@ void AudioFileWriterAdapter::write(gsl::span<channel_type> audio) {
 		}
 	);
 	const auto frames = smallestChannel->size();
-	std::vector<channel_type::element_type> buffer{};
-	for (int i = 0; i < frames; ++i)
-		for (auto channel : audio)
-			buffer.push_back(channel.at(i));
-	if (buffer.size() > 0)
-		writer->writeFrames(&buffer.front(), frames);
+	if (frames == 0)
+		return;
+
+	// Written block by block, so the buffer grows once to the block size 
+	// and is reused after that.
+	const auto channels = audio.size();
+	interleaved.resize(gsl::narrow<std::size_t>(frames * channels));
+	for (gsl::span<channel_type>::index_type j{ 0 }; j < channels; ++j) {
+		const auto channel = audio[j];
+		for (channel_type::index_type i{ 0 }; i < frames; ++i)
+			interleaved[gsl::narrow_cast<std::size_t>(i * channels + j)] = channel[i];
+	}
+	writer->writeFrames(interleaved.data(), frames);
 }
 
 AudioFileWriterAdapterFactory::AudioFileWriterAdapterFactory(AudioFileFactory *factory) : 
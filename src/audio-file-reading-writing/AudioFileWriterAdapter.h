@@ -4,8 +4,10 @@
 #include "audio-file-reading-writing-exports.h"
 #include <spatialized-hearing-aid-simulation/AudioFrameWriter.h>
 #include <common-includes/RuntimeError.h>
+#include <vector>
 
 class AudioFileWriterAdapter : public AudioFrameWriter {
+	std::vector<channel_type::element_type> interleaved{};
 	std::shared_ptr<AudioFileWriter> writer;
 public:
 	AUDIO_FILE_READING_WRITING_API explicit AudioFileWriterAdapter(std::shared_ptr<AudioFileWriter>);
@@ -0,0 +1,119 @@
+#include "DecodedAudio.h"
+#include <algorithm>
+
+DecodedAudio::DecodedAudio(AudioFileReader &reader, Storage storage) :
+	frames_{ reader.frames() },
+	channels_{ reader.channels() },
+	sampleRate_{ reader.sampleRate() }
+{
+	if (reader.failed())
+		throw FileError{ reader.errorMessage() };
+	load(reader, storage);
+}
+
+namespace {
+	constexpr long long framesPerLoad = 4096;
+	constexpr float compactScale = 32768;
+	constexpr float compactScaleInverse = 1 / compactScale;
+
+	template<typename T>
+	void deinterleave(
+		const float *interleaved,
+		int channels,
+		std::vector<std::vector<T>> &buffers,
+		std::size_t offset,
+		std::size_t frames,
+		float scale = 1
+	) {
+		const auto stride = gsl::narrow<std::size_t>(channels);
+		for (std::size_t i = 0; i < stride; ++i) {
+			const auto source = interleaved + i;
+			const auto destination = buffers[i].data() + offset;
+			for (std::size_t j = 0; j < frames; ++j)
+				destination[j] = static_cast<T>(source[j * stride] * scale);
+		}
+	}
+
+	bool compactable(const std::vector<float> &x, std::size_t samples) {
+		return std::all_of(x.begin(), x.begin() + samples, [](float sample) {
+			const auto scaled = sample * compactScale;
+			return scaled >= -32768 && scaled <= 32767 &&
+				static_cast<float>(static_cast<std::int16_t>(scaled)) == scaled;
+		});
+	}
+}
+
+void DecodedAudio::load(AudioFileReader &reader, Storage storage) {
+	if (channels_ <= 0)
+		return;
+	const auto frames = gsl::narrow<size_type>(frames_);
+	if (storage == Storage::compact)
+		compactBuffers.assign(gsl::narrow<size_type>(channels_), compact_buffer_type(frames));
+	else
+		buffers.assign(gsl::narrow<size_type>(channels_), buffer_type(frames));
+	buffer_type interleaved(
+		gsl::narrow<size_type>(std::min(frames_, framesPerLoad) * channels_)
+	);
+	for (size_type loaded = 0; loaded < frames;) {
+		const auto n = std::min(frames - loaded, gsl::narrow<size_type>(framesPerLoad));
+		reader.readFrames(interleaved.data(), gsl::narrow<long long>(n));
+		if (!compactBuffers.empty() && !compactable(interleaved, n * gsl::narrow<size_type>(channels_)))
+			expand();
+		if (compactBuffers.empty())
+			deinterleave(interleaved.data(), channels_, buffers, loaded, n);
+		else
+			deinterleave(interleaved.data(), channels_, compactBuffers, loaded, n, compactScale);
+		loaded += n;
+	}
+}
+
+void DecodedAudio::expand() {
+	for (const auto &compact : compactBuffers) {
+		buffer_type buffer(compact.size());
+		std::transform(compact.begin(), compact.end(), buffer.begin(), [](std::int16_t sample) {
+			return sample * compactScaleInverse;
+		});
+		buffers.push_back(std::move(buffer));
+	}
+	compactBuffers.clear();
+}
+
+void DecodedAudio::copy(int channel, long long frame, gsl::span<float> x) const {
+	const auto destination = x.data();
+	const auto frames = gsl::narrow<size_type>(x.size());
+	const auto offset = gsl::narrow<size_type>(frame);
+	if (compactBuffers.empty()) {
+		const auto source = buffers[gsl::narrow<size_type>(channel)].data() + offset;
+		std::copy(source, source + frames, destination);
+	}
+	else {
+		const auto source = compactBuffers[gsl::narrow<size_type>(channel)].data() + offset;
+		for (size_type i{ 0 }; i < frames; ++i)
+			destination[i] = source[i] * compactScaleInverse;
+	}
+}
+
+long long DecodedAudio::frames() const noexcept {
+	return frames_;
+}
+
+int DecodedAudio::channels() const noexcept {
+	return channels_;
+}
+
+int DecodedAudio::sampleRate() const noexcept {
+	return sampleRate_;
+}
+
+std::size_t DecodedAudio::bytes() const noexcept {
+	std::size_t total{ 0 };
+	for (const auto &buffer : buffers)
+		total += buffer.size() * sizeof(buffer_type::value_type);
+	for (const auto &buffer : compactBuffers)
+		total += buffer.size() * sizeof(compact_buffer_type::value_type);
+	return total;
+}
+
+bool DecodedAudio::compact() const noexcept {
+	return !compactBuffers.empty();
+}
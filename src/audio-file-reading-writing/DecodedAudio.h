@@ -0,0 +1,53 @@
+#pragma once
+
+#include "AudioFile.h"
+#include "audio-file-reading-writing-exports.h"
+#include <common-includes/RuntimeError.h>
+#include <gsl/gsl>
+#include <cstdint>
+#include <vector>
+
+// A file's audio, decoded once and never changed afterward, so any number
+// of readers on any threads can share it without locking.
+// Audio is held one buffer per channel, split from the file's interleaved
+// frames once when loaded, so reading copies each channel in one piece.
+// Compact storage keeps 16-bit audio as 16-bit samples, a quarter of
+// the memory, and converts them as they are read. A file with any sample
+// 16 bits cannot hold exactly is kept at full precision instead.
+class DecodedAudio {
+	using buffer_type = std::vector<float>;
+	using compact_buffer_type = std::vector<std::int16_t>;
+	using size_type = buffer_type::size_type;
+	std::vector<buffer_type> buffers;
+	std::vector<compact_buffer_type> compactBuffers;
+	long long frames_;
+	int channels_;
+	int sampleRate_;
+public:
+	enum class Storage {
+		full,
+		compact
+	};
+	AUDIO_FILE_READING_WRITING_API explicit DecodedAudio(
+		AudioFileReader &,
+		Storage = Storage::full
+	);
+	RUNTIME_ERROR(FileError)
+
+	// Fills the span with the channel's frames from the given frame on.
+	// There must be enough of them.
+	AUDIO_FILE_READING_WRITING_API void copy(
+		int channel,
+		long long frame,
+		gsl::span<float>
+	) const;
+	AUDIO_FILE_READING_WRITING_API long long frames() const noexcept;
+	AUDIO_FILE_READING_WRITING_API int channels() const noexcept;
+	AUDIO_FILE_READING_WRITING_API int sampleRate() const noexcept;
+	AUDIO_FILE_READING_WRITING_API std::size_t bytes() const noexcept;
+	// Whether samples are held at 16 bits.
+	AUDIO_FILE_READING_WRITING_API bool compact() const noexcept;
+private:
+	void load(AudioFileReader &, Storage);
+	void expand();
+};
@@ -0,0 +1,179 @@
+#include "DecodedAudioCache.h"
+#include <gsl/gsl>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <thread>
+#include <vector>
+
+DecodedAudioCache::DecodedAudioCache(
+	AudioFileFactory *files,
+	AudioFrameReaderFactory *otherFiles,
+	std::size_t budgetBytes,
+	DecodedAudio::Storage storage,
+	int threads
+) :
+	files{ files },
+	otherFiles{ otherFiles },
+	budget{ budgetBytes },
+	storage{ storage },
+	threads{ threads > 0 
+		? threads 
+		: std::max(1, gsl::narrow<int>(std::thread::hardware_concurrency())) } {}
+
+std::shared_ptr<AudioFrameReader> DecodedAudioCache::make(std::string filePath) {
+	if (auto audio = find(filePath))
+		return std::make_shared<AudioFileInMemory>(std::move(audio));
+	auto reader = files->makeReader(filePath);
+	if (reader->failed())
+		throw CreateError{ reader->errorMessage() };
+	if (!fits(*reader))
+		return otherFiles->make(std::move(filePath));
+	auto audio = decode(*reader);
+	keep(filePath, audio, true);
+	return std::make_shared<AudioFileInMemory>(std::move(audio));
+}
+
+std::shared_ptr<const DecodedAudio> DecodedAudioCache::find(const std::string &filePath) {
+	std::lock_guard<std::mutex> lock{ mutex };
+	const auto found = entries.find(filePath);
+	if (found == entries.end())
+		return {};
+	uses.splice(uses.begin(), uses, found->second.use);
+	return found->second.audio;
+}
+
+namespace {
+	// Joins its threads however it is left, so a throw never destroys one
+	// still running.
+	class JoiningThreads {
+		std::vector<std::thread> threads{};
+	public:
+		JoiningThreads() = default;
+		JoiningThreads(const JoiningThreads &) = delete;
+		JoiningThreads &operator=(const JoiningThreads &) = delete;
+		JoiningThreads(JoiningThreads &&) = delete;
+		JoiningThreads &operator=(JoiningThreads &&) = delete;
+
+		~JoiningThreads() noexcept {
+			for (auto &thread : threads)
+				if (thread.joinable())
+					thread.join();
+		}
+
+		template<typename F>
+		void add(F f) {
+			threads.emplace_back(std::move(f));
+		}
+	};
+
+	// Compact storage is the least a file can take.
+	std::size_t leastBytes(AudioFileReader &reader) {
+		const auto samples = reader.frames() * reader.channels();
+		return samples < 0
+			? std::numeric_limits<std::size_t>::max()
+			: gsl::narrow<std::size_t>(samples) * sizeof(std::int16_t);
+	}
+}
+
+bool DecodedAudioCache::fits(AudioFileReader &reader) {
+	return leastBytes(reader) <= budget;
+}
+
+bool DecodedAudioCache::fitsInRoomLeft(AudioFileReader &reader) {
+	const auto least = leastBytes(reader);
+	std::lock_guard<std::mutex> lock{ mutex };
+	return least <= budget - bytes_;
+}
+
+std::shared_ptr<const DecodedAudio> DecodedAudioCache::decode(AudioFileReader &reader) {
+	try {
+		return std::make_shared<const DecodedAudio>(reader, storage);
+	}
+	catch (const DecodedAudio::FileError &e) {
+		throw CreateError{ e.what() };
+	}
+}
+
+void DecodedAudioCache::keep(
+	const std::string &filePath,
+	std::shared_ptr<const DecodedAudio> audio,
+	bool evicting
+) {
+	std::lock_guard<std::mutex> lock{ mutex };
+	if (entries.count(filePath) || audio->bytes() > budget)
+		return;
+	while (evicting && bytes_ + audio->bytes() > budget) {
+		const auto evicted = entries.find(uses.back());
+		bytes_ -= evicted->second.audio->bytes();
+		entries.erase(evicted);
+		uses.pop_back();
+	}
+	if (bytes_ + audio->bytes() > budget)
+		return;
+	bytes_ += audio->bytes();
+	uses.push_front(filePath);
+	entries[filePath] = { std::move(audio), uses.begin() };
+}
+
+// Preloading never lets go of a file to make room, since files earlier in 
+// the list are needed sooner, so a file is only decoded when there is room
+// left for it.
+void DecodedAudioCache::preload(
+	std::vector<std::string> filePaths,
+	std::function<void(int, int)> progress
+) {
+	const auto total = gsl::narrow<int>(filePaths.size());
+	std::atomic<int> next{ 0 };
+	int finished{ 0 };
+	std::mutex finishing;
+	std::condition_variable finishedOne;
+	auto work = [&]() {
+		for (auto i = next++; i < total; i = next++) {
+			const auto &filePath = filePaths[gsl::narrow<std::size_t>(i)];
+			try {
+				if (!find(filePath)) {
+					auto reader = files->makeReader(filePath);
+					if (!reader->failed() && fitsInRoomLeft(*reader))
+						keep(filePath, decode(*reader), false);
+				}
+			}
+			catch (const std::exception &) {
+			}
+			std::lock_guard<std::mutex> lock{ finishing };
+			++finished;
+			finishedOne.notify_one();
+		}
+	};
+	// Should starting a worker or reporting progress throw, the files not 
+	// yet claimed are given up so the workers can be joined promptly.
+	JoiningThreads workers;
+	try {
+		for (int i = 0; i < std::min(threads, total); ++i)
+			workers.add(work);
+		std::unique_lock<std::mutex> lock{ finishing };
+		for (int reported = 0; reported < total;) {
+			finishedOne.wait(lock, [&]() { return finished > reported; });
+			reported = finished;
+			lock.unlock();
+			if (progress)
+				progress(reported, total);
+			lock.lock();
+		}
+	}
+	catch (...) {
+		next = total;
+		throw;
+	}
+}
+
+std::size_t DecodedAudioCache::bytes() {
+	std::lock_guard<std::mutex> lock{ mutex };
+	return bytes_;
+}
+
+bool DecodedAudioCache::contains(const std::string &filePath) {
+	std::lock_guard<std::mutex> lock{ mutex };
+	return entries.count(filePath) != 0;
+}
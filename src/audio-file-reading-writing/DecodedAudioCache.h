@@ -0,0 +1,52 @@
+#pragma once
+
+#include "AudioFileInMemory.h"
+#include "audio-file-reading-writing-exports.h"
+#include <spatialized-hearing-aid-simulation/StimulusCache.h>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+// Keeps decoded files in memory, up to a budget, so each is decoded once
+// however often it is read. Making a reader for a file not yet kept 
+// decodes and keeps it, letting go of those read least recently when over
+// budget; readers already made keep what they read. A file that could 
+// not fit even alone is left to the other factory.
+class DecodedAudioCache : public AudioFrameReaderFactory, public StimulusCache {
+	struct Entry {
+		std::shared_ptr<const DecodedAudio> audio;
+		std::list<std::string>::iterator use;
+	};
+	std::unordered_map<std::string, Entry> entries{};
+	std::list<std::string> uses{};
+	std::mutex mutex{};
+	AudioFileFactory *files;
+	AudioFrameReaderFactory *otherFiles;
+	std::size_t budget;
+	std::size_t bytes_{};
+	DecodedAudio::Storage storage;
+	int threads;
+public:
+	// Preloading uses as many threads as the hardware runs when none are given.
+	AUDIO_FILE_READING_WRITING_API DecodedAudioCache(
+		AudioFileFactory *,
+		AudioFrameReaderFactory *otherFiles,
+		std::size_t budgetBytes,
+		DecodedAudio::Storage = DecodedAudio::Storage::compact,
+		int threads = 0
+	);
+	AUDIO_FILE_READING_WRITING_API 
+		std::shared_ptr<AudioFrameReader> make(std::string filePath) override;
+	AUDIO_FILE_READING_WRITING_API void preload(
+		std::vector<std::string> filePaths,
+		std::function<void(int loaded, int total)> progress
+	) override;
+	AUDIO_FILE_READING_WRITING_API std::size_t bytes();
+	AUDIO_FILE_READING_WRITING_API bool contains(const std::string &filePath);
+private:
+	std::shared_ptr<const DecodedAudio> find(const std::string &filePath);
+	std::shared_ptr<const DecodedAudio> decode(AudioFileReader &);
+	bool fits(AudioFileReader &);
+	bool fitsInRoomLeft(AudioFileReader &);
+	void keep(const std::string &filePath, std::shared_ptr<const DecodedAudio>, bool evicting);
+};
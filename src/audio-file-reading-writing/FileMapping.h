@@ -0,0 +1,25 @@
+#pragma once
+
+#include <common-includes/Interface.h>
+#include <common-includes/RuntimeError.h>
+#include <gsl/gsl>
+#include <memory>
+#include <string>
+
+// A file's contents mapped read-only into memory. Pages come from the
+// operating system's cache, so every mapping of a file shares them.
+class FileMapping {
+public:
+    INTERFACE_OPERATIONS(FileMapping)
+	virtual gsl::span<const unsigned char> bytes() = 0;
+	// Brings the pages holding the bytes in range into memory, so reading
+	// them later does not wait on the disk unless memory runs short.
+	virtual void prefault(long long offset, long long size) = 0;
+};
+
+class FileMapper {
+public:
+    INTERFACE_OPERATIONS(FileMapper)
+	virtual std::shared_ptr<FileMapping> map(std::string filePath) = 0;
+    RUNTIME_ERROR(MapFailure)
+};
@@ -0,0 +1,200 @@
+#include "MappedWavFile.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Samples are loaded with memcpy, which assumes a little-endian host like
+// every platform this builds for, and lets the conversions vectorize.
+namespace {
+	using bytes_type = gsl::span<const unsigned char>;
+
+	std::uint32_t littleEndian32(const unsigned char *p) noexcept {
+		return 
+			std::uint32_t{ p[0] } | 
+			std::uint32_t{ p[1] } << 8 | 
+			std::uint32_t{ p[2] } << 16 | 
+			std::uint32_t{ p[3] } << 24;
+	}
+
+	std::uint16_t littleEndian16(const unsigned char *p) noexcept {
+		return gsl::narrow_cast<std::uint16_t>(p[0] | p[1] << 8);
+	}
+
+	bool hasId(bytes_type bytes, long long offset, const char *id) {
+		return offset + 4 <= bytes.size() && 
+			std::memcmp(bytes.data() + offset, id, 4) == 0;
+	}
+
+	constexpr float fullScale16 = 1.0f / 32768;
+	constexpr float fullScale32 = 1.0f / 2147483648.0f;
+
+	float pcm16(const unsigned char *p) noexcept {
+		std::int16_t x;
+		std::memcpy(&x, p, sizeof x);
+		return x * fullScale16;
+	}
+
+	// Shifts the sample into the top three bytes so its sign comes along.
+	float pcm24(const unsigned char *p) noexcept {
+		const auto x = static_cast<std::int32_t>(
+			std::uint32_t{ p[0] } << 8 | 
+			std::uint32_t{ p[1] } << 16 | 
+			std::uint32_t{ p[2] } << 24
+		);
+		return x * fullScale32;
+	}
+
+	float pcm32(const unsigned char *p) noexcept {
+		std::int32_t x;
+		std::memcpy(&x, p, sizeof x);
+		return x * fullScale32;
+	}
+
+	float float32(const unsigned char *p) noexcept {
+		float x;
+		std::memcpy(&x, p, sizeof x);
+		return x;
+	}
+}
+
+MappedWavFile::MappedWavFile(std::shared_ptr<FileMapping> mapping_) :
+	mapping{ std::move(mapping_) }
+{
+	parse(mapping->bytes());
+}
+
+void MappedWavFile::parse(bytes_type bytes) {
+	if (!hasId(bytes, 0, "RIFF") || !hasId(bytes, 8, "WAVE"))
+		throw FormatError{ "Not a WAV file." };
+	bool formatRead{};
+	long long offset{ 12 };
+	while (offset + 8 <= bytes.size()) {
+		const auto size = littleEndian32(bytes.data() + offset + 4);
+		const auto body = offset + 8;
+		const auto available = std::min<long long>(size, bytes.size() - body);
+		if (hasId(bytes, offset, "fmt ")) {
+			readFormat(bytes.subspan(body, available));
+			formatRead = true;
+		}
+		else if (hasId(bytes, offset, "data")) {
+			if (!formatRead)
+				throw FormatError{ "WAV data comes before its format." };
+			data = bytes.data() + body;
+			frames_ = available / bytesPerFrame;
+			return;
+		}
+		offset = body + size + (size & 1);
+	}
+	throw FormatError{ "WAV file has no data." };
+}
+
+void MappedWavFile::readFormat(bytes_type chunk) {
+	if (chunk.size() < 16)
+		throw FormatError{ "WAV format is incomplete." };
+	auto tag = littleEndian16(chunk.data());
+	channels_ = littleEndian16(chunk.data() + 2);
+	sampleRate_ = gsl::narrow_cast<int>(littleEndian32(chunk.data() + 4));
+	bytesPerFrame = littleEndian16(chunk.data() + 12);
+	const auto bits = littleEndian16(chunk.data() + 14);
+	constexpr std::uint16_t extensible = 0xFFFE;
+	if (tag == extensible && chunk.size() >= 26)
+		tag = littleEndian16(chunk.data() + 24);
+
+	constexpr std::uint16_t pcm = 1;
+	constexpr std::uint16_t ieeeFloat = 3;
+	if (tag == pcm && bits == 16)
+		encoding = Encoding::pcm16;
+	else if (tag == pcm && bits == 24)
+		encoding = Encoding::pcm24;
+	else if (tag == pcm && bits == 32)
+		encoding = Encoding::pcm32;
+	else if (tag == ieeeFloat && bits == 32)
+		encoding = Encoding::float32;
+	else
+		throw FormatError{ "WAV encoding is not supported." };
+	if (channels_ == 0 || bytesPerFrame != channels_ * bits / 8)
+		throw FormatError{ "WAV format is inconsistent." };
+}
+
+void MappedWavFile::read(gsl::span<channel_type> audio) {
+	if (audio.size() != channels_)
+		return;
+	const auto count = std::min<long long>(audio.begin()->size(), remainingFrames());
+	switch (encoding) {
+	case Encoding::pcm16:
+		return convert(audio, count, pcm16);
+	case Encoding::pcm24:
+		return convert(audio, count, pcm24);
+	case Encoding::pcm32:
+		return convert(audio, count, pcm32);
+	case Encoding::float32:
+		return convert(audio, count, float32);
+	}
+}
+
+template<typename Convert>
+void MappedWavFile::convert(
+	gsl::span<channel_type> audio, 
+	long long count, 
+	Convert convert_
+) {
+	const auto bytesPerSample = bytesPerFrame / channels_;
+	for (int channel = 0; channel < channels_; ++channel) {
+		const auto source = data + head * bytesPerFrame + channel * bytesPerSample;
+		const auto destination = audio[channel].data();
+		for (long long i = 0; i < count; ++i)
+			destination[i] = convert_(source + i * bytesPerFrame);
+	}
+	head += count;
+}
+
+bool MappedWavFile::complete() {
+	return head == frames_;
+}
+
+int MappedWavFile::sampleRate() {
+	return sampleRate_;
+}
+
+int MappedWavFile::channels() {
+	return channels_;
+}
+
+long long MappedWavFile::frames() {
+	return frames_;
+}
+
+void MappedWavFile::reset() {
+	head = 0;
+}
+
+long long MappedWavFile::remainingFrames() {
+	return frames_ - head;
+}
+
+// Faulting pages in from the device's callback could wait on the disk, so
+// what is left to play is brought into memory now.
+void MappedWavFile::prepareForPlayback() {
+	mapping->prefault(
+		data - mapping->bytes().data() + head * bytesPerFrame,
+		remainingFrames() * bytesPerFrame
+	);
+}
+
+MappedWavFileFactory::MappedWavFileFactory(
+	FileMapper *mapper,
+	AudioFrameReaderFactory *otherFiles
+) noexcept :
+	mapper{ mapper },
+	otherFiles{ otherFiles } {}
+
+std::shared_ptr<AudioFrameReader> MappedWavFileFactory::make(std::string filePath) {
+	try {
+		return std::make_shared<MappedWavFile>(mapper->map(filePath));
+	}
+	catch (const FileMapper::MapFailure &) {
+	}
+	catch (const MappedWavFile::FormatError &) {
+	}
+	return otherFiles->make(std::move(filePath));
+}
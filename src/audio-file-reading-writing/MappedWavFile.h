@@ -0,0 +1,66 @@
+#pragma once
+
+#include "FileMapping.h"
+#include "audio-file-reading-writing-exports.h"
+#include <spatialized-hearing-aid-simulation/AudioFrameReader.h>
+#include <common-includes/RuntimeError.h>
+#include <memory>
+
+// Reads frames straight out of a mapped WAV file's data chunk, converting
+// each to float as it is read. Opening costs the same for any length of
+// file, and nothing is copied until frames are read. Supports 16, 24 and
+// 32 bit PCM and 32 bit float, in plain or extensible format chunks.
+//
+// The file must not be truncated while mapped: reading past its new end
+// raises SIGBUS on macOS, and Windows refuses the truncation instead.
+// Stimuli are replaced with new files, as the stimulus bank builder does,
+// rather than rewritten in place during a test.
+class MappedWavFile : public AudioFrameReader {
+public:
+	enum class Encoding {
+		pcm16,
+		pcm24,
+		pcm32,
+		float32
+	};
+private:
+	std::shared_ptr<FileMapping> mapping;
+	const unsigned char *data{};
+	long long frames_{};
+	long long head{};
+	int channels_{};
+	int sampleRate_{};
+	int bytesPerFrame{};
+	Encoding encoding{};
+public:
+	// Throws FormatError unless the mapping holds a supported WAV file.
+	AUDIO_FILE_READING_WRITING_API explicit MappedWavFile(std::shared_ptr<FileMapping>);
+	RUNTIME_ERROR(FormatError)
+	AUDIO_FILE_READING_WRITING_API void read(gsl::span<channel_type> audio) override;
+	AUDIO_FILE_READING_WRITING_API bool complete() override;
+	AUDIO_FILE_READING_WRITING_API int sampleRate() override;
+	AUDIO_FILE_READING_WRITING_API int channels() override;
+	AUDIO_FILE_READING_WRITING_API long long frames() override;
+	AUDIO_FILE_READING_WRITING_API void reset() override;
+	AUDIO_FILE_READING_WRITING_API long long remainingFrames() override;
+	AUDIO_FILE_READING_WRITING_API void prepareForPlayback() override;
+private:
+	void parse(gsl::span<const unsigned char>);
+	void readFormat(gsl::span<const unsigned char> chunk);
+	template<typename Convert>
+		void convert(gsl::span<channel_type> audio, long long count, Convert);
+};
+
+// Maps WAV files it can read directly and hands anything else, or any file
+// that cannot be mapped, to the other factory.
+class MappedWavFileFactory : public AudioFrameReaderFactory {
+	FileMapper *mapper;
+	AudioFrameReaderFactory *otherFiles;
+public:
+	AUDIO_FILE_READING_WRITING_API MappedWavFileFactory(
+		FileMapper *,
+		AudioFrameReaderFactory *otherFiles
+	) noexcept;
+	AUDIO_FILE_READING_WRITING_API 
+		std::shared_ptr<AudioFrameReader> make(std::string filePath) override;
+};
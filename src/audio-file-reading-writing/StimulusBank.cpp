@@ -0,0 +1,284 @@
+#include "StimulusBank.h"
+#include <algorithm>
+#include <cstring>
+
+// Like MappedWavFile, samples are loaded with memcpy, which assumes a
+// little-endian host.
+namespace {
+	constexpr float fullScale16 = 1.0f / 32768;
+	constexpr long long headerBytes = 16;
+	constexpr long long entryBytes = 32;
+
+	std::uint32_t littleEndian32(const unsigned char *p) noexcept {
+		return
+			std::uint32_t{ p[0] } |
+			std::uint32_t{ p[1] } << 8 |
+			std::uint32_t{ p[2] } << 16 |
+			std::uint32_t{ p[3] } << 24;
+	}
+
+	std::uint64_t littleEndian64(const unsigned char *p) noexcept {
+		return std::uint64_t{ littleEndian32(p) } | std::uint64_t{ littleEndian32(p + 4) } << 32;
+	}
+
+	long long bytesPerSample(StimulusBank::Encoding encoding) noexcept {
+		return encoding == StimulusBank::Encoding::pcm16 ? 2 : 4;
+	}
+}
+
+const std::string StimulusBank::fileName = "stimuli.bank";
+
+StimulusBank::StimulusBank(std::shared_ptr<FileMapping> mapping_) :
+	mapping{ std::move(mapping_) },
+	bytes{ mapping->bytes() }
+{
+	parse();
+}
+
+void StimulusBank::parse() {
+	if (bytes.size() < headerBytes || std::memcmp(bytes.data(), "STIMBANK", 8) != 0)
+		throw FormatError{ "Not a stimulus bank." };
+	if (littleEndian32(bytes.data() + 8) != version)
+		throw FormatError{ "Stimulus bank version is not supported." };
+	const auto count = littleEndian32(bytes.data() + 12);
+	long long offset{ headerBytes };
+	for (std::uint32_t i = 0; i < count; ++i) {
+		if (offset + entryBytes > bytes.size())
+			throw FormatError{ "Stimulus bank index is incomplete." };
+		const auto p = bytes.data() + offset;
+		const auto nameLength = littleEndian32(p);
+		Entry entry{};
+		entry.channels = gsl::narrow_cast<int>(littleEndian32(p + 4));
+		entry.sampleRate = gsl::narrow_cast<int>(littleEndian32(p + 8));
+		const auto encoding = littleEndian32(p + 12);
+		const auto frames = littleEndian64(p + 16);
+		const auto data = littleEndian64(p + 24);
+		if (encoding > 1 || entry.channels <= 0)
+			throw FormatError{ "Stimulus bank index is inconsistent." };
+		entry.encoding = encoding == 1 ? Encoding::pcm16 : Encoding::float32;
+		offset += entryBytes;
+		const auto rmsBytes = entry.channels * 4LL;
+		if (offset + rmsBytes + nameLength > bytes.size())
+			throw FormatError{ "Stimulus bank index is incomplete." };
+		entry.rms.resize(gsl::narrow<std::size_t>(entry.channels));
+		std::memcpy(entry.rms.data(), bytes.data() + offset, gsl::narrow<std::size_t>(rmsBytes));
+		offset += rmsBytes;
+		entry.name.assign(reinterpret_cast<const char *>(bytes.data() + offset), nameLength);
+		offset += nameLength;
+
+		// Compared through division so huge values cannot overflow.
+		const auto size = gsl::narrow_cast<std::uint64_t>(bytes.size());
+		const auto frameBytes = gsl::narrow_cast<std::uint64_t>(
+			entry.channels * bytesPerSample(entry.encoding)
+		);
+		if (data > size || frames > (size - data) / frameBytes)
+			throw FormatError{ "Stimulus '" + entry.name + "' lies outside its bank." };
+		entry.frames = gsl::narrow_cast<long long>(frames);
+		entry.offset = gsl::narrow_cast<long long>(data);
+		byName.emplace(entry.name, entries.size());
+		entries.push_back(std::move(entry));
+	}
+}
+
+auto StimulusBank::find(const std::string &name) const -> const Entry * {
+	const auto found = byName.find(name);
+	return found == byName.end() ? nullptr : &entries[found->second];
+}
+
+std::vector<std::string> StimulusBank::names() const {
+	std::vector<std::string> names_;
+	for (const auto &entry : entries)
+		names_.push_back(entry.name);
+	return names_;
+}
+
+void StimulusBank::copy(
+	const Entry &entry,
+	int channel,
+	long long frame,
+	gsl::span<float> x
+) const {
+	const auto sampleBytes = bytesPerSample(entry.encoding);
+	const auto source =
+		bytes.data() + entry.offset + (channel * entry.frames + frame) * sampleBytes;
+	const auto destination = x.data();
+	const auto frames = x.size();
+	if (entry.encoding == Encoding::float32) {
+		std::memcpy(destination, source, gsl::narrow<std::size_t>(frames * sampleBytes));
+		return;
+	}
+	for (long long i = 0; i < frames; ++i) {
+		std::int16_t sample;
+		std::memcpy(&sample, source + i * sampleBytes, sizeof sample);
+		destination[i] = sample * fullScale16;
+	}
+}
+
+void StimulusBank::prefault(const Entry &entry, long long frame) const {
+	const auto sampleBytes = bytesPerSample(entry.encoding);
+	for (int channel = 0; channel < entry.channels; ++channel)
+		mapping->prefault(
+			entry.offset + (channel * entry.frames + frame) * sampleBytes,
+			(entry.frames - frame) * sampleBytes
+		);
+}
+
+StimulusBankReader::StimulusBankReader(
+	std::shared_ptr<const StimulusBank> bank,
+	const StimulusBank::Entry *entry
+) noexcept :
+	bank{ std::move(bank) },
+	entry{ entry } {}
+
+void StimulusBankReader::read(gsl::span<channel_type> audio) {
+	if (audio.size() != entry->channels)
+		return;
+	long long count{ 0 };
+	for (int i = 0; i < entry->channels; ++i) {
+		auto channel = audio[i];
+		count = std::min<long long>(channel.size(), remainingFrames());
+		bank->copy(*entry, i, head, channel.first(gsl::narrow<channel_type::index_type>(count)));
+	}
+	head += count;
+}
+
+bool StimulusBankReader::complete() {
+	return remainingFrames() == 0;
+}
+
+int StimulusBankReader::sampleRate() {
+	return entry->sampleRate;
+}
+
+int StimulusBankReader::channels() {
+	return entry->channels;
+}
+
+long long StimulusBankReader::frames() {
+	return entry->frames;
+}
+
+void StimulusBankReader::reset() {
+	head = 0;
+}
+
+long long StimulusBankReader::remainingFrames() {
+	return entry->frames - head;
+}
+
+// Faulting pages in from the device's callback could wait on the disk, so
+// what is left to play is brought into memory now.
+void StimulusBankReader::prepareForPlayback() {
+	bank->prefault(*entry, head);
+}
+
+StimulusBankFactory::StimulusBankFactory(
+	FileMapper *mapper,
+	AudioFrameReaderFactory *otherFiles,
+	StimulusCache *otherStimuli
+) noexcept :
+	mapper{ mapper },
+	otherFiles{ otherFiles },
+	otherStimuli{ otherStimuli } {}
+
+std::shared_ptr<AudioFrameReader> StimulusBankFactory::make(std::string filePath) {
+	std::shared_ptr<const StimulusBank> bank_;
+	if (const auto entry = find(filePath, bank_))
+		return std::make_shared<StimulusBankReader>(std::move(bank_), entry);
+	return otherFiles->make(std::move(filePath));
+}
+
+void StimulusBankFactory::preload(
+	std::vector<std::string> filePaths,
+	std::function<void(int, int)> progress
+) {
+	const auto total = gsl::narrow<int>(filePaths.size());
+	std::vector<std::string> others;
+	for (auto &filePath : filePaths) {
+		std::shared_ptr<const StimulusBank> bank_;
+		if (!find(filePath, bank_))
+			others.push_back(std::move(filePath));
+	}
+	const auto banked = total - gsl::narrow<int>(others.size());
+	if (banked > 0 && progress)
+		progress(banked, total);
+	if (others.empty())
+		return;
+	otherStimuli->preload(std::move(others), [&](int loaded, int) {
+		if (progress)
+			progress(banked + loaded, total);
+	});
+}
+
+std::shared_ptr<const StimulusBank> StimulusBankFactory::map(const std::string &directory) {
+	std::shared_ptr<const StimulusBank> mapped{};
+	try {
+		mapped = std::make_shared<const StimulusBank>(
+			mapper->map(directory + "/" + StimulusBank::fileName)
+		);
+	}
+	catch (const FileMapper::MapFailure &) {
+	}
+	catch (const StimulusBank::FormatError &) {
+	}
+	std::lock_guard<std::mutex> lock{ mutex };
+	return banks[directory] = std::move(mapped);
+}
+
+std::shared_ptr<const StimulusBank> StimulusBankFactory::bank(const std::string &directory) {
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		const auto found = banks.find(directory);
+		if (found != banks.end())
+			return found->second;
+	}
+	return map(directory);
+}
+
+// Stimulus lists join directories and file names with a slash.
+auto StimulusBankFactory::find(
+	const std::string &filePath,
+	std::shared_ptr<const StimulusBank> &bank_
+) -> const StimulusBank::Entry * {
+	const auto separator = filePath.find_last_of('/');
+	if (separator == std::string::npos)
+		return nullptr;
+	bank_ = bank(filePath.substr(0, separator));
+	return bank_ ? bank_->find(filePath.substr(separator + 1)) : nullptr;
+}
+
+namespace {
+	class StimulusBankDirectory : public DirectoryReader {
+		std::vector<std::string> names;
+	public:
+		explicit StimulusBankDirectory(std::vector<std::string> names) :
+			names{ std::move(names) } {}
+
+		bool failed() override {
+			return false;
+		}
+
+		std::string errorMessage() override {
+			return {};
+		}
+
+		std::vector<std::string> files() override {
+			return names;
+		}
+	};
+}
+
+StimulusBankDirectoryReaderFactory::StimulusBankDirectoryReaderFactory(
+	StimulusBankFactory *banks,
+	DirectoryReaderFactory *otherDirectories
+) noexcept :
+	banks{ banks },
+	otherDirectories{ otherDirectories } {}
+
+std::shared_ptr<DirectoryReader> StimulusBankDirectoryReaderFactory::make(
+	std::string directory
+) {
+	if (const auto bank = banks->map(directory))
+		return std::make_shared<StimulusBankDirectory>(bank->names());
+	return otherDirectories->make(std::move(directory));
+}
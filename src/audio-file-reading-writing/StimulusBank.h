@@ -0,0 +1,139 @@
+#pragma once
+
+#include "FileMapping.h"
+#include "audio-file-reading-writing-exports.h"
+#include <spatialized-hearing-aid-simulation/AudioFrameReader.h>
+#include <spatialized-hearing-aid-simulation/StimulusCache.h>
+#include <stimulus-list/DirectoryReader.h>
+#include <common-includes/RuntimeError.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Many stimuli packed into one file, so a test maps a single file instead
+// of opening and decoding each stimulus. All values are little-endian:
+//
+//   "STIMBANK", u32 version, u32 stimulus count
+//   for each stimulus:
+//     u32 name length, u32 channels, u32 sample rate, u32 encoding,
+//     u64 frames, u64 offset of its samples from the start of the file,
+//     f32 RMS of each channel, then the name
+//   samples, each stimulus's one channel after another, starting on a
+//   64-byte boundary
+//
+// Samples are 32 bit float or, when 16 bits hold them exactly, 16 bit PCM.
+class StimulusBank {
+public:
+	enum class Encoding {
+		float32,
+		pcm16
+	};
+	struct Entry {
+		std::string name;
+		std::vector<float> rms;
+		long long frames;
+		long long offset;
+		int channels;
+		int sampleRate;
+		Encoding encoding;
+	};
+	static constexpr std::uint32_t version = 1;
+	static constexpr int alignment = 64;
+	AUDIO_FILE_READING_WRITING_API static const std::string fileName;
+
+	// Throws FormatError unless the mapping holds a bank whose samples all
+	// lie within it.
+	AUDIO_FILE_READING_WRITING_API explicit StimulusBank(std::shared_ptr<FileMapping>);
+	RUNTIME_ERROR(FormatError)
+	AUDIO_FILE_READING_WRITING_API const Entry *find(const std::string &name) const;
+	AUDIO_FILE_READING_WRITING_API std::vector<std::string> names() const;
+
+	// Fills the span with the channel's frames from the given frame on.
+	// There must be enough of them.
+	AUDIO_FILE_READING_WRITING_API void copy(
+		const Entry &,
+		int channel,
+		long long frame,
+		gsl::span<float>
+	) const;
+
+	// Brings every channel's frames from the given frame on into memory.
+	AUDIO_FILE_READING_WRITING_API void prefault(const Entry &, long long frame) const;
+private:
+	std::shared_ptr<FileMapping> mapping;
+	gsl::span<const unsigned char> bytes;
+	std::vector<Entry> entries;
+	std::unordered_map<std::string, std::size_t> byName;
+	void parse();
+};
+
+// Reads one stimulus straight out of a bank's mapping.
+class StimulusBankReader : public AudioFrameReader {
+	std::shared_ptr<const StimulusBank> bank;
+	const StimulusBank::Entry *entry;
+	long long head{};
+public:
+	AUDIO_FILE_READING_WRITING_API StimulusBankReader(
+		std::shared_ptr<const StimulusBank>,
+		const StimulusBank::Entry *
+	) noexcept;
+	AUDIO_FILE_READING_WRITING_API void read(gsl::span<channel_type> audio) override;
+	AUDIO_FILE_READING_WRITING_API bool complete() override;
+	AUDIO_FILE_READING_WRITING_API int sampleRate() override;
+	AUDIO_FILE_READING_WRITING_API int channels() override;
+	AUDIO_FILE_READING_WRITING_API long long frames() override;
+	AUDIO_FILE_READING_WRITING_API void reset() override;
+	AUDIO_FILE_READING_WRITING_API long long remainingFrames() override;
+	AUDIO_FILE_READING_WRITING_API void prepareForPlayback() override;
+};
+
+// Serves stimuli from the bank in their directory, when it has one, and
+// leaves everything else to the others. Preloading skips banked stimuli 
+// since they are read straight from the mapping.
+class StimulusBankFactory : public AudioFrameReaderFactory, public StimulusCache {
+	std::map<std::string, std::shared_ptr<const StimulusBank>> banks{};
+	std::mutex mutex{};
+	FileMapper *mapper;
+	AudioFrameReaderFactory *otherFiles;
+	StimulusCache *otherStimuli;
+public:
+	AUDIO_FILE_READING_WRITING_API StimulusBankFactory(
+		FileMapper *,
+		AudioFrameReaderFactory *otherFiles,
+		StimulusCache *otherStimuli
+	) noexcept;
+	AUDIO_FILE_READING_WRITING_API
+		std::shared_ptr<AudioFrameReader> make(std::string filePath) override;
+	AUDIO_FILE_READING_WRITING_API void preload(
+		std::vector<std::string> filePaths,
+		std::function<void(int loaded, int total)> progress
+	) override;
+
+	// Maps the directory's bank again, so one rebuilt since it was last
+	// mapped is used from then on. Returns null when there is none.
+	AUDIO_FILE_READING_WRITING_API
+		std::shared_ptr<const StimulusBank> map(const std::string &directory);
+private:
+	std::shared_ptr<const StimulusBank> bank(const std::string &directory);
+	const StimulusBank::Entry *find(
+		const std::string &filePath, 
+		std::shared_ptr<const StimulusBank> &
+	);
+};
+
+// Lists a directory's banked stimuli in place of its files when it has a
+// bank. Listing happens once per test, so that is when banks are mapped
+// again.
+class StimulusBankDirectoryReaderFactory : public DirectoryReaderFactory {
+	StimulusBankFactory *banks;
+	DirectoryReaderFactory *otherDirectories;
+public:
+	AUDIO_FILE_READING_WRITING_API StimulusBankDirectoryReaderFactory(
+		StimulusBankFactory *,
+		DirectoryReaderFactory *otherDirectories
+	) noexcept;
+	AUDIO_FILE_READING_WRITING_API
+		std::shared_ptr<DirectoryReader> make(std::string directory) override;
+};
@@ -0,0 +1,129 @@
+#include "StimulusBankBuilder.h"
+#include "DecodedAudio.h"
+#include "StimulusBank.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+	void putLittleEndian(std::string &out, std::uint64_t x, int bytes) {
+		for (int i = 0; i < bytes; ++i)
+			out.push_back(static_cast<char>(x >> 8 * i & 0xFF));
+	}
+
+	void put32(std::string &out, std::uint32_t x) {
+		putLittleEndian(out, x, 4);
+	}
+
+	void put64(std::string &out, std::uint64_t x) {
+		putLittleEndian(out, x, 8);
+	}
+
+	void putFloat(std::string &out, float x) {
+		std::uint32_t bits;
+		std::memcpy(&bits, &x, sizeof bits);
+		put32(out, bits);
+	}
+
+	std::string index(const std::vector<StimulusBank::Entry> &entries) {
+		std::string out{ "STIMBANK" };
+		put32(out, StimulusBank::version);
+		put32(out, gsl::narrow<std::uint32_t>(entries.size()));
+		for (const auto &entry : entries) {
+			put32(out, gsl::narrow<std::uint32_t>(entry.name.size()));
+			put32(out, gsl::narrow<std::uint32_t>(entry.channels));
+			put32(out, gsl::narrow<std::uint32_t>(entry.sampleRate));
+			put32(out, entry.encoding == StimulusBank::Encoding::pcm16 ? 1 : 0);
+			put64(out, gsl::narrow<std::uint64_t>(entry.frames));
+			put64(out, gsl::narrow<std::uint64_t>(entry.offset));
+			for (auto rms : entry.rms)
+				putFloat(out, rms);
+			out += entry.name;
+		}
+		return out;
+	}
+
+	float rms(const std::vector<float> &x) {
+		if (x.empty())
+			return 0;
+		double sumOfSquares{ 0 };
+		for (auto sample : x)
+			sumOfSquares += double{ sample } * sample;
+		return gsl::narrow_cast<float>(std::sqrt(sumOfSquares / x.size()));
+	}
+}
+
+StimulusBankBuilder::StimulusBankBuilder(AudioFileFactory *files) noexcept :
+	files{ files } {}
+
+void StimulusBankBuilder::add(std::string name, std::string filePath) {
+	stimuli.push_back({ std::move(name), std::move(filePath) });
+}
+
+void StimulusBankBuilder::write(std::ostream &bank) {
+	// Entries are first filled with what the index's size depends on, so
+	// room can be left for it ahead of the samples.
+	std::vector<StimulusBank::Entry> entries;
+	for (const auto &stimulus : stimuli) {
+		auto reader = files->makeReader(stimulus.filePath);
+		if (reader->failed())
+			throw FileError{ reader->errorMessage() };
+		StimulusBank::Entry entry{};
+		entry.name = stimulus.name;
+		entry.channels = reader->channels();
+		entry.rms.resize(gsl::narrow<std::size_t>(entry.channels));
+		entries.push_back(std::move(entry));
+	}
+	const auto indexBytes = index(entries).size();
+	bank << std::string(indexBytes, '\0');
+
+	std::vector<float> channel;
+	std::vector<std::int16_t> compact;
+	for (std::size_t i = 0; i < stimuli.size(); ++i) {
+		auto reader = files->makeReader(stimuli[i].filePath);
+		if (reader->failed())
+			throw FileError{ reader->errorMessage() };
+		const DecodedAudio audio{ *reader, DecodedAudio::Storage::compact };
+		auto &entry = entries[i];
+		entry.channels = audio.channels();
+		entry.sampleRate = audio.sampleRate();
+		entry.frames = audio.frames();
+		entry.encoding = audio.compact()
+			? StimulusBank::Encoding::pcm16
+			: StimulusBank::Encoding::float32;
+		entry.rms.resize(gsl::narrow<std::size_t>(entry.channels));
+		const auto position = static_cast<long long>(bank.tellp());
+		const auto padding = (StimulusBank::alignment - position % StimulusBank::alignment) 
+			% StimulusBank::alignment;
+		bank << std::string(gsl::narrow<std::size_t>(padding), '\0');
+		entry.offset = position + padding;
+		channel.resize(gsl::narrow<std::size_t>(entry.frames));
+		for (int j = 0; j < entry.channels; ++j) {
+			audio.copy(j, 0, channel);
+			entry.rms[gsl::narrow<std::size_t>(j)] = rms(channel);
+			if (entry.encoding == StimulusBank::Encoding::pcm16) {
+				compact.resize(channel.size());
+				for (std::size_t k = 0; k < channel.size(); ++k)
+					compact[k] = static_cast<std::int16_t>(channel[k] * 32768);
+				bank.write(
+					reinterpret_cast<const char *>(compact.data()), 
+					gsl::narrow<std::streamsize>(compact.size() * sizeof(std::int16_t))
+				);
+			}
+			else
+				bank.write(
+					reinterpret_cast<const char *>(channel.data()), 
+					gsl::narrow<std::streamsize>(channel.size() * sizeof(float))
+				);
+		}
+	}
+
+	const auto index_ = index(entries);
+	if (index_.size() != indexBytes)
+		throw FileError{ "Stimuli changed while the bank was being built." };
+	bank.seekp(0);
+	bank.write(index_.data(), gsl::narrow<std::streamsize>(index_.size()));
+	bank.flush();
+	if (bank.fail())
+		throw FileError{ "Stimulus bank cannot be written." };
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "AudioFile.h"
+#include "audio-file-reading-writing-exports.h"
+#include <common-includes/RuntimeError.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Packs stimuli into a StimulusBank. Each stimulus is decoded and written
+// before the next, so only one is ever held in memory, and its channels'
+// RMS are measured on the way.
+class StimulusBankBuilder {
+	struct Stimulus {
+		std::string name;
+		std::string filePath;
+	};
+	std::vector<Stimulus> stimuli{};
+	AudioFileFactory *files;
+public:
+	AUDIO_FILE_READING_WRITING_API explicit StimulusBankBuilder(AudioFileFactory *) noexcept;
+	AUDIO_FILE_READING_WRITING_API void add(std::string name, std::string filePath);
+
+	// The stream must be seekable, since the index is written last.
+	// Throws FileError when a stimulus cannot be read or the bank cannot
+	// be written.
+	AUDIO_FILE_READING_WRITING_API void write(std::ostream &);
+	RUNTIME_ERROR(FileError)
+};
@@ -0,0 +1,230 @@
+#include "StreamingAudioFile.h"
+#include <gsl/gsl>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	void backOff(int &attempts) {
+		constexpr int spins = 1 << 10;
+		constexpr int yields = 1 << 10;
+		if (attempts >= spins + yields)
+			std::this_thread::sleep_for(std::chrono::microseconds{ 100 });
+		else if (attempts >= spins)
+			std::this_thread::yield();
+		++attempts;
+	}
+}
+
+StreamingAudioFile::StreamingAudioFile(
+	std::shared_ptr<AudioFileReader> file_,
+	int framesPerBlock,
+	int blockCount
+) :
+	blocks(gsl::narrow<std::size_t>(blockCount)),
+	emptyBlocks(gsl::narrow<std::size_t>(blockCount)),
+	decodedBlocks(gsl::narrow<std::size_t>(blockCount)),
+	file{ std::move(file_) },
+	frames_{ file->frames() },
+	framesPerBlock{ framesPerBlock },
+	channels_{ file->channels() },
+	sampleRate_{ file->sampleRate() }
+{
+	if (file->failed())
+		throw FileError{ file->errorMessage() };
+	interleaved.resize(gsl::narrow<std::size_t>(framesPerBlock * channels_));
+	for (auto &block : blocks)
+		block.channels.resize(
+			gsl::narrow<std::size_t>(channels_), 
+			std::vector<sample_type>(gsl::narrow<std::size_t>(framesPerBlock))
+		);
+	start();
+}
+
+StreamingAudioFile::~StreamingAudioFile() noexcept {
+	stop();
+}
+
+void StreamingAudioFile::start() {
+	for (auto &block : blocks)
+		emptyBlocks.push(&block);
+	decodeFailure = {};
+	decoded = 0;
+	decodeFailed = false;
+	stopping = false;
+	playing = false;
+	decoding = std::thread{ [this]() { decode(); } };
+}
+
+void StreamingAudioFile::stop() {
+	stopping = true;
+	if (decoding.joinable())
+		decoding.join();
+	Block *block{};
+	while (emptyBlocks.pop(block)) {}
+	while (decodedBlocks.pop(block)) {}
+	current = nullptr;
+	head = 0;
+}
+
+void StreamingAudioFile::decode() {
+	try {
+		while (decoded < frames_) {
+			auto block = await(emptyBlocks);
+			if (block == nullptr)
+				return;
+			block->frames = std::min(framesPerBlock, frames_ - decoded);
+			file->readFrames(interleaved.data(), block->frames);
+			for (int channel = 0; channel < channels_; ++channel) {
+				auto &planar = block->channels[gsl::narrow_cast<std::size_t>(channel)];
+				for (long long i = 0; i < block->frames; ++i)
+					planar[gsl::narrow_cast<std::size_t>(i)] = 
+						interleaved[gsl::narrow_cast<std::size_t>(i * channels_ + channel)];
+			}
+			enqueue(decodedBlocks, block);
+			decoded += block->frames;
+		}
+	}
+	catch (...) {
+		decodeFailure = std::current_exception();
+		decodeFailed = true;
+		enqueue(decodedBlocks, nullptr);
+	}
+}
+
+auto StreamingAudioFile::await(SpscQueue<Block *> &queue) -> Block * {
+	Block *block{};
+	for (int attempts = 0; !queue.pop(block); backOff(attempts))
+		if (stopping)
+			return nullptr;
+	return block;
+}
+
+void StreamingAudioFile::enqueue(SpscQueue<Block *> &queue, Block *block) {
+	for (int attempts = 0; !queue.push(block); backOff(attempts))
+		if (stopping)
+			return;
+}
+
+void StreamingAudioFile::read(gsl::span<channel_type> audio) {
+	if (audio.size() != channels_ || audio.size() == 0)
+		return;
+	const auto wanted = std::min<long long>(audio.begin()->size(), remainingFrames());
+	long long offset{ 0 };
+	while (offset < wanted) {
+		if (current == nullptr && !takeDecodedBlock()) {
+			for (auto channel : audio)
+				std::fill(
+					channel.begin() + offset, 
+					channel.begin() + wanted, 
+					sample_type{ 0 }
+				);
+			return;
+		}
+		const auto count = std::min(current->frames - head, wanted - offset);
+		for (int channel = 0; channel < channels_; ++channel) {
+			const auto &planar = current->channels[gsl::narrow_cast<std::size_t>(channel)];
+			std::copy_n(
+				planar.begin() + head, 
+				count, 
+				audio[channel].begin() + offset
+			);
+		}
+		head += count;
+		offset += count;
+		framesRead += count;
+		// There is always room, since the queue can hold every block.
+		if (head == current->frames) {
+			emptyBlocks.push(current);
+			current = nullptr;
+			head = 0;
+		}
+	}
+}
+
+bool StreamingAudioFile::takeDecodedBlock() {
+	if (!playing)
+		current = await(decodedBlocks);
+	else if (!decodedBlocks.pop(current))
+		return false;
+	if (current != nullptr)
+		return true;
+	if (!playing)
+		std::rethrow_exception(decodeFailure);
+	framesRead = frames_;
+	return false;
+}
+
+bool StreamingAudioFile::complete() {
+	return framesRead == frames_;
+}
+
+int StreamingAudioFile::sampleRate() {
+	return sampleRate_;
+}
+
+int StreamingAudioFile::channels() {
+	return channels_;
+}
+
+long long StreamingAudioFile::frames() {
+	return frames_;
+}
+
+// Nothing read means the ring already holds the beginning.
+void StreamingAudioFile::reset() {
+	playing = false;
+	if (framesRead == 0)
+		return;
+	stop();
+	file->seek(0);
+	framesRead = 0;
+	start();
+}
+
+long long StreamingAudioFile::remainingFrames() {
+	return frames_ - framesRead;
+}
+
+// Playback starts with as much decoded as the ring can hold, so it falls
+// behind only when decoding cannot keep up.
+void StreamingAudioFile::prepareForPlayback() {
+	const auto ahead = std::min<long long>(
+		remainingFrames(), 
+		(gsl::narrow<long long>(blocks.size()) - 1) * framesPerBlock
+	);
+	int attempts{ 0 };
+	while (decoded - framesRead < ahead && !decodeFailed)
+		backOff(attempts);
+	if (decodeFailed)
+		throwReadFailure();
+	playing = true;
+}
+
+void StreamingAudioFile::throwReadFailure() {
+	try {
+		std::rethrow_exception(decodeFailure);
+	}
+	catch (const std::exception &e) {
+		throw ReadFailure{ e.what() };
+	}
+}
+
+StreamingAudioFileFactory::StreamingAudioFileFactory(
+	AudioFileFactory *factory,
+	double minimumSeconds,
+	AudioFileInMemory::Storage storage
+) noexcept :
+	factory{ factory },
+	minimumSeconds{ minimumSeconds },
+	storage{ storage } {}
+
+std::shared_ptr<AudioFrameReader> StreamingAudioFileFactory::make(
+	std::string filePath
+) {
+	auto file = factory->makeReader(std::move(filePath));
+	if (file->failed())
+		throw CreateError{ file->errorMessage() };
+	if (file->frames() < minimumSeconds * file->sampleRate())
+		return std::make_shared<AudioFileInMemory>(*file, storage);
+	return std::make_shared<StreamingAudioFile>(std::move(file));
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "AudioFile.h"
+#include "AudioFileInMemory.h"
+#include "audio-file-reading-writing-exports.h"
+#include <spatialized-hearing-aid-simulation/AudioFrameReader.h>
+#include <spatialized-hearing-aid-simulation/SpscQueue.h>
+#include <common-includes/RuntimeError.h>
+#include <exception>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Reads a file without holding all of it. A background thread decodes ahead
+// into a fixed ring of planar blocks, which travel to the reader and back
+// through lock-free queues, so reading can begin once the first block is
+// decoded. Reading waits when it catches up with decoding, except once 
+// prepared for playback: then it reads silence rather than wait, and a 
+// failure to decode ends the file early instead of throwing.
+class StreamingAudioFile : public AudioFrameReader {
+	using sample_type = channel_type::element_type;
+	struct Block {
+		std::vector<std::vector<sample_type>> channels;
+		long long frames;
+	};
+	std::vector<Block> blocks;
+	std::vector<sample_type> interleaved;
+	SpscQueue<Block *> emptyBlocks;
+	SpscQueue<Block *> decodedBlocks;
+	std::shared_ptr<AudioFileReader> file;
+	std::thread decoding{};
+	std::exception_ptr decodeFailure{};
+	std::atomic<long long> decoded{ 0 };
+	std::atomic<bool> decodeFailed{ false };
+	std::atomic<bool> stopping{ false };
+	bool playing{};
+	Block *current{};
+	long long head{};
+	long long framesRead{};
+	long long frames_;
+	long long framesPerBlock;
+	int channels_;
+	int sampleRate_;
+public:
+	AUDIO_FILE_READING_WRITING_API explicit StreamingAudioFile(
+		std::shared_ptr<AudioFileReader>,
+		int framesPerBlock = 8192,
+		int blocks = 16
+	);
+	AUDIO_FILE_READING_WRITING_API ~StreamingAudioFile() noexcept override;
+	StreamingAudioFile(const StreamingAudioFile &) = delete;
+	StreamingAudioFile &operator=(const StreamingAudioFile &) = delete;
+	StreamingAudioFile(StreamingAudioFile &&) = delete;
+	StreamingAudioFile &operator=(StreamingAudioFile &&) = delete;
+	RUNTIME_ERROR(FileError)
+	AUDIO_FILE_READING_WRITING_API void read(gsl::span<channel_type> audio) override;
+	AUDIO_FILE_READING_WRITING_API bool complete() override;
+	AUDIO_FILE_READING_WRITING_API int sampleRate() override;
+	AUDIO_FILE_READING_WRITING_API int channels() override;
+	AUDIO_FILE_READING_WRITING_API long long frames() override;
+	AUDIO_FILE_READING_WRITING_API void reset() override;
+	AUDIO_FILE_READING_WRITING_API long long remainingFrames() override;
+	AUDIO_FILE_READING_WRITING_API void prepareForPlayback() override;
+private:
+	void start();
+	void stop();
+	void decode();
+	bool takeDecodedBlock();
+	void throwReadFailure();
+	Block *await(SpscQueue<Block *> &);
+	void enqueue(SpscQueue<Block *> &, Block *);
+};
+
+// Streams files at least as long as the given duration and reads shorter
+// ones into memory, where there is nothing to gain from streaming them.
+class StreamingAudioFileFactory : public AudioFrameReaderFactory {
+	AudioFileFactory *factory;
+	double minimumSeconds;
+	AudioFileInMemory::Storage storage;
+public:
+	AUDIO_FILE_READING_WRITING_API explicit StreamingAudioFileFactory(
+		AudioFileFactory *,
+		double minimumSeconds = 0,
+		AudioFileInMemory::Storage = AudioFileInMemory::Storage::full
+	) noexcept;
+	AUDIO_FILE_READING_WRITING_API 
+		std::shared_ptr<AudioFrameReader> make(std::string filePath) override;
+};
@@ -12,6 +12,7 @@ public:
 	virtual std::vector<double> asVector(std::string property) = 0;
 	virtual double asDouble(std::string property) = 0;
 	virtual int asInt(std::string property) = 0;
+	virtual std::string asString(std::string property) = 0;
     RUNTIME_ERROR(ParseError)
 };
 
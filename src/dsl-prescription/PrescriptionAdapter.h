@@ -1,19 +1,10 @@
 #pragma once
 
 #include "ConfigurationFileParser.h"
+#include "dsl-prescription-exports.h"
 #include <spatialized-hearing-aid-simulation/PrescriptionReader.h>
 #include <string>
 
-#ifdef _WIN32
-    #ifdef DSL_PRESCRIPTION_EXPORTS
-        #define DSL_PRESCRIPTION_API __declspec(dllexport)
-    #else
-        #define DSL_PRESCRIPTION_API __declspec(dllimport)
-    #endif
-#else
-    #define DSL_PRESCRIPTION_API
-#endif
-
 namespace dsl_prescription {
 	enum class Property {
 		crossFrequenciesHz,
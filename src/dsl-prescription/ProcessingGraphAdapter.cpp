@@ -0,0 +1,109 @@
+#include "ProcessingGraphAdapter.h"
+#include <gsl/gsl>
+
+std::string processing_graph::propertyName(Property p) {
+	switch (p) {
+	case Property::nodes:
+		return "nodes";
+	case Property::type:
+		return "type";
+	case Property::inputs:
+		return "inputs";
+	case Property::channel:
+		return "channel";
+	case Property::file:
+		return "file";
+	}
+    return "unknown";
+}
+
+std::string processing_graph::propertyName(int node, Property p) {
+	return "node " + std::to_string(node) + " " + propertyName(p);
+}
+
+std::string processing_graph::typeName(ProcessingGraphReader::NodeType t) {
+	using NodeType = ProcessingGraphReader::NodeType;
+	switch (t) {
+	case NodeType::input:
+		return "input";
+	case NodeType::output:
+		return "output";
+	case NodeType::scale:
+		return "scale";
+	case NodeType::fir:
+		return "FIR";
+	case NodeType::hearingAid:
+		return "hearing aid";
+	case NodeType::mix:
+		return "mix";
+	case NodeType::split:
+		return "split";
+	}
+    return "unknown";
+}
+
+ProcessingGraphAdapter::ProcessingGraphAdapter(ConfigurationFileParserFactory *factory) noexcept :
+	factory{ factory } {}
+
+auto ProcessingGraphAdapter::read(std::string filePath) -> std::vector<Node> {
+	try {
+		return read_(std::move(filePath));
+	}
+	catch (const ConfigurationFileParser::ParseError &e) {
+		throw ReadFailure{ e.what() };
+	}
+}
+
+static ProcessingGraphReader::NodeType nodeType(std::string name) {
+	using NodeType = ProcessingGraphReader::NodeType;
+	for (auto type : {
+		NodeType::input,
+		NodeType::output,
+		NodeType::scale,
+		NodeType::fir,
+		NodeType::hearingAid,
+		NodeType::mix,
+		NodeType::split
+	})
+		if (processing_graph::typeName(type) == name)
+			return type;
+	throw ProcessingGraphReader::ReadFailure{ "unknown node type '" + name + "'." };
+}
+
+static bool hasInputs(ProcessingGraphReader::NodeType t) noexcept {
+	return t != ProcessingGraphReader::NodeType::input;
+}
+
+static bool hasChannel(ProcessingGraphReader::NodeType t) noexcept {
+	using NodeType = ProcessingGraphReader::NodeType;
+	return 
+		t == NodeType::input || 
+		t == NodeType::output || 
+		t == NodeType::scale || 
+		t == NodeType::fir;
+}
+
+static bool hasFile(ProcessingGraphReader::NodeType t) noexcept {
+	using NodeType = ProcessingGraphReader::NodeType;
+	return t == NodeType::fir || t == NodeType::hearingAid;
+}
+
+auto ProcessingGraphAdapter::read_(std::string filePath) -> std::vector<Node> {
+	auto parser = factory->make(std::move(filePath));
+	using namespace processing_graph;
+	const auto count = parser->asInt(propertyName(Property::nodes));
+	std::vector<Node> nodes;
+	for (int i = 0; i < count; ++i) {
+		Node node{};
+		node.type = nodeType(parser->asString(propertyName(i, Property::type)));
+		if (hasInputs(node.type))
+			for (auto input : parser->asVector(propertyName(i, Property::inputs)))
+				node.inputs.push_back(gsl::narrow_cast<int>(input));
+		if (hasChannel(node.type))
+			node.channel = parser->asInt(propertyName(i, Property::channel));
+		if (hasFile(node.type))
+			node.filePath = parser->asString(propertyName(i, Property::file));
+		nodes.push_back(std::move(node));
+	}
+	return nodes;
+}
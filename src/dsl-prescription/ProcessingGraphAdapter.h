@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ConfigurationFileParser.h"
+#include "dsl-prescription-exports.h"
+#include <spatialized-hearing-aid-simulation/ProcessingGraphReader.h>
+#include <string>
+
+namespace processing_graph {
+	enum class Property {
+		nodes,
+		type,
+		inputs,
+		channel,
+		file
+	};
+
+	DSL_PRESCRIPTION_API std::string propertyName(Property);
+	DSL_PRESCRIPTION_API std::string propertyName(int node, Property);
+	DSL_PRESCRIPTION_API std::string typeName(ProcessingGraphReader::NodeType);
+}
+
+// Reads a graph from flat properties: "nodes" holds the node count and 
+// "node <n> type", "node <n> inputs", "node <n> channel" and "node <n> file"
+// describe node n, where only the properties its type uses are required.
+class ProcessingGraphAdapter : public ProcessingGraphReader {
+	ConfigurationFileParserFactory *factory;
+public:
+	DSL_PRESCRIPTION_API explicit ProcessingGraphAdapter(
+		ConfigurationFileParserFactory *
+	) noexcept;
+	DSL_PRESCRIPTION_API std::vector<Node> read(std::string filePath) override;
+private:
+	std::vector<Node> read_(std::string filePath);
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#ifdef _WIN32
+    #ifdef DSL_PRESCRIPTION_EXPORTS
+        #define DSL_PRESCRIPTION_API __declspec(dllexport)
+    #else
+        #define DSL_PRESCRIPTION_API __declspec(dllimport)
+    #endif
+#else
+    #define DSL_PRESCRIPTION_API
+#endif
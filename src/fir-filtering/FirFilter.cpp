@@ -43,6 +43,14 @@ static constexpr int nextPowerOfTwo(typename FirFilter<T>::coefficients_size_typ
 
 template<typename T>
 FirFilter<T>::FirFilter(coefficients_type b) :
+	FirFilter{ std::move(b), allocator_type{} } {}
+
+template<typename T>
+FirFilter<T>::FirFilter(coefficients_type b, const allocator_type &allocator) :
+	H(allocator),
+	dftComplex(allocator),
+	dftReal(b.begin(), b.end(), allocator),
+	overlap(allocator),
 	order{ b.size() - 1 }
 {
 	if (b.size() == 0)
@@ -51,7 +59,6 @@ FirFilter<T>::FirFilter(coefficients_type b) :
 	N = nextPowerOfTwo<T>(order);
 	L = N - order;
 	overlap.resize(N);
-	dftReal = std::move(b);
 	dftReal.resize(N);
 	dftComplex.resize(N/2 + 1);
 	fftPlan = fftw_plan_dft_r2c_1d_adapted(
@@ -138,5 +145,10 @@ auto FirFilter<T>::groupDelay() -> index_type {
 	return order / 2;
 }
 
+template<typename T>
+void FirFilter<T>::reset() {
+	std::fill(overlap.begin(), overlap.end(), sample_type{ 0 });
+}
+
 template class FirFilter<float>;
 template class FirFilter<double>;
@@ -4,6 +4,7 @@
 #include <gsl/gsl>
 #include <vector>
 #include <complex>
+#include <memory_resource>
 #include <type_traits>
 
 #ifdef _WIN32
@@ -30,10 +31,12 @@ public:
 	using coefficients_type = std::vector<sample_type>;
 	using coefficients_size_type = typename coefficients_type::size_type;
 	using complex_type = std::complex<sample_type>;
-	using complex_signal_type = std::vector<complex_type>;
-	using real_signal_type = std::vector<sample_type>;
+	using complex_signal_type = std::pmr::vector<complex_type>;
+	using real_signal_type = std::pmr::vector<sample_type>;
+	using allocator_type = std::pmr::polymorphic_allocator<sample_type>;
 
 	FIR_FILTERING_API explicit FirFilter(coefficients_type b);
+	FIR_FILTERING_API FirFilter(coefficients_type b, const allocator_type &);
 	class InvalidCoefficients {};
 	FIR_FILTERING_API ~FirFilter();
 	FirFilter(const FirFilter &) = delete;
@@ -42,11 +45,12 @@ public:
     FirFilter& operator=(FirFilter&&) = delete;
 	FIR_FILTERING_API void process(signal_type);
 	FIR_FILTERING_API index_type groupDelay();
+	FIR_FILTERING_API void reset();
 private:
-	complex_signal_type H{};
-	complex_signal_type dftComplex{};
-	real_signal_type dftReal{};
-	real_signal_type overlap{};
+	complex_signal_type H;
+	complex_signal_type dftComplex;
+	real_signal_type dftReal;
+	real_signal_type overlap;
 	using fftw_plan_type = typename std::conditional<
 		std::is_same_v<sample_type, double>, 
 		fftw_plan, 
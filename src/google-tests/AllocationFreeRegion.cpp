@@ -0,0 +1,116 @@
+#include "AllocationFreeRegion.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#endif
+
+static std::atomic<int> openRegions{ 0 };
+static std::atomic<long long> allocationsInRegions{ 0 };
+
+static void countAllocation() noexcept {
+	if (openRegions.load(std::memory_order_relaxed) > 0)
+		allocationsInRegions.fetch_add(1, std::memory_order_relaxed);
+}
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+static int countCrtAllocation(
+	int type,
+	void *,
+	size_t,
+	int blockType,
+	long,
+	const unsigned char *,
+	int
+) {
+	if (type != _HOOK_FREE && blockType != _CRT_BLOCK)
+		countAllocation();
+	return TRUE;
+}
+
+static const auto previousCrtHook = _CrtSetAllocHook(countCrtAllocation);
+#endif
+
+static void *allocate(std::size_t n) {
+	countAllocation();
+	if (auto p = std::malloc(n ? n : 1))
+		return p;
+	throw std::bad_alloc{};
+}
+
+static void *allocate(std::size_t n, std::align_val_t alignment_) {
+	countAllocation();
+	const auto alignment = static_cast<std::size_t>(alignment_);
+#ifdef _MSC_VER
+	if (auto p = _aligned_malloc(n ? n : 1, alignment))
+		return p;
+#else
+	if (auto p = std::aligned_alloc(alignment, (n + alignment - 1) / alignment * alignment))
+		return p;
+#endif
+	throw std::bad_alloc{};
+}
+
+static void deallocateAligned(void *p) noexcept {
+#ifdef _MSC_VER
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+// The array and nothrow forms forward to these by default.
+void *operator new(std::size_t n) {
+	return allocate(n);
+}
+
+void operator delete(void *p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+	std::free(p);
+}
+
+void *operator new(std::size_t n, std::align_val_t alignment) {
+	return allocate(n, alignment);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+	deallocateAligned(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+	deallocateAligned(p);
+}
+
+AllocationFreeRegion::AllocationFreeRegion() noexcept :
+	allocationsBefore{ allocationsInRegions.load() }
+{
+	++openRegions;
+}
+
+AllocationFreeRegion::~AllocationFreeRegion() noexcept {
+	close();
+}
+
+void AllocationFreeRegion::close() noexcept {
+	if (open)
+		--openRegions;
+	open = false;
+}
+
+long long AllocationFreeRegion::allocations() const noexcept {
+	return allocationsInRegions.load() - allocationsBefore;
+}
+
+void AllocationFreeRegion::assertNoAllocations() noexcept {
+	const auto allocations_ = allocations();
+	close();
+	EXPECT_EQ(0, allocations_) << "The heap was used inside an allocation-free region.";
+}
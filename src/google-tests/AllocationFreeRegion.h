@@ -0,0 +1,30 @@
+#pragma once
+
+// Marks code that must not touch the heap. The test executable replaces the
+// global allocation functions (and, under the debug CRT, hooks malloc) so
+// that any allocation made on any thread while a region is open is counted.
+class AllocationFreeRegion {
+	long long allocationsBefore;
+	bool open{ true };
+public:
+	AllocationFreeRegion() noexcept;
+	~AllocationFreeRegion() noexcept;
+	AllocationFreeRegion(const AllocationFreeRegion &) = delete;
+	AllocationFreeRegion &operator=(const AllocationFreeRegion &) = delete;
+	AllocationFreeRegion(AllocationFreeRegion &&) = delete;
+	AllocationFreeRegion &operator=(AllocationFreeRegion &&) = delete;
+
+	// Closes the region, then fails the current test if anything allocated.
+	void assertNoAllocations() noexcept;
+
+	long long allocations() const noexcept;
+private:
+	void close() noexcept;
+};
+
+template<typename F>
+void assertAllocationFree(F &&f) {
+	AllocationFreeRegion region{};
+	f();
+	region.assertNoAllocations();
+}
@@ -34,7 +34,7 @@ public:
 		return collection.end();
 	}
 
-	auto size() {
+	auto size() const {
 		return collection.size();
 	}
 };
\ No newline at end of file
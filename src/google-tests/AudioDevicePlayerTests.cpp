@@ -1,5 +1,6 @@
 #include "AudioDeviceStub.h"
 #include "AudioLoaderStub.h"
+#include "RealTimeSetupStub.h"
 #include "assert-utility.h"
 #include <playing-audio/AudioDevicePlayer.h>
 #include <gtest/gtest.h>
@@ -97,6 +98,100 @@ namespace {
 		assertEqual(size_type{ 1 }, loader->audioBuffer().at(1).size());
 	}
 
+	TEST_F(AudioDevicePlayerTests, prepareToPlayOpensStreamAtDeviceBufferSizeWhenGiven) {
+		AudioDevicePlayer adaptingPlayer{ &device, 2 };
+		AudioDevicePlayer::Preparation p;
+		p.framesPerBuffer = 8;
+		adaptingPlayer.prepareToPlay(p);
+		assertEqual(2UL, device.streamParameters().framesPerBuffer);
+	}
+
+	TEST_F(AudioDevicePlayerTests, fillStreamBufferAdaptsDeviceBuffersToLoaderBlocks) {
+		AudioDevicePlayer adaptingPlayer{ &device, 2 };
+		auto fake = std::make_shared<FakeAudioLoader>();
+		fake->setAudioToLoad({ 1, 2, 3, 4 });
+		adaptingPlayer.setAudioLoader(fake);
+		AudioDevicePlayer::Preparation p;
+		p.framesPerBuffer = 4;
+		p.channels = 1;
+		adaptingPlayer.prepareToPlay(p);
+		std::vector<float> first(2);
+		std::vector<float> second(2);
+		float *x[]{ first.data() };
+		fillStreamBuffer(x, 2);
+		x[0] = second.data();
+		fillStreamBuffer(x, 2);
+		assertEqual({ 1, 2 }, first);
+		assertEqual({ 3, 4 }, second);
+		assertTrue(device.complete());
+	}
+
+	TEST_F(AudioDevicePlayerTests, prepareToPlayPrimesLoaderWithSilentBlock) {
+		AudioDevicePlayer::Preparation p;
+		p.framesPerBuffer = 3;
+		p.channels = 2;
+		prepareToPlay(p);
+		assertEqual(1, loader->primings());
+		assertEqual(2, loader->primedChannels());
+		assertEqual(3, loader->primedFrames());
+	}
+
+	TEST_F(AudioDevicePlayerTests, setAudioLoaderPrimesNewLoaderOnce) {
+		AudioDevicePlayer::Preparation p;
+		p.framesPerBuffer = 3;
+		p.channels = 1;
+		prepareToPlay(p);
+		auto next = std::make_shared<AudioLoaderStub>();
+		player.setAudioLoader(next);
+		prepareToPlay(p);
+		assertEqual(1, next->primings());
+	}
+
+	TEST_F(AudioDevicePlayerTests, doesNotPrimeWhileStreaming) {
+		AudioDevicePlayer::Preparation p;
+		p.framesPerBuffer = 3;
+		p.channels = 1;
+		prepareToPlay(p);
+		device.setStreaming();
+		auto next = std::make_shared<AudioLoaderStub>();
+		player.setAudioLoader(next);
+		assertEqual(0, next->primings());
+	}
+
+	TEST_F(AudioDevicePlayerTests, adaptedLoaderPrimedWithWholeBlock) {
+		AudioDevicePlayer adaptingPlayer{ &device, 2 };
+		AudioDevicePlayer::Preparation p;
+		p.framesPerBuffer = 8;
+		p.channels = 1;
+		adaptingPlayer.prepareToPlay(p);
+		adaptingPlayer.setAudioLoader(loader);
+		assertEqual(8, loader->primedFrames());
+	}
+
+	TEST_F(AudioDevicePlayerTests, firstCallbackAfterPlayConfiguresItsThread) {
+		RealTimeSetupStub realTime{};
+		AudioDevicePlayer realTimePlayer{ &device, 0, &realTime };
+		realTimePlayer.setAudioLoader(loader);
+		realTimePlayer.play();
+		fillStreamBuffer();
+		fillStreamBuffer();
+		assertEqual(1, realTime.threadsConfigured());
+		realTimePlayer.play();
+		fillStreamBuffer();
+		assertEqual(2, realTime.threadsConfigured());
+	}
+
+	TEST_F(AudioDevicePlayerTests, warmUpLocksMemory) {
+		RealTimeSetupStub realTime{};
+		AudioDevicePlayer realTimePlayer{ &device, 0, &realTime };
+		AudioDevicePlayer::Preparation p;
+		p.framesPerBuffer = 3;
+		p.channels = 1;
+		realTimePlayer.prepareToPlay(p);
+		realTimePlayer.setAudioLoader(loader);
+		assertEqual(1, realTime.memoryLocks());
+	}
+
 	TEST_F(AudioDevicePlayerTests, isPlayingWhenDeviceIsStreaming) {
 		assertFalse(player.isPlaying());
 		device.setStreaming();
@@ -2,6 +2,7 @@
 #include "assert-utility.h"
 #include <audio-file-reading-writing/AudioFileInMemory.h>
 #include <gtest/gtest.h>
+#include <thread>
 
 namespace {
 	class AudioFileInMemoryFacade {
@@ -13,8 +14,11 @@ namespace {
 		buffer_type left{};
 		buffer_type right{};
 
-		explicit AudioFileInMemoryFacade(AudioFileReader &reader) :
-			inMemory{ reader } {}
+		explicit AudioFileInMemoryFacade(
+			AudioFileReader &reader,
+			AudioFileInMemory::Storage storage = AudioFileInMemory::Storage::full
+		) :
+			inMemory{ reader, storage } {}
 
 		void readMonoFrames(size_type n) {
 			left.resize(n);
@@ -40,6 +44,10 @@ namespace {
 		auto reset() {
 			return inMemory.reset();
 		}
+
+		auto bytes() {
+			return inMemory.bytes();
+		}
 	};
 
 	class AudioFileInMemoryTests : public ::testing::Test {
@@ -77,6 +85,20 @@ namespace {
 		assertEqual({ 2, 4, 6 }, facade.right);
 	}
 
+	TEST_F(AudioFileInMemoryTests, readFillsEachChannelOfLongFiles) {
+		reader.setChannels(2);
+		std::vector<float> contents(2 * 10000);
+		for (std::size_t i = 0; i < contents.size(); ++i)
+			contents[i] = gsl::narrow_cast<float>(i);
+		reader.setContents(contents);
+		auto facade = constructFacade();
+		facade.readStereoFrames(10000);
+		assertEqual(2 * 9999.0f, facade.left.back());
+		assertEqual(2 * 9999.0f + 1, facade.right.back());
+		assertEqual(2 * 5000.0f, facade.left.at(5000));
+		assertEqual(2 * 5000.0f + 1, facade.right.at(5000));
+	}
+
 	TEST_F(AudioFileInMemoryTests, readNothingWhenExhausted) {
 		reader.setContents({ 2 });
 		auto facade = constructFacade();
@@ -182,6 +204,95 @@ namespace {
 		assertEqual({ 6 }, facade.right);
 	}
 
+	TEST_F(AudioFileInMemoryTests, compactReadFillsEachChannel) {
+		reader.setChannels(2);
+		reader.setContents({ -1, 0.5, 32767 / 32768.0f, -0.25, 0, 1 / 32768.0f });
+		AudioFileInMemoryFacade facade{ reader, AudioFileInMemory::Storage::compact };
+		facade.readStereoFrames(3);
+		assertEqual({ -1, 32767 / 32768.0f, 0 }, facade.left);
+		assertEqual({ 0.5, -0.25, 1 / 32768.0f }, facade.right);
+	}
+
+	TEST_F(AudioFileInMemoryTests, compactStorageHoldsSixteenBitSamples) {
+		reader.setChannels(2);
+		reader.setContents({ 1 / 32768.0f, 2 / 32768.0f, 3 / 32768.0f, 4 / 32768.0f });
+		AudioFileInMemory inMemory{ reader, AudioFileInMemory::Storage::compact };
+		assertEqual(4 * sizeof(std::int16_t), inMemory.bytes());
+	}
+
+	TEST_F(AudioFileInMemoryTests, fullStorageHoldsFloats) {
+		reader.setChannels(2);
+		reader.setContents({ 1 / 32768.0f, 2 / 32768.0f, 3 / 32768.0f, 4 / 32768.0f });
+		AudioFileInMemory inMemory{ reader };
+		assertEqual(4 * sizeof(float), inMemory.bytes());
+	}
+
+	TEST_F(AudioFileInMemoryTests, compactStorageKeepsFullPrecisionWhenSixteenBitsCannotHoldSamples) {
+		reader.setChannels(1);
+		reader.setContents({ 0.5, 0.1f, 1 });
+		AudioFileInMemoryFacade facade{ reader, AudioFileInMemory::Storage::compact };
+		facade.readMonoFrames(3);
+		assertEqual({ 0.5, 0.1f, 1 }, facade.left);
+		assertEqual(3 * sizeof(float), facade.bytes());
+	}
+
+	TEST_F(AudioFileInMemoryTests, compactStorageKeepsEarlierSamplesWhenFallingBackLate) {
+		reader.setChannels(1);
+		std::vector<float> contents(10000, 0.25);
+		contents.back() = 0.1f;
+		reader.setContents(contents);
+		AudioFileInMemoryFacade facade{ reader, AudioFileInMemory::Storage::compact };
+		facade.readMonoFrames(10000);
+		assertEqual(0.25f, facade.left.front());
+		assertEqual(0.25f, facade.left.at(5000));
+		assertEqual(0.1f, facade.left.back());
+	}
+
+	TEST_F(AudioFileInMemoryTests, readersOfSameAudioReadFromTheirOwnPositions) {
+		reader.setContents({ 1, 2, 3 });
+		AudioFileInMemory first{ reader };
+		AudioFileInMemory second{ first.decoded() };
+		std::vector<float> x(2);
+		std::vector<AudioFileInMemory::channel_type> mono{ x };
+		first.read(mono);
+		assertEqual(3LL, second.remainingFrames());
+		second.read(mono);
+		assertEqual({ 1, 2 }, x);
+		first.read(mono);
+		assertEqual(3.0f, x.front());
+	}
+
+	TEST_F(AudioFileInMemoryTests, readersOfSameAudioShareIt) {
+		reader.setContents({ 1, 2, 3 });
+		AudioFileInMemory first{ reader };
+		AudioFileInMemory second{ first.decoded() };
+		assertTrue(first.decoded() == second.decoded());
+	}
+
+	TEST_F(AudioFileInMemoryTests, readersOfSameAudioReadConcurrently) {
+		std::vector<float> contents(10000);
+		for (std::size_t i = 0; i < contents.size(); ++i)
+			contents[i] = gsl::narrow_cast<float>(i);
+		reader.setContents(contents);
+		const auto audio = std::make_shared<const DecodedAudio>(reader);
+		std::vector<std::vector<float>> results(4);
+		std::vector<std::thread> threads;
+		for (auto &result : results)
+			threads.emplace_back([&audio, &result]() {
+				AudioFileInMemory cursor{ audio };
+				std::vector<float> x(100);
+				std::vector<AudioFileInMemory::channel_type> mono{ x };
+				while (!cursor.complete()) {
+					cursor.read(mono);
+					result.insert(result.end(), x.begin(), x.end());
+				}
+			});
+		for (auto &thread : threads)
+			thread.join();
+		for (const auto &result : results)
+			assertEqual(contents, result);
+	}
+
 	class AudioFileInMemoryFactoryTests : public ::testing::Test {
 	protected:
 		std::shared_ptr<FakeAudioFileReader> reader =
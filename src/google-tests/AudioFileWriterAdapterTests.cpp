@@ -43,6 +43,16 @@ namespace {
 		assertEqual({ 1, 2, 3, 4 }, writer->written());
 	}
 
+	TEST_F(AudioFileWriterAdapterTests, writeInterleavesEachBlock) {
+		left = { 1, 3, 5 };
+		right = { 2, 4, 6 };
+		writeStereo();
+		left = { 7 };
+		right = { 8 };
+		writeStereo();
+		assertEqual({ 1, 2, 3, 4, 5, 6, 7, 8 }, writer->written());
+	}
+
 	TEST_F(AudioFileWriterAdapterTests, writeEmptyAudioDoesNotThrow) {
 		std::vector<channel_type> channels{};
 		adapter.write(channels);
@@ -5,6 +5,7 @@
 class AudioFrameProcessorStub : public AudioFrameProcessor {
 	gsl::span<channel_type> audioBuffer_{};
 	int groupDelay_{};
+	int resets_{};
 	bool complete_{};
 public:
 	auto audioBuffer() const noexcept {
@@ -23,6 +24,14 @@ public:
 		return groupDelay_;
 	}
 
+	void reset() override {
+		++resets_;
+	}
+
+	auto resets() const noexcept {
+		return resets_;
+	}
+
 	void setComplete() noexcept {
 		complete_ = true;
 	}
@@ -69,6 +69,10 @@ public:
 		log_.insert("reset ");
 	}
 
+	void prepareForPlayback() override {
+		log_.insert("prepareForPlayback ");
+	}
+
 	void setIncomplete() noexcept {
 		complete_ = false;
 	}
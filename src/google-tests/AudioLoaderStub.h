@@ -7,6 +7,9 @@
 class AudioLoaderStub : public AudioLoader {
 	LogString log_{};
 	gsl::span<channel_type> audioBuffer_{};
+	int primedChannels_{};
+	int primedFrames_{};
+	int primings_{};
 	bool complete_{};
 public:
 	void setComplete() noexcept {
@@ -24,6 +27,24 @@ public:
 	auto audioBuffer() const noexcept {
 		return audioBuffer_;
 	}
+
+	void prime(gsl::span<channel_type> silence) override {
+		primedChannels_ = gsl::narrow<int>(silence.size());
+		primedFrames_ = silence.size() ? gsl::narrow<int>(silence.begin()->size()) : 0;
+		++primings_;
+	}
+
+	auto primedChannels() const noexcept {
+		return primedChannels_;
+	}
+
+	auto primedFrames() const noexcept {
+		return primedFrames_;
+	}
+
+	auto primings() const noexcept {
+		return primings_;
+	}
 };
 
 class AudioProcessingLoaderStubFactory : public AudioProcessingLoaderFactory {
@@ -83,6 +104,8 @@ public:
 		++loadCount_;
 	}
 
+	void prime(gsl::span<channel_type>) override {}
+
 	auto audio() const {
 		return audio_;
 	}
@@ -106,4 +129,6 @@ public:
 			for (auto &x : channel)
 				x = audioToLoad_.at(head++);
 	}
+
+	void prime(gsl::span<channel_type>) override {}
 };
\ No newline at end of file
@@ -89,4 +89,17 @@ public:
 	void stop() override {}
 	bool isPlaying() override { return {}; }
 	void setAudioLoader(std::shared_ptr<AudioLoader>) override {}
+};
+
+class ReadFailingAudioPlayer : public AudioPlayer {
+public:
+	void prepareToPlay(Preparation) override {}
+	std::vector<std::string> audioDeviceDescriptions() override { return {}; }
+	void play() override {}
+	void stop() override {}
+	bool isPlaying() override { return {}; }
+
+	void setAudioLoader(std::shared_ptr<AudioLoader>) override {
+		throw AudioFrameReader::ReadFailure{ "error." };
+	}
 };
\ No newline at end of file
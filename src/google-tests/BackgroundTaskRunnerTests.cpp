@@ -0,0 +1,38 @@
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/BackgroundTaskRunner.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace {
+	class BackgroundTaskRunnerTests : public ::testing::Test {
+	protected:
+		BackgroundTaskRunner runner{};
+	};
+
+	TEST_F(BackgroundTaskRunnerTests, awaitReturnsAfterTasksFinish) {
+		int x{};
+		runner.run([&]() { x = 1; });
+		runner.await();
+		assertEqual(1, x);
+	}
+
+	TEST_F(BackgroundTaskRunnerTests, runsTasksInOrder) {
+		std::vector<int> order{};
+		for (int i = 0; i < 5; ++i)
+			runner.run([&, i]() { order.push_back(i); });
+		runner.await();
+		assertEqual({ 0, 1, 2, 3, 4 }, order);
+	}
+
+	TEST_F(BackgroundTaskRunnerTests, continuesAfterTaskThrows) {
+		int x{};
+		runner.run([]() { throw std::runtime_error{ "error." }; });
+		runner.run([&]() { x = 1; });
+		runner.await();
+		assertEqual(1, x);
+	}
+
+	TEST_F(BackgroundTaskRunnerTests, awaitReturnsWithoutTasks) {
+		runner.await();
+	}
+}
@@ -0,0 +1,93 @@
+#include "AudioLoaderStub.h"
+#include "assert-utility.h"
+#include <playing-audio/BlockSizeAdapter.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class BlockSizeAdapterTests : public ::testing::Test {
+	protected:
+		using channel_type = AudioLoader::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+		std::shared_ptr<FakeAudioLoader> loader = std::make_shared<FakeAudioLoader>();
+
+		BlockSizeAdapter makeAdapter(int framesPerBlock) {
+			return BlockSizeAdapter{ loader, 1, framesPerBlock };
+		}
+
+		buffer_type load(BlockSizeAdapter &adapter, int frames) {
+			buffer_type audio(frames);
+			std::vector<channel_type> channels{ audio };
+			adapter.load(channels);
+			return audio;
+		}
+	};
+
+	TEST_F(BlockSizeAdapterTests, smallerDeviceBuffersShareBlocks) {
+		loader->setAudioToLoad({ 1, 2, 3, 4, 5, 6, 7, 8 });
+		auto adapter = makeAdapter(4);
+		assertEqual({ 1, 2, 3 }, load(adapter, 3));
+		assertEqual({ 4, 5, 6 }, load(adapter, 3));
+		assertEqual({ 7, 8 }, load(adapter, 2));
+	}
+
+	TEST_F(BlockSizeAdapterTests, largerDeviceBuffersGatherSeveralBlocks) {
+		loader->setAudioToLoad({ 1, 2, 3, 4, 5, 6 });
+		auto adapter = makeAdapter(2);
+		assertEqual({ 1, 2, 3, 4, 5, 6 }, load(adapter, 6));
+	}
+
+	TEST_F(BlockSizeAdapterTests, loadsWholeBlocks) {
+		auto spy = std::make_shared<AudioLoaderSpy>();
+		spy->setLoadCompleteThreshold(2);
+		BlockSizeAdapter adapter{ spy, 2, 4 };
+		buffer_type left(3);
+		buffer_type right(3);
+		std::vector<channel_type> channels{ left, right };
+		adapter.load(channels);
+		adapter.load(channels);
+		const auto blocks = spy->audio();
+		assertEqual(2, gsl::narrow<int>(blocks.size()));
+		for (int i = 0; i < 2; ++i) {
+			const auto block = blocks.at(i);
+			assertEqual(2, gsl::narrow<int>(block.size()));
+			assertEqual(4, gsl::narrow<int>(block.at(0).size()));
+			assertEqual(4, gsl::narrow<int>(block.at(1).size()));
+		}
+	}
+
+	TEST_F(BlockSizeAdapterTests, padsZerosOnceLoaderCompletes) {
+		loader->setAudioToLoad({ 1, 2 });
+		auto adapter = makeAdapter(2);
+		assertEqual({ 1, 2, 0, 0 }, load(adapter, 4));
+	}
+
+	TEST_F(BlockSizeAdapterTests, completeOnlyOnceLoadedBlocksAreConsumed) {
+		loader->setAudioToLoad({ 1, 2, 3, 4 });
+		auto adapter = makeAdapter(4);
+		load(adapter, 2);
+		assertTrue(loader->complete());
+		assertFalse(adapter.complete());
+		load(adapter, 2);
+		assertTrue(adapter.complete());
+	}
+
+	TEST_F(BlockSizeAdapterTests, primesLoaderWithWholeBlock) {
+		auto stub = std::make_shared<AudioLoaderStub>();
+		BlockSizeAdapter adapter{ stub, 2, 4 };
+		buffer_type audio(3);
+		std::vector<channel_type> channels{ audio, audio };
+		adapter.prime(channels);
+		assertEqual(2, stub->primedChannels());
+		assertEqual(4, stub->primedFrames());
+	}
+
+	TEST_F(BlockSizeAdapterTests, doesNotPrimeWhileBlockIsBeingHandedOut) {
+		auto stub = std::make_shared<AudioLoaderStub>();
+		BlockSizeAdapter adapter{ stub, 1, 4 };
+		load(adapter, 2);
+		buffer_type audio(2);
+		std::vector<channel_type> channels{ audio };
+		adapter.prime(channels);
+		assertEqual(0, stub->primings());
+	}
+}
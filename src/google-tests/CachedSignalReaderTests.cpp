@@ -0,0 +1,88 @@
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/CachedSignalReader.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class CachedSignalReaderTests : public ::testing::Test {
+	protected:
+		using channel_type = AudioFrameReader::channel_type;
+		std::shared_ptr<CachedSignalReader> reader{};
+
+		void construct(SignalCache::channels_type channels, int sampleRate = 0) {
+			reader = std::make_shared<CachedSignalReader>(
+				std::make_shared<const SignalCache::channels_type>(std::move(channels)),
+				sampleRate
+			);
+		}
+
+		void read(std::vector<float> &left, std::vector<float> &right) {
+			std::vector<channel_type> audio{ left, right };
+			reader->read(audio);
+		}
+	};
+
+	TEST_F(CachedSignalReaderTests, readCopiesEachChannel) {
+		construct({ { 1, 2, 3 }, { 4, 5, 6 } });
+		std::vector<float> left(3);
+		std::vector<float> right(3);
+		read(left, right);
+		assertEqual({ 1, 2, 3 }, left);
+		assertEqual({ 4, 5, 6 }, right);
+	}
+
+	TEST_F(CachedSignalReaderTests, readContinuesFromLastRead) {
+		construct({ { 1, 2, 3, 4 }, { 5, 6, 7, 8 } });
+		std::vector<float> left(2);
+		std::vector<float> right(2);
+		read(left, right);
+		read(left, right);
+		assertEqual({ 3, 4 }, left);
+		assertEqual({ 7, 8 }, right);
+	}
+
+	TEST_F(CachedSignalReaderTests, readLeavesRemainderOfShortFinalBlockUntouched) {
+		construct({ { 1, 2, 3 } });
+		std::vector<float> left(2);
+		std::vector<channel_type> audio{ left };
+		reader->read(audio);
+		left = { 0, 0 };
+		audio = { left };
+		reader->read(audio);
+		assertEqual({ 3, 0 }, left);
+	}
+
+	TEST_F(CachedSignalReaderTests, completeAfterReadingAllFrames) {
+		construct({ { 1, 2, 3 } });
+		std::vector<float> left(2);
+		std::vector<channel_type> audio{ left };
+		reader->read(audio);
+		assertFalse(reader->complete());
+		reader->read(audio);
+		assertTrue(reader->complete());
+	}
+
+	TEST_F(CachedSignalReaderTests, remainingFramesDecreasesAfterRead) {
+		construct({ { 1, 2, 3 } });
+		std::vector<float> left(2);
+		std::vector<channel_type> audio{ left };
+		reader->read(audio);
+		assertEqual(1LL, reader->remainingFrames());
+	}
+
+	TEST_F(CachedSignalReaderTests, resetRestartsReading) {
+		construct({ { 1, 2, 3 } });
+		std::vector<float> left(3);
+		std::vector<channel_type> audio{ left };
+		reader->read(audio);
+		reader->reset();
+		assertEqual(3LL, reader->remainingFrames());
+		assertFalse(reader->complete());
+	}
+
+	TEST_F(CachedSignalReaderTests, returnsChannelsFramesAndSampleRate) {
+		construct({ { 1, 2, 3 }, { 4, 5, 6 } }, 48000);
+		assertEqual(2, reader->channels());
+		assertEqual(3LL, reader->frames());
+		assertEqual(48000, reader->sampleRate());
+	}
+}
@@ -6,6 +6,27 @@
 #include <gtest/gtest.h>
 #include <cmath>
 
+// Ones, more of them than a float sum can count.
+class LongReader : public AudioFrameReader {
+	long long head{};
+public:
+	static constexpr long long length = 1LL << 25;
+
+	void read(gsl::span<channel_type> audio) override {
+		for (auto channel : audio)
+			std::fill(channel.begin(), channel.end(), 1.0f);
+		head += audio.begin()->size();
+	}
+
+	bool complete() override { return head == length; }
+	int sampleRate() override { return 1; }
+	int channels() override { return 1; }
+	long long frames() override { return length; }
+	void reset() override { head = 0; }
+	long long remainingFrames() override { return length - head; }
+	void prepareForPlayback() override {}
+};
+
 class CalibrationComputerImplTests : public ::testing::Test {
 protected:
 	CalibrationComputerImpl construct(AudioFileReader &r) {
@@ -44,3 +65,38 @@ TEST_F(CalibrationComputerImplTests, outOfRangeChannelReturnsZero) {
 	const auto firstChannel = 0;
 	assertEqual(0.0, computer.signalScale(firstChannel + 1, {}));
 }
+
+TEST_F(CalibrationComputerImplTests, channelsEqualWhenAllChannelsMatch) {
+	FakeAudioFileReader reader{ { 1, 1, 2, 2, 3, 3 } };
+	reader.setChannels(2);
+	auto computer = construct(reader);
+	assertTrue(computer.channelsEqual());
+}
+
+TEST_F(CalibrationComputerImplTests, channelsNotEqualWhenAnySampleDiffers) {
+	FakeAudioFileReader reader{ { 1, 1, 2, 2, 3, 4 } };
+	reader.setChannels(2);
+	auto computer = construct(reader);
+	assertFalse(computer.channelsEqual());
+}
+
+TEST_F(CalibrationComputerImplTests, computesSignalScaleAcrossBlocks) {
+	FakeAudioFileReader reader{ { 1, 2, 3, 4, 5 } };
+	reader.setChannels(1);
+	const auto channelRms = std::sqrt((1*1 + 2*2 + 3*3 + 4*4 + 5*5.0) / 5);
+	CalibrationComputerImpl computer{ *std::make_shared<AudioFileInMemory>(reader), 2 };
+	EXPECT_NEAR(std::pow(10.0, 7/20.0) / channelRms, computer.signalScale(0, 7), 1e-6);
+}
+
+TEST_F(CalibrationComputerImplTests, computesSignalScaleOfLongSignals) {
+	LongReader reader{};
+	CalibrationComputerImpl computer{ reader };
+	EXPECT_NEAR(std::pow(10.0, 7/20.0), computer.signalScale(0, 7), 1e-6);
+}
+
+TEST_F(CalibrationComputerImplTests, channelsNotEqualWhenLaterBlockDiffers) {
+	FakeAudioFileReader reader{ { 1, 1, 2, 2, 3, 4 } };
+	reader.setChannels(2);
+	CalibrationComputerImpl computer{ *std::make_shared<AudioFileInMemory>(reader), 2 };
+	assertFalse(computer.channelsEqual());
+}
@@ -7,12 +7,21 @@
 class CalibrationComputerStub : public CalibrationComputer {
 	ArgumentCollection<double> levels_{};
 	std::map<int, double> signalScales;
+	bool channelsEqual_{};
 public:
 	double signalScale(int channel, double level) override {
 		levels_.push_back(level);
 		return signalScales[channel];
 	}
 
+	bool channelsEqual() override {
+		return channelsEqual_;
+	}
+
+	void setChannelsEqual() noexcept {
+		channelsEqual_ = true;
+	}
+
 	void addSignalScale(int channel, double scale) {
 		signalScales[channel] = scale;
 	}
@@ -25,6 +34,7 @@ public:
 class CalibrationComputerStubFactory : public CalibrationComputerFactory {
 	std::shared_ptr<CalibrationComputer> computer;
 	AudioFrameReader *reader_;
+	int made_{};
 public:
 	explicit CalibrationComputerStubFactory(
 		std::shared_ptr<CalibrationComputer> computer =
@@ -34,9 +44,14 @@ public:
 
 	std::shared_ptr<CalibrationComputer> make(AudioFrameReader *r) override {
 		reader_ = r;
+		++made_;
 		return computer;
 	}
 
+	auto made() const noexcept {
+		return made_;
+	}
+
 	auto reader() const noexcept {
 		return reader_;
 	}
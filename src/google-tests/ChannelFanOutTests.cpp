@@ -0,0 +1,55 @@
+#include "SignalProcessorStub.h"
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/ChannelFanOut.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class ChannelFanOutTests : public ::testing::Test {
+	protected:
+		using channel_type = ChannelFanOut::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+	};
+
+	TEST_F(ChannelFanOutTests, processesFirstChannelOnly) {
+		auto processor = std::make_shared<SignalProcessorStub>();
+		ChannelFanOut fanOut{ processor };
+		buffer_type a{ 1, 2 };
+		buffer_type b{ 3, 4 };
+		std::vector<channel_type> channels{ a, b };
+		fanOut.process(channels);
+		assertEqual({ 1, 2 }, processor->processed());
+	}
+
+	TEST_F(ChannelFanOutTests, copiesProcessedFirstChannelToOthers) {
+		ChannelFanOut fanOut{ std::make_shared<MultipliesSamplesBy>(2.0f) };
+		buffer_type a{ 1, 2 };
+		buffer_type b{ 0, 0 };
+		buffer_type c{ 0, 0 };
+		std::vector<channel_type> channels{ a, b, c };
+		fanOut.process(channels);
+		assertEqual({ 2, 4 }, a);
+		assertEqual({ 2, 4 }, b);
+		assertEqual({ 2, 4 }, c);
+	}
+
+	TEST_F(ChannelFanOutTests, noChannelsDoesNothing) {
+		auto processor = std::make_shared<SignalProcessorStub>();
+		ChannelFanOut fanOut{ processor };
+		fanOut.process({});
+		assertTrue(processor->processed().empty());
+	}
+
+	TEST_F(ChannelFanOutTests, groupDelayReturnsProcessorGroupDelay) {
+		auto processor = std::make_shared<SignalProcessorStub>();
+		processor->setGroupDelay(3);
+		ChannelFanOut fanOut{ processor };
+		assertEqual(channel_type::index_type{ 3 }, fanOut.groupDelay());
+	}
+
+	TEST_F(ChannelFanOutTests, resetResetsProcessor) {
+		auto processor = std::make_shared<SignalProcessorStub>();
+		ChannelFanOut fanOut{ processor };
+		fanOut.reset();
+		assertEqual(1, processor->resets());
+	}
+}
@@ -77,4 +77,12 @@ namespace {
 		assertEqual({ 1 }, processors.at(0)->processed());
 		assertEqual({ 2 }, processors.at(1)->processed());
 	}
+
+	TEST_F(ChannelProcessingGroupTests, resetResetsEachProcessor) {
+		assignStubs(2);
+		auto group = construct();
+		group.reset();
+		assertEqual(1, processors.at(0)->resets());
+		assertEqual(1, processors.at(1)->resets());
+	}
 }
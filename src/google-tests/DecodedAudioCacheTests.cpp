@@ -0,0 +1,188 @@
+#include "FakeAudioFile.h"
+#include "assert-utility.h"
+#include <audio-file-reading-writing/DecodedAudioCache.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class AudioFrameReaderFactoryStub : public AudioFrameReaderFactory {
+		std::string filePath_{};
+	public:
+		std::shared_ptr<AudioFrameReader> make(std::string filePath) override {
+			filePath_ = std::move(filePath);
+			return {};
+		}
+
+		auto filePath() const {
+			return filePath_;
+		}
+	};
+
+	class DecodedAudioCacheTests : public ::testing::Test {
+	protected:
+		AudioFilesFake files{};
+		AudioFrameReaderFactoryStub otherFiles{};
+
+		DecodedAudioCache construct(std::size_t budget, int threads = 2) {
+			return DecodedAudioCache{ 
+				&files, 
+				&otherFiles, 
+				budget, 
+				DecodedAudio::Storage::full, 
+				threads 
+			};
+		}
+
+		std::vector<float> readMono(AudioFrameReader &reader, int frames) {
+			std::vector<float> x(frames);
+			std::vector<AudioFrameReader::channel_type> mono{ x };
+			reader.read(mono);
+			return x;
+		}
+	};
+
+	TEST_F(DecodedAudioCacheTests, makeReadsFile) {
+		files.add("a", { 1, 2, 3 });
+		auto cache = construct(100);
+		auto reader = cache.make("a");
+		assertEqual({ 1, 2, 3 }, readMono(*reader, 3));
+	}
+
+	TEST_F(DecodedAudioCacheTests, makeDecodesFileOnce) {
+		files.add("a", { 1, 2, 3 });
+		auto cache = construct(100);
+		cache.make("a");
+		auto reader = cache.make("a");
+		assertEqual(1, files.opened("a"));
+		assertEqual({ 1, 2, 3 }, readMono(*reader, 3));
+	}
+
+	TEST_F(DecodedAudioCacheTests, readersOfSameFileReadFromTheirOwnPositions) {
+		files.add("a", { 1, 2, 3 });
+		auto cache = construct(100);
+		auto first = cache.make("a");
+		readMono(*first, 2);
+		auto second = cache.make("a");
+		assertEqual({ 1, 2 }, readMono(*second, 2));
+	}
+
+	TEST_F(DecodedAudioCacheTests, makeLetsGoOfLeastRecentlyReadWhenOverBudget) {
+		files.add("a", { 1, 2 });
+		files.add("b", { 3, 4 });
+		files.add("c", { 5, 6 });
+		auto cache = construct(4 * sizeof(float));
+		cache.make("a");
+		cache.make("b");
+		cache.make("a");
+		cache.make("c");
+		assertTrue(cache.contains("a"));
+		assertFalse(cache.contains("b"));
+		assertTrue(cache.contains("c"));
+		assertEqual(4 * sizeof(float), cache.bytes());
+	}
+
+	TEST_F(DecodedAudioCacheTests, readerOutlivesItsFileBeingLetGo) {
+		files.add("a", { 1, 2 });
+		files.add("b", { 3, 4 });
+		auto cache = construct(2 * sizeof(float));
+		auto reader = cache.make("a");
+		cache.make("b");
+		assertFalse(cache.contains("a"));
+		assertEqual({ 1, 2 }, readMono(*reader, 2));
+	}
+
+	TEST_F(DecodedAudioCacheTests, makeLeavesFilesTooLargeForBudgetToOtherFactory) {
+		files.add("a", { 1, 2, 3 });
+		auto cache = construct(2 * sizeof(std::int16_t));
+		cache.make("a");
+		assertEqual("a", otherFiles.filePath());
+		assertFalse(cache.contains("a"));
+	}
+
+	TEST_F(DecodedAudioCacheTests, makeThrowsCreateErrorWhenFileFails) {
+		auto cache = construct(100);
+		try {
+			cache.make("a");
+			FAIL() << "Expected AudioFrameReaderFactory::CreateError.";
+		}
+		catch (const AudioFrameReaderFactory::CreateError &e) {
+			assertEqual(std::string{ "error." }, e.what());
+		}
+	}
+
+	TEST_F(DecodedAudioCacheTests, preloadKeepsEveryFile) {
+		for (int i = 0; i < 20; ++i)
+			files.add(std::to_string(i), { gsl::narrow_cast<float>(i) });
+		auto cache = construct(100, 4);
+		std::vector<std::string> filePaths;
+		for (int i = 0; i < 20; ++i)
+			filePaths.push_back(std::to_string(i));
+		cache.preload(filePaths, {});
+		for (int i = 0; i < 20; ++i) {
+			assertTrue(cache.contains(std::to_string(i)));
+			assertEqual(1, files.opened(std::to_string(i)));
+		}
+		assertEqual({ 7 }, readMono(*cache.make("7"), 1));
+	}
+
+	TEST_F(DecodedAudioCacheTests, preloadReportsProgressUntilAllLoaded) {
+		files.add("a", { 1 });
+		files.add("b", { 2 });
+		files.add("c", { 3 });
+		auto cache = construct(100);
+		std::vector<int> loaded{};
+		std::vector<int> totals{};
+		cache.preload({ "a", "b", "c" }, [&](int n, int total) {
+			loaded.push_back(n);
+			totals.push_back(total);
+		});
+		assertEqual(3, loaded.back());
+		assertTrue(std::is_sorted(loaded.begin(), loaded.end()));
+		for (auto total : totals)
+			assertEqual(3, total);
+	}
+
+	TEST_F(DecodedAudioCacheTests, preloadDoesNotLetGoOfFilesToMakeRoom) {
+		files.add("a", { 1, 2 });
+		files.add("b", { 3, 4 });
+		auto cache = construct(2 * sizeof(float), 1);
+		cache.preload({ "a", "b" }, {});
+		assertTrue(cache.contains("a"));
+		assertFalse(cache.contains("b"));
+	}
+
+	TEST_F(DecodedAudioCacheTests, preloadDoesNotDecodeFilesOnceFull) {
+		files.add("a", { 1, 2 });
+		files.add("b", { 3, 4 });
+		auto cache = construct(2 * sizeof(float), 1);
+		cache.preload({ "a", "b" }, {});
+		assertFalse(files.readFrom("b"));
+	}
+
+	TEST_F(DecodedAudioCacheTests, preloadSkipsFilesThatFail) {
+		files.add("b", { 1 });
+		auto cache = construct(100);
+		int reported{};
+		cache.preload({ "a", "b" }, [&](int n, int) { reported = n; });
+		assertFalse(cache.contains("a"));
+		assertTrue(cache.contains("b"));
+		assertEqual(2, reported);
+	}
+
+	TEST_F(DecodedAudioCacheTests, preloadPassesOnProgressFailureAfterJoiningWorkers) {
+		files.add("a", { 1 });
+		files.add("b", { 2 });
+		auto cache = construct(100);
+		try {
+			cache.preload({ "a", "b" }, [](int, int) { throw std::runtime_error{ "x" }; });
+			FAIL() << "Expected std::runtime_error.";
+		}
+		catch (const std::runtime_error &e) {
+			assertEqual(std::string{ "x" }, e.what());
+		}
+	}
+
+	TEST_F(DecodedAudioCacheTests, preloadOfNothingReturns) {
+		auto cache = construct(100);
+		cache.preload({}, {});
+	}
+}
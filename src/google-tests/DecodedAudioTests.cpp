@@ -0,0 +1,54 @@
+#include "FakeAudioFile.h"
+#include "assert-utility.h"
+#include <audio-file-reading-writing/DecodedAudio.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class DecodedAudioTests : public ::testing::Test {
+	protected:
+		FakeAudioFileReader reader{};
+
+		std::vector<float> copy(const DecodedAudio &audio, int channel, long long frame, int frames) {
+			std::vector<float> x(frames);
+			audio.copy(channel, frame, x);
+			return x;
+		}
+	};
+
+	TEST_F(DecodedAudioTests, copiesChannelFromFrame) {
+		reader.setChannels(2);
+		reader.setContents({ 1, 2, 3, 4, 5, 6 });
+		DecodedAudio audio{ reader };
+		assertEqual({ 3, 5 }, copy(audio, 0, 1, 2));
+		assertEqual({ 2, 4 }, copy(audio, 1, 0, 2));
+	}
+
+	TEST_F(DecodedAudioTests, copiesCompactChannelFromFrame) {
+		reader.setChannels(2);
+		reader.setContents({ 0.5, -0.5, 0.25, -0.25 });
+		DecodedAudio audio{ reader, DecodedAudio::Storage::compact };
+		assertEqual({ -0.25 }, copy(audio, 1, 1, 1));
+	}
+
+	TEST_F(DecodedAudioTests, returnsFileParameters) {
+		reader.setSampleRate(2);
+		reader.setChannels(3);
+		reader.setContents({ 1, 2, 3, 4, 5, 6 });
+		DecodedAudio audio{ reader };
+		assertEqual(2LL, audio.frames());
+		assertEqual(3, audio.channels());
+		assertEqual(2, audio.sampleRate());
+	}
+
+	TEST_F(DecodedAudioTests, failedReaderThrowsFileError) {
+		reader.fail();
+		reader.setErrorMessage("error.");
+		try {
+			DecodedAudio{ reader };
+			FAIL() << "Expected DecodedAudio::FileError.";
+		}
+		catch (const DecodedAudio::FileError &e) {
+			assertEqual(std::string{ "error." }, e.what());
+		}
+	}
+}
@@ -2,13 +2,17 @@
 
 #include <audio-file-reading-writing/AudioFile.h>
 #include <gsl/gsl>
+#include <map>
+#include <mutex>
 #include <vector>
 
 class FakeAudioFileReader : public AudioFileReader {
 	std::vector<float> contents;
 	std::string errorMessage_{};
+	std::vector<float>::size_type head{};
 	int channels_{ 1 };
 	int sampleRate_{};
+	int seeks_{};
 	bool failed_{};
 public:
 	explicit FakeAudioFileReader(
@@ -18,6 +22,7 @@ public:
 
 	void setContents(std::vector<float> c) {
 		contents = std::move(c);
+		head = 0;
 	}
 
 	void setChannels(int c) noexcept {
@@ -34,7 +39,22 @@ public:
 
 	void readFrames(float *x, long long n) override {
 		const gsl::span<float> audio{ x, gsl::narrow<gsl::span<float>::index_type>(n * channels_) };
-		std::copy(contents.begin(), contents.end(), audio.begin());
+		const auto samples = std::min(contents.size() - head, gsl::narrow<std::vector<float>::size_type>(audio.size()));
+		std::copy_n(contents.begin() + head, samples, audio.begin());
+		head += samples;
+	}
+
+	void seek(long long frame) override {
+		head = gsl::narrow<std::vector<float>::size_type>(frame * channels_);
+		++seeks_;
+	}
+
+	int seeks() const noexcept {
+		return seeks_;
+	}
+
+	bool readFrom() const noexcept {
+		return head != 0;
 	}
 
 	void fail() noexcept {
@@ -141,3 +161,63 @@ public:
         return formatForWriting_;
     }
 };
+
+// Makes a new reader of each file added, in any number of threads.
+class AudioFilesFake : public AudioFileFactory {
+	struct File {
+		std::vector<float> contents;
+		int channels;
+		int sampleRate;
+	};
+	std::map<std::string, File> files{};
+	std::map<std::string, int> opened_{};
+	std::map<std::string, std::vector<std::shared_ptr<FakeAudioFileReader>>> readers{};
+	std::mutex mutex{};
+public:
+	void add(
+		std::string filePath, 
+		std::vector<float> x, 
+		int channels = 1, 
+		int sampleRate = 0
+	) {
+		files[std::move(filePath)] = { std::move(x), channels, sampleRate };
+	}
+
+	std::shared_ptr<AudioFileReader> makeReader(std::string filePath) override {
+		std::lock_guard<std::mutex> lock{ mutex };
+		++opened_[filePath];
+		auto reader = std::make_shared<FakeAudioFileReader>();
+		const auto found = files.find(filePath);
+		if (found == files.end()) {
+			reader->fail();
+			reader->setErrorMessage("error.");
+		}
+		else {
+			reader->setContents(found->second.contents);
+			reader->setChannels(found->second.channels);
+			reader->setSampleRate(found->second.sampleRate);
+		}
+		readers[filePath].push_back(reader);
+		return reader;
+	}
+
+	std::shared_ptr<AudioFileWriter> makeWriter(
+		std::string,
+		const AudioFileWriter::AudioFileFormat &
+	) override {
+		return {};
+	}
+
+	int opened(const std::string &filePath) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		return opened_[filePath];
+	}
+
+	bool readFrom(const std::string &filePath) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		for (const auto &reader : readers[filePath])
+			if (reader->readFrom())
+				return true;
+		return false;
+	}
+};
@@ -8,6 +8,7 @@ class FakeConfigurationFileParser : public ConfigurationFileParser {
 	std::map<std::string, std::vector<double>> vectors{};
 	std::map<std::string, double> doubles{};
 	std::map<std::string, int> ints{};
+	std::map<std::string, std::string> strings{};
 public:
 	void setValidSingleChannelDslProperties() {
 		using namespace dsl_prescription;
@@ -30,6 +31,10 @@ public:
 		ints[std::move(property)] = x;
 	}
 
+	void setStringProperty(std::string property, std::string x) {
+		strings[std::move(property)] = std::move(x);
+	}
+
 	std::vector<double> asVector(std::string property) override {
 		return vectors.at(std::move(property));
 	}
@@ -41,6 +46,10 @@ public:
 	int asInt(std::string property) override {
 		return ints.at(std::move(property));
 	}
+
+	std::string asString(std::string property) override {
+		return strings.at(std::move(property));
+	}
 };
 
 class FakeConfigurationFileParserFactory : public ConfigurationFileParserFactory {
@@ -84,4 +93,8 @@ public:
 	std::vector<double> asVector(std::string) override {
 		throw ParseError{ message };
 	}
+
+	std::string asString(std::string) override {
+		throw ParseError{ message };
+	}
 };
\ No newline at end of file
@@ -32,6 +32,10 @@ public:
 	bool empty() override {
 		return contents_.empty();
 	}
+
+	std::vector<std::string> remaining() override {
+		return contents_;
+	}
 };
 
 class FailsToInitializeStimulusList : public StimulusList {
@@ -48,4 +52,6 @@ public:
 	std::string next() override { return {}; }
 
 	bool empty() override { return {}; }
+
+	std::vector<std::string> remaining() override { return {}; }
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <audio-file-reading-writing/FileMapping.h>
+#include <map>
+#include <utility>
+#include <vector>
+
+class FileMappingStub : public FileMapping {
+	std::vector<unsigned char> bytes_;
+	std::vector<std::pair<long long, long long>> prefaulted_{};
+public:
+	explicit FileMappingStub(std::vector<unsigned char> bytes) :
+		bytes_{ std::move(bytes) } {}
+
+	gsl::span<const unsigned char> bytes() override {
+		return bytes_;
+	}
+
+	void prefault(long long offset, long long size) override {
+		prefaulted_.push_back({ offset, size });
+	}
+
+	auto prefaulted() const {
+		return prefaulted_;
+	}
+};
+
+// Maps files added by path; any other path maps to the bytes set, unless
+// failing.
+class FileMapperStub : public FileMapper {
+	std::map<std::string, std::vector<unsigned char>> files{};
+	std::vector<unsigned char> bytes_{};
+	std::string filePath_{};
+	int mapped_{};
+	bool failing_{};
+public:
+	void setBytes(std::vector<unsigned char> b) {
+		bytes_ = std::move(b);
+	}
+
+	void add(std::string filePath, std::vector<unsigned char> b) {
+		files[std::move(filePath)] = std::move(b);
+	}
+
+	void fail() noexcept {
+		failing_ = true;
+	}
+
+	std::shared_ptr<FileMapping> map(std::string filePath) override {
+		filePath_ = std::move(filePath);
+		++mapped_;
+		const auto found = files.find(filePath_);
+		if (found != files.end())
+			return std::make_shared<FileMappingStub>(found->second);
+		if (failing_)
+			throw MapFailure{ "error." };
+		return std::make_shared<FileMappingStub>(bytes_);
+	}
+
+	auto filePath() const {
+		return filePath_;
+	}
+
+	int mapped() const noexcept {
+		return mapped_;
+	}
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/FileVersions.h>
+#include <map>
+
+class FileVersionsStub : public FileVersions {
+	std::map<std::string, std::string> versions{};
+public:
+	void setVersion(std::string filePath, std::string v) {
+		versions[std::move(filePath)] = std::move(v);
+	}
+
+	std::string version(const std::string &filePath) override {
+		const auto found = versions.find(filePath);
+		return found == versions.end() ? std::string{} : found->second;
+	}
+};
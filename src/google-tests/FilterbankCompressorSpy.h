@@ -91,6 +91,10 @@ public:
 	int windowSize() override {
 		return windowSize_;
 	}
+
+	void reset() override {
+		processingLog_.insert("reset");
+	}
 };
 
 class FilterbankCompressorSpyFactory : public FilterbankCompressorFactory {
@@ -1,6 +1,7 @@
 #include "assert-utility.h"
 #include <fir-filtering/FirFilter.h>
 #include <gtest/gtest.h>
+#include <memory_resource>
 
 namespace {
 	template<typename T>
@@ -17,6 +18,10 @@ namespace {
 			filter_.process(x);
 			return x;
 		}
+
+		void reset() {
+			filter_.reset();
+		}
 	};
 
 	class FirFilterTests : public ::testing::Test {
@@ -226,6 +231,21 @@ namespace {
 		}
 	};
 
+	TEST_F(FirFilterTests, resetClearsPreviousInput) {
+		FirFilterFacade<float> facade{ { 1, 1 } };
+		facade.filter({ 1, 2, 3 });
+		facade.reset();
+		assertEqual({ 4, 9 }, facade.filter({ 4, 5 }), 1e-5f);
+	}
+
+	TEST_F(FirFilterTests, filtersWithBuffersFromGivenAllocator) {
+		std::pmr::monotonic_buffer_resource resource{};
+		FirFilter<float> filter{ { 2 }, FirFilter<float>::allocator_type{ &resource } };
+		std::vector<float> x{ 1, 2, 3 };
+		filter.process(x);
+		assertEqual({ 2, 4, 6 }, x, 1e-5f);
+	}
+
 	TEST_F(FirFilterTests, constructorWithEmptyCoefficientsThrowsException) {
 		assertConstructorWithEmptyCoefficientsThrowsException<float>();
 		assertConstructorWithEmptyCoefficientsThrowsException<double>();
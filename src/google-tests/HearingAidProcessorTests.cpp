@@ -79,6 +79,11 @@ namespace {
 		assertEqual(index_type{ 256 }, processor.groupDelay());
 	}
 
+	TEST_F(HearingAidProcessorTests, resetResetsCompressor) {
+		processor.reset();
+		assertEqual("reset", compressor->processingLog());
+	}
+
 	class CompressorErrorTests : public ::testing::Test {
 	protected:
 		std::shared_ptr<FilterbankCompressorSpy> compressor =
@@ -144,6 +149,7 @@ namespace {
 		int channels() override { return 1; }
 		int windowSize() override { return 1; }
 		void compressChannels(complex_type *, complex_type *, int) override {}
+		void reset() override {}
 	};
 
 	TEST(
@@ -205,6 +211,7 @@ namespace {
 		int windowSize() override { return 1; }
 		void compressInput(real_type *, real_type *, int) override {}
 		void compressOutput(real_type *, real_type *, int) override {}
+		void reset() override {}
 	};
 
 	class HearingAidProcessorComplexSignalTests : public ::testing::Test {
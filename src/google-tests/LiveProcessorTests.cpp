@@ -0,0 +1,137 @@
+#include "assert-utility.h"
+#include "AudioFrameProcessorStub.h"
+#include <spatialized-hearing-aid-simulation/LiveProcessor.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class LiveProcessorTests : public ::testing::Test {
+	protected:
+		using channel_type = AudioFrameProcessor::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+		std::shared_ptr<AudioFrameProcessorStub> processor =
+			std::make_shared<AudioFrameProcessorStub>();
+		std::shared_ptr<LiveProcessor> live =
+			std::make_shared<LiveProcessor>(processor, 4, 2);
+
+		buffer_type processOnes(int frames) {
+			buffer_type x(frames, 1);
+			std::vector<channel_type> mono{ x };
+			live->process(mono);
+			return x;
+		}
+	};
+
+	TEST_F(LiveProcessorTests, processesWithProcessor) {
+		buffer_type x(3);
+		std::vector<channel_type> mono{ x };
+		live->process(mono);
+		assertEqual(x.data(), processor->audioBuffer().begin()->data());
+	}
+
+	TEST_F(LiveProcessorTests, leavesAudioUnscaledByDefault) {
+		assertEqual({ 1, 1, 1 }, processOnes(3));
+	}
+
+	TEST_F(LiveProcessorTests, rampsToGainFromNextBlock) {
+		live->setGain(0.5);
+		assertEqual({ 0.875, 0.75, 0.625, 0.5, 0.5, 0.5 }, processOnes(6));
+	}
+
+	TEST_F(LiveProcessorTests, rampContinuesAcrossBlocks) {
+		live->setGain(0.5);
+		processOnes(2);
+		assertEqual({ 0.625, 0.5, 0.5 }, processOnes(3));
+	}
+
+	TEST_F(LiveProcessorTests, rampsFromCurrentGain) {
+		live->setGain(0.5);
+		processOnes(4);
+		live->setGain(1);
+		assertEqual({ 0.625, 0.75, 0.875, 1, 1 }, processOnes(5));
+	}
+
+	TEST_F(LiveProcessorTests, replacementFadesOutCurrentProcessorFirst) {
+		live->replace(std::make_shared<AudioFrameProcessorStub>());
+		assertEqual({ 0.75, 0.5, 0.25, 0, 0 }, processOnes(5));
+	}
+
+	TEST_F(LiveProcessorTests, replacementProcessesFromBlockAfterFadeOut) {
+		auto replacement = std::make_shared<AudioFrameProcessorStub>();
+		live->replace(replacement);
+		processOnes(4);
+		assertTrue(replacement->audioBuffer().empty());
+		buffer_type x(3);
+		std::vector<channel_type> mono{ x };
+		live->process(mono);
+		assertEqual(x.data(), replacement->audioBuffer().begin()->data());
+	}
+
+	TEST_F(LiveProcessorTests, replacementFadesIn) {
+		live->replace(std::make_shared<AudioFrameProcessorStub>());
+		processOnes(4);
+		assertEqual({ 0.25, 0.5, 0.75, 1, 1 }, processOnes(5));
+	}
+
+	TEST_F(LiveProcessorTests, replacementFadesInToGainSetDuringFadeOut) {
+		live->replace(std::make_shared<AudioFrameProcessorStub>());
+		live->setGain(0.5);
+		assertEqual({ 0.75, 0.5, 0.25, 0 }, processOnes(4));
+		assertEqual({ 0.125, 0.25, 0.375, 0.5 }, processOnes(4));
+	}
+
+	TEST_F(LiveProcessorTests, secondReplacementDuringFadeOutTakesOver) {
+		auto first = std::make_shared<AudioFrameProcessorStub>();
+		auto second = std::make_shared<AudioFrameProcessorStub>();
+		live->replace(first);
+		processOnes(2);
+		live->replace(second);
+		processOnes(2);
+		processOnes(1);
+		assertTrue(first->audioBuffer().empty());
+		assertFalse(second->audioBuffer().empty());
+	}
+
+	TEST_F(LiveProcessorTests, groupDelayIsCurrentProcessors) {
+		processor->setGroupDelay(1);
+		auto replacement = std::make_shared<AudioFrameProcessorStub>();
+		replacement->setGroupDelay(2);
+		live->replace(replacement);
+		processOnes(4);
+		assertEqual(1, gsl::narrow<int>(live->groupDelay()));
+		processOnes(1);
+		assertEqual(2, gsl::narrow<int>(live->groupDelay()));
+	}
+
+	TEST_F(LiveProcessorTests, replacedProcessorReleasedOnlyWhenReclaimed) {
+		std::weak_ptr<AudioFrameProcessor> replaced = processor;
+		processor.reset();
+		live->replace(std::make_shared<AudioFrameProcessorStub>());
+		processOnes(4);
+		processOnes(1);
+		assertFalse(replaced.expired());
+		live->reclaim();
+		assertTrue(replaced.expired());
+	}
+
+	TEST_F(LiveProcessorTests, replaceFailsUntilReplacedProcessorsReclaimed) {
+		assertTrue(live->replace(std::make_shared<AudioFrameProcessorStub>()));
+		assertTrue(live->replace(std::make_shared<AudioFrameProcessorStub>()));
+		processOnes(1);
+		assertFalse(live->replace(std::make_shared<AudioFrameProcessorStub>()));
+		live->reclaim();
+		assertTrue(live->replace(std::make_shared<AudioFrameProcessorStub>()));
+	}
+
+	TEST_F(LiveProcessorTests, setGainFailsWhenCommandsFull) {
+		assertTrue(live->setGain(0.5));
+		assertTrue(live->setGain(0.5));
+		assertFalse(live->setGain(0.5));
+		processOnes(1);
+		assertTrue(live->setGain(0.5));
+	}
+
+	TEST_F(LiveProcessorTests, resetResetsCurrentProcessor) {
+		live->reset();
+		assertEqual(1, processor->resets());
+	}
+}
@@ -0,0 +1,286 @@
+#include "FileMappingStub.h"
+#include "assert-utility.h"
+#include <audio-file-reading-writing/MappedWavFile.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+	class AudioFrameReaderFactoryStub : public AudioFrameReaderFactory {
+		std::string filePath_{};
+	public:
+		std::shared_ptr<AudioFrameReader> make(std::string filePath) override {
+			filePath_ = std::move(filePath);
+			return {};
+		}
+
+		auto filePath() const {
+			return filePath_;
+		}
+	};
+
+	class WavBuilder {
+		std::vector<unsigned char> chunks{};
+	public:
+		void add16(std::vector<unsigned char> &x, unsigned v) {
+			x.push_back(gsl::narrow_cast<unsigned char>(v & 0xFF));
+			x.push_back(gsl::narrow_cast<unsigned char>(v >> 8 & 0xFF));
+		}
+
+		void add32(std::vector<unsigned char> &x, std::uint32_t v) {
+			add16(x, v & 0xFFFF);
+			add16(x, v >> 16);
+		}
+
+		void addChunk(std::string id, std::vector<unsigned char> body) {
+			chunks.insert(chunks.end(), id.begin(), id.end());
+			add32(chunks, gsl::narrow<std::uint32_t>(body.size()));
+			chunks.insert(chunks.end(), body.begin(), body.end());
+			if (body.size() % 2)
+				chunks.push_back(0);
+		}
+
+		void addFormat(unsigned tag, int channels, int bits, int sampleRate = 44100) {
+			std::vector<unsigned char> body;
+			add16(body, tag);
+			add16(body, gsl::narrow<unsigned>(channels));
+			add32(body, gsl::narrow<std::uint32_t>(sampleRate));
+			add32(body, gsl::narrow<std::uint32_t>(sampleRate * channels * bits / 8));
+			add16(body, gsl::narrow<unsigned>(channels * bits / 8));
+			add16(body, gsl::narrow<unsigned>(bits));
+			addChunk("fmt ", body);
+		}
+
+		void addExtensibleFormat(unsigned subformat, int channels, int bits) {
+			std::vector<unsigned char> body;
+			add16(body, 0xFFFE);
+			add16(body, gsl::narrow<unsigned>(channels));
+			add32(body, 44100);
+			add32(body, gsl::narrow<std::uint32_t>(44100 * channels * bits / 8));
+			add16(body, gsl::narrow<unsigned>(channels * bits / 8));
+			add16(body, gsl::narrow<unsigned>(bits));
+			add16(body, 22);
+			add16(body, gsl::narrow<unsigned>(bits));
+			add32(body, 0);
+			add16(body, subformat);
+			body.resize(40);
+			addChunk("fmt ", body);
+		}
+
+		void addData(std::vector<unsigned char> body) {
+			addChunk("data", std::move(body));
+		}
+
+		void addFloats(std::vector<float> x) {
+			std::vector<unsigned char> body(x.size() * sizeof(float));
+			std::memcpy(body.data(), x.data(), body.size());
+			addData(std::move(body));
+		}
+
+		void addShorts(std::vector<std::int16_t> x) {
+			std::vector<unsigned char> body;
+			for (auto v : x)
+				add16(body, static_cast<std::uint16_t>(v));
+			addData(std::move(body));
+		}
+
+		std::vector<unsigned char> bytes() {
+			std::vector<unsigned char> x{ 'R', 'I', 'F', 'F' };
+			add32(x, gsl::narrow<std::uint32_t>(4 + chunks.size()));
+			x.insert(x.end(), { 'W', 'A', 'V', 'E' });
+			x.insert(x.end(), chunks.begin(), chunks.end());
+			return x;
+		}
+	};
+
+	class MappedWavFileTests : public ::testing::Test {
+	protected:
+		using channel_type = AudioFrameReader::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+		WavBuilder wav{};
+
+		MappedWavFile construct() {
+			return MappedWavFile{ std::make_shared<FileMappingStub>(wav.bytes()) };
+		}
+
+		buffer_type readMono(AudioFrameReader &reader, int frames) {
+			buffer_type x(frames);
+			std::vector<channel_type> mono{ x };
+			reader.read(mono);
+			return x;
+		}
+
+		void assertConstructionThrowsFormatError() {
+			try {
+				construct();
+				FAIL() << "Expected MappedWavFile::FormatError.";
+			}
+			catch (const MappedWavFile::FormatError &) {
+			}
+		}
+	};
+
+	constexpr unsigned pcm = 1;
+	constexpr unsigned ieeeFloat = 3;
+
+	TEST_F(MappedWavFileTests, readsFloatFramesIntoChannels) {
+		wav.addFormat(ieeeFloat, 2, 32);
+		wav.addFloats({ 1, 2, 3, 4, 5, 6 });
+		auto reader = construct();
+		buffer_type left(3);
+		buffer_type right(3);
+		std::vector<channel_type> stereo{ left, right };
+		reader.read(stereo);
+		assertEqual({ 1, 3, 5 }, left);
+		assertEqual({ 2, 4, 6 }, right);
+	}
+
+	TEST_F(MappedWavFileTests, scales16BitPcmToFullScale) {
+		wav.addFormat(pcm, 1, 16);
+		wav.addShorts({ -32768, 0, 16384 });
+		auto reader = construct();
+		assertEqual({ -1, 0, 0.5 }, readMono(reader, 3));
+	}
+
+	TEST_F(MappedWavFileTests, scales24BitPcmToFullScale) {
+		wav.addFormat(pcm, 1, 24);
+		wav.addData({ 0x00, 0x00, 0x80, 0x00, 0x00, 0x40 });
+		auto reader = construct();
+		assertEqual({ -1, 0.5 }, readMono(reader, 2));
+	}
+
+	TEST_F(MappedWavFileTests, scales32BitPcmToFullScale) {
+		wav.addFormat(pcm, 1, 32);
+		wav.addData({ 0x00, 0x00, 0x00, 0xC0 });
+		auto reader = construct();
+		assertEqual({ -0.5 }, readMono(reader, 1));
+	}
+
+	TEST_F(MappedWavFileTests, readsExtensibleFormat) {
+		wav.addExtensibleFormat(ieeeFloat, 1, 32);
+		wav.addFloats({ 1, 2 });
+		auto reader = construct();
+		assertEqual({ 1, 2 }, readMono(reader, 2));
+	}
+
+	TEST_F(MappedWavFileTests, skipsOtherChunksAndTheirPadding) {
+		wav.addChunk("LIST", { 1, 2, 3 });
+		wav.addFormat(ieeeFloat, 1, 32);
+		wav.addChunk("fact", { 4 });
+		wav.addFloats({ 7 });
+		auto reader = construct();
+		assertEqual({ 7 }, readMono(reader, 1));
+	}
+
+	TEST_F(MappedWavFileTests, continuesFromLastRead) {
+		wav.addFormat(ieeeFloat, 1, 32);
+		wav.addFloats({ 1, 2, 3, 4 });
+		auto reader = construct();
+		readMono(reader, 1);
+		assertEqual({ 2, 3, 4, 0 }, readMono(reader, 4));
+		assertTrue(reader.complete());
+	}
+
+	TEST_F(MappedWavFileTests, resetReadsFromBeginning) {
+		wav.addFormat(ieeeFloat, 1, 32);
+		wav.addFloats({ 1, 2, 3 });
+		auto reader = construct();
+		readMono(reader, 2);
+		reader.reset();
+		assertEqual(3LL, reader.remainingFrames());
+		assertEqual({ 1, 2, 3 }, readMono(reader, 3));
+	}
+
+	TEST_F(MappedWavFileTests, passesFormat) {
+		wav.addFormat(pcm, 2, 16, 48000);
+		wav.addShorts({ 1, 2, 3, 4, 5, 6 });
+		auto reader = construct();
+		assertEqual(2, reader.channels());
+		assertEqual(48000, reader.sampleRate());
+		assertEqual(3LL, reader.frames());
+	}
+
+	TEST_F(MappedWavFileTests, truncatedDataReadsWholeFramesOnly) {
+		WavBuilder truncated{};
+		truncated.addFormat(pcm, 1, 16);
+		truncated.addShorts({ 1, 2, 3 });
+		auto x = truncated.bytes();
+		x.resize(x.size() - 1);
+		MappedWavFile reader{ std::make_shared<FileMappingStub>(x) };
+		assertEqual(2LL, reader.frames());
+	}
+
+	TEST_F(MappedWavFileTests, prepareForPlaybackPrefaultsRemainingFrames) {
+		wav.addFormat(ieeeFloat, 2, 32);
+		wav.addFloats({ 1, 2, 3, 4, 5, 6 });
+		auto mapping = std::make_shared<FileMappingStub>(wav.bytes());
+		MappedWavFile reader{ mapping };
+		buffer_type left(1);
+		buffer_type right(1);
+		std::vector<channel_type> stereo{ left, right };
+		reader.read(stereo);
+		reader.prepareForPlayback();
+		const auto dataOffset = 12 + 8 + 16 + 8;
+		EXPECT_EQ(
+			(std::vector<std::pair<long long, long long>>{ { dataOffset + 8, 16 } }),
+			mapping->prefaulted()
+		);
+	}
+
+	TEST_F(MappedWavFileTests, notRiffThrowsFormatError) {
+		try {
+			MappedWavFile{ std::make_shared<FileMappingStub>(std::vector<unsigned char>{ 'O', 'g', 'g', 'S' }) };
+			FAIL() << "Expected MappedWavFile::FormatError.";
+		}
+		catch (const MappedWavFile::FormatError &) {
+		}
+	}
+
+	TEST_F(MappedWavFileTests, unsupportedEncodingThrowsFormatError) {
+		wav.addFormat(pcm, 1, 8);
+		wav.addData({ 1, 2 });
+		assertConstructionThrowsFormatError();
+	}
+
+	TEST_F(MappedWavFileTests, missingDataThrowsFormatError) {
+		wav.addFormat(pcm, 1, 16);
+		assertConstructionThrowsFormatError();
+	}
+
+	TEST_F(MappedWavFileTests, dataBeforeFormatThrowsFormatError) {
+		wav.addShorts({ 1 });
+		wav.addFormat(pcm, 1, 16);
+		assertConstructionThrowsFormatError();
+	}
+
+	TEST_F(MappedWavFileTests, factoryMapsWavFiles) {
+		wav.addFormat(ieeeFloat, 1, 32);
+		wav.addFloats({ 1, 2 });
+		FileMapperStub mapper{};
+		mapper.setBytes(wav.bytes());
+		AudioFrameReaderFactoryStub otherFiles{};
+		MappedWavFileFactory factory{ &mapper, &otherFiles };
+		auto reader = factory.make("a");
+		assertEqual("a", mapper.filePath());
+		assertEqual({ 1, 2 }, readMono(*reader, 2));
+		assertTrue(otherFiles.filePath().empty());
+	}
+
+	TEST_F(MappedWavFileTests, factoryPassesOtherFormatsOn) {
+		FileMapperStub mapper{};
+		mapper.setBytes({ 'O', 'g', 'g', 'S' });
+		AudioFrameReaderFactoryStub otherFiles{};
+		MappedWavFileFactory factory{ &mapper, &otherFiles };
+		factory.make("a");
+		assertEqual("a", otherFiles.filePath());
+	}
+
+	TEST_F(MappedWavFileTests, factoryPassesUnmappableFilesOn) {
+		FileMapperStub mapper{};
+		mapper.fail();
+		AudioFrameReaderFactoryStub otherFiles{};
+		MappedWavFileFactory factory{ &mapper, &otherFiles };
+		factory.make("a");
+		assertEqual("a", otherFiles.filePath());
+	}
+}
@@ -11,6 +11,7 @@ class ModelStub : public Model {
 	Trial trialParameters_{};
 	Calibration calibrationParameters_{};
 	SavingAudio saveAudioParameters_{};
+	ParameterSweeping sweepingParameters_{};
 	double calibrationLevel_dB_Spl_{};
 	bool testComplete_{};
 	bool trialPlayed_{};
@@ -18,6 +19,7 @@ class ModelStub : public Model {
 	bool calibrationPlayed_{};
 	bool testPrepared_{};
 	bool audioSaved_{};
+	bool parametersSwept_{};
 public:
 	auto &saveAudioLog() const noexcept {
 		return saveAudioLog_;
@@ -42,6 +44,19 @@ public:
 		saveAudioLog_.insert("saveAudio ");
 	}
 
+	void sweepParameters(const ParameterSweeping &p) override {
+		sweepingParameters_ = p;
+		parametersSwept_ = true;
+	}
+
+	auto &parameterSweeping() const noexcept {
+		return sweepingParameters_;
+	}
+
+	auto parametersSwept() const noexcept {
+		return parametersSwept_;
+	}
+
 	auto audioSaved() noexcept {
 		return audioSaved_;
 	}
@@ -142,4 +157,8 @@ public:
 	std::vector<std::string> audioDeviceDescriptions() override { return {}; }
 	void processAudioForSaving(const SavingAudio &) override {}
 	void saveAudio(std::string) override {}
+
+	void sweepParameters(const ParameterSweeping &) override {
+		throw RequestFailure{ message };
+	}
 };
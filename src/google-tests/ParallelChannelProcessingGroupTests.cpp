@@ -0,0 +1,129 @@
+#include "SignalProcessorStub.h"
+#include "RealTimeSetupStub.h"
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/ParallelChannelProcessingGroup.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class ParallelChannelProcessingGroupTests : public ::testing::Test {
+	protected:
+		using channel_type = ParallelChannelProcessingGroup::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+		std::vector<std::shared_ptr<SignalProcessorStub>> processors{};
+		std::vector<channel_type> channels{};
+
+		std::unique_ptr<ParallelChannelProcessingGroup> construct() {
+			return std::make_unique<ParallelChannelProcessingGroup>(
+				ParallelChannelProcessingGroup::processing_group_type{ 
+					processors.begin(), 
+					processors.end() 
+				}
+			);
+		}
+
+		void assignStubs(int n) {
+			processors.clear();
+			for (int i = 0; i < n; ++i)
+				processors.push_back(std::make_shared<SignalProcessorStub>());
+		}
+	};
+
+	TEST_F(ParallelChannelProcessingGroupTests, processesChannelsInOrder) {
+		assignStubs(3);
+		auto group = construct();
+		buffer_type a{ 1 };
+		buffer_type b{ 2, 3 };
+		buffer_type c{ 4, 5, 6 };
+		channels = { a, b, c };
+		group->process(channels);
+		assertEqual({ 1 }, processors.at(0)->processed());
+		assertEqual({ 2, 3 }, processors.at(1)->processed());
+		assertEqual({ 4, 5, 6 }, processors.at(2)->processed());
+	}
+
+	TEST_F(ParallelChannelProcessingGroupTests, processesEveryBlockBeforeReturning) {
+		assignStubs(2);
+		auto group = construct();
+		for (int i = 0; i < 100; ++i) {
+			buffer_type a{ float(i) };
+			buffer_type b{ float(-i) };
+			channels = { a, b };
+			group->process(channels);
+			assertEqual(i + 1, gsl::narrow<int>(processors.at(1)->processed().size()));
+		}
+		assertEqual(-99.0f, processors.at(1)->processed().back());
+	}
+
+	TEST_F(ParallelChannelProcessingGroupTests, processModifiesChannelsInPlace) {
+		auto first = std::make_shared<AddsSamplesBy>(1.0f);
+		auto second = std::make_shared<MultipliesSamplesBy>(2.0f);
+		ParallelChannelProcessingGroup group{ { first, second } };
+		buffer_type a{ 1, 2 };
+		buffer_type b{ 3, 4 };
+		channels = { a, b };
+		group.process(channels);
+		assertEqual({ 2, 3 }, a);
+		assertEqual({ 6, 8 }, b);
+	}
+
+	TEST_F(ParallelChannelProcessingGroupTests, groupDelayReturnsMaxGroupDelay) {
+		assignStubs(3);
+		processors.at(0)->setGroupDelay(1);
+		processors.at(1)->setGroupDelay(2);
+		processors.at(2)->setGroupDelay(3);
+		auto group = construct();
+		assertEqual(channel_type::index_type{ 3 }, group->groupDelay());
+	}
+
+	TEST_F(ParallelChannelProcessingGroupTests, groupDelayReturnsZeroWhenNoProcessors) {
+		auto group = construct();
+		assertEqual(channel_type::index_type{ 0 }, group->groupDelay());
+	}
+
+	TEST_F(ParallelChannelProcessingGroupTests, processIgnoresExtraChannels) {
+		assignStubs(2);
+		auto group = construct();
+		buffer_type a{ 1 };
+		buffer_type b{ 2 };
+		buffer_type c{ 3 };
+		channels = { a, b, c };
+		group->process(channels);
+		assertEqual({ 1 }, processors.at(0)->processed());
+		assertEqual({ 2 }, processors.at(1)->processed());
+	}
+
+	TEST_F(ParallelChannelProcessingGroupTests, processOnlyChannelsAvailable) {
+		assignStubs(3);
+		auto group = construct();
+		buffer_type a{ 1 };
+		buffer_type b{ 2 };
+		channels = { a, b };
+		group->process(channels);
+		assertEqual({ 1 }, processors.at(0)->processed());
+		assertEqual({ 2 }, processors.at(1)->processed());
+		assertTrue(processors.at(2)->processed().empty());
+	}
+
+	TEST_F(ParallelChannelProcessingGroupTests, resetResetsEachProcessor) {
+		assignStubs(2);
+		auto group = construct();
+		group->reset();
+		assertEqual(1, processors.at(0)->resets());
+		assertEqual(1, processors.at(1)->resets());
+	}
+
+	TEST_F(ParallelChannelProcessingGroupTests, workersConfiguredWithRealTimeSetup) {
+		assignStubs(3);
+		RealTimeSetupStub realTime{};
+		ParallelChannelProcessingGroup group{
+			{ processors.begin(), processors.end() },
+			&realTime
+		};
+		buffer_type a{ 1 };
+		buffer_type b{ 2 };
+		buffer_type c{ 3 };
+		channels = { a, b, c };
+		group.process(channels);
+		assertEqual(2, realTime.threadsConfigured());
+	}
+}
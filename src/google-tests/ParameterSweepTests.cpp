@@ -0,0 +1,529 @@
+#include "AudioFrameReaderStub.h"
+#include "AudioFrameWriterStub.h"
+#include "BrirReaderStub.h"
+#include "PrescriptionReaderStub.h"
+#include "CalibrationComputerStub.h"
+#include "SignalStoreStub.h"
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/ParameterSweep.h>
+#include <gtest/gtest.h>
+#include <map>
+
+namespace {
+	class InMemoryReader : public AudioFrameReader {
+		std::vector<std::vector<float>> contents;
+		int sampleRate_;
+	public:
+		InMemoryReader(std::vector<std::vector<float>> contents, int sampleRate) :
+			contents{ std::move(contents) },
+			sampleRate_{ sampleRate } {}
+
+		void read(gsl::span<channel_type> audio) override {
+			for (std::size_t i = 0; i < contents.size(); ++i)
+				std::copy(contents.at(i).begin(), contents.at(i).end(), audio.at(i).begin());
+		}
+
+		bool complete() override { return true; }
+		int sampleRate() override { return sampleRate_; }
+		int channels() override { return gsl::narrow<int>(contents.size()); }
+		long long frames() override { return contents.front().size(); }
+		void reset() override {}
+		long long remainingFrames() override { return 0; }
+		void prepareForPlayback() override {}
+	};
+
+	class InMemoryReaderFactory : public AudioFrameReaderFactory {
+		std::vector<std::vector<float>> contents;
+		int sampleRate;
+		int made_{};
+	public:
+		InMemoryReaderFactory(std::vector<std::vector<float>> contents, int sampleRate) :
+			contents{ std::move(contents) },
+			sampleRate{ sampleRate } {}
+
+		std::shared_ptr<AudioFrameReader> make(std::string) override {
+			++made_;
+			return std::make_shared<InMemoryReader>(contents, sampleRate);
+		}
+
+		auto made() const noexcept {
+			return made_;
+		}
+	};
+
+	class RecordingWriter : public AudioFrameWriter {
+		std::vector<std::vector<float>> &written;
+	public:
+		explicit RecordingWriter(std::vector<std::vector<float>> &written) :
+			written{ written } {}
+
+		void write(gsl::span<channel_type> audio) override {
+			for (auto channel : audio)
+				written.push_back({ channel.begin(), channel.end() });
+		}
+	};
+
+	class RecordingWriterFactory : public AudioFrameWriterFactory {
+		std::map<std::string, std::vector<std::vector<float>>> written_{};
+		AudioFrameWriter::AudioFormat format_{};
+	public:
+		std::shared_ptr<AudioFrameWriter> make(
+			std::string filePath,
+			const AudioFrameWriter::AudioFormat &format
+		) override {
+			format_ = format;
+			return std::make_shared<RecordingWriter>(written_[std::move(filePath)]);
+		}
+
+		auto written(std::string filePath) const {
+			return written_.at(std::move(filePath));
+		}
+
+		auto &format() const noexcept {
+			return format_;
+		}
+	};
+
+	class ScalesAndReportsDelay : public SignalProcessor {
+		std::vector<index_type> *blockSizes;
+		float scale;
+		index_type delay;
+	public:
+		ScalesAndReportsDelay(
+			float scale, 
+			index_type delay, 
+			std::vector<index_type> *blockSizes = nullptr
+		) noexcept :
+			blockSizes{ blockSizes }, scale{ scale }, delay{ delay } {}
+
+		void process(signal_type signal) override {
+			if (blockSizes)
+				blockSizes->push_back(signal.size());
+			for (auto &x : signal)
+				x *= scale;
+		}
+
+		index_type groupDelay() override { return delay; }
+		void reset() override {}
+		void setScale(float s) override { scale = s; }
+	};
+
+	class AddsAndRecordsBlocks : public SignalProcessor {
+		std::vector<index_type> &blockSizes;
+		float addend;
+		index_type delay;
+	public:
+		AddsAndRecordsBlocks(
+			std::vector<index_type> &blockSizes, 
+			float addend, 
+			index_type delay
+		) noexcept :
+			blockSizes{ blockSizes }, addend{ addend }, delay{ delay } {}
+
+		void process(signal_type signal) override {
+			blockSizes.push_back(signal.size());
+			for (auto &x : signal)
+				x += addend;
+		}
+
+		index_type groupDelay() override { return delay; }
+		void reset() override {}
+		void setScale(float) override {}
+	};
+
+	// Spatialization scales and reports the BRIR length as its delay; the 
+	// hearing aid adds its attack time and reports half its window.
+	class SimulationChannelFactoryFake : public SimulationChannelFactory {
+		ArgumentCollection<HearingAidSimulation> hearingAidSimulation_{};
+		ArgumentCollection<float> hearingAidScale_{};
+		ArgumentCollection<float> withoutSimulationScale_{};
+		std::vector<SignalProcessor::index_type> blockSizes_{};
+		std::vector<SignalProcessor::index_type> spatializationBlockSizes_{};
+		int spatializations_{};
+		int arenasBegun_{};
+	public:
+		std::shared_ptr<SignalProcessor> makeWithoutSimulation(float scale) override {
+			withoutSimulationScale_.push_back(scale);
+			return std::make_shared<ScalesAndReportsDelay>(scale, 0);
+		}
+
+		std::shared_ptr<SignalProcessor> makeSpatialization(
+			Spatialization s, float scale
+		) override {
+			++spatializations_;
+			return std::make_shared<ScalesAndReportsDelay>(
+				scale, 
+				s.filterCoefficients.size(),
+				&spatializationBlockSizes_
+			);
+		}
+
+		std::shared_ptr<SignalProcessor> makeHearingAidSimulation(
+			HearingAidSimulation s, float scale
+		) override {
+			hearingAidSimulation_.push_back(s);
+			hearingAidScale_.push_back(scale);
+			return std::make_shared<AddsAndRecordsBlocks>(
+				blockSizes_,
+				gsl::narrow_cast<float>(s.attack_ms), 
+				s.windowSize / 2
+			);
+		}
+
+		std::shared_ptr<SignalProcessor> makeFullSimulation(
+			FullSimulation, float
+		) override {
+			return {};
+		}
+
+		void beginArena() override {
+			++arenasBegun_;
+		}
+
+		auto arenasBegun() const noexcept {
+			return arenasBegun_;
+		}
+
+		auto spatializations() const noexcept {
+			return spatializations_;
+		}
+
+		auto hearingAidSimulation() const {
+			return hearingAidSimulation_;
+		}
+
+		auto hearingAidScale() const {
+			return hearingAidScale_;
+		}
+
+		auto withoutSimulationScale() const {
+			return withoutSimulationScale_;
+		}
+
+		auto &blockSizes() const noexcept {
+			return blockSizes_;
+		}
+
+		auto &spatializationBlockSizes() const noexcept {
+			return spatializationBlockSizes_;
+		}
+	};
+
+	class CountingBrirReader : public BrirReader {
+		BinauralRoomImpulseResponse brir;
+		int reads_{};
+	public:
+		explicit CountingBrirReader(BinauralRoomImpulseResponse brir) :
+			brir{ std::move(brir) } {}
+
+		BinauralRoomImpulseResponse read(std::string) override {
+			++reads_;
+			return brir;
+		}
+
+		auto reads() const noexcept {
+			return reads_;
+		}
+	};
+
+	BrirReader::BinauralRoomImpulseResponse singleTapBrir() {
+		BrirReader::BinauralRoomImpulseResponse brir{};
+		brir.left = { 0 };
+		brir.right = { 0 };
+		return brir;
+	}
+
+	ParameterSweep::Point point(
+		std::string outputFilePath, 
+		double attack_ms, 
+		int windowSize = 2, 
+		int chunkSize = 2
+	) {
+		ParameterSweep::Point p{};
+		p.outputFilePath = std::move(outputFilePath);
+		p.attack_ms = attack_ms;
+		p.windowSize = windowSize;
+		p.chunkSize = chunkSize;
+		return p;
+	}
+
+	class ParameterSweepTests : public ::testing::Test {
+	protected:
+		ParameterSweep::Sweep sweep{};
+		InMemoryReaderFactory readerFactory{ { { 1, 2 }, { 3, 4 } }, 48000 };
+		RecordingWriterFactory writerFactory{};
+		CountingBrirReader brirReader{ singleTapBrir() };
+		PrescriptionReaderStub prescriptionReader{};
+		SimulationChannelFactoryFake channelFactory{};
+		std::shared_ptr<CalibrationComputerStub> calibration = 
+			std::make_shared<CalibrationComputerStub>();
+		CalibrationComputerStubFactory calibrationFactory{ calibration };
+		SignalStoreStub store{};
+		SignalCache cache{ &store, 1 << 20 };
+		ParameterSweep sweeper{
+			&readerFactory,
+			&writerFactory,
+			&brirReader,
+			&prescriptionReader,
+			&channelFactory,
+			&calibrationFactory,
+			&cache
+		};
+
+		ParameterSweepTests() {
+			calibration->addSignalScale(0, 2);
+			calibration->addSignalScale(1, 3);
+			sweep.audioFilePath = "a";
+			sweep.brirFilePath = "b";
+			sweep.usingSpatialization = true;
+		}
+
+		void assertRunThrowsSweepFailure(std::string what) {
+			try {
+				sweeper.run(sweep);
+				FAIL() << "Expected ParameterSweep::SweepFailure.";
+			}
+			catch (const ParameterSweep::SweepFailure &e) {
+				assertEqual(std::move(what), e.what());
+			}
+		}
+	};
+
+	TEST_F(ParameterSweepTests, pointsReplayPrefixIntoTheirHearingAid) {
+		sweep.points = { point("x", 10), point("y", 20) };
+		sweeper.run(sweep);
+		assertEqual({ 12, 14, 10, 10 }, writerFactory.written("x").at(0));
+		assertEqual({ 19, 22, 10, 10 }, writerFactory.written("x").at(1));
+		assertEqual({ 22, 24, 20, 20 }, writerFactory.written("y").at(0));
+		assertEqual({ 29, 32, 20, 20 }, writerFactory.written("y").at(1));
+	}
+
+	TEST_F(ParameterSweepTests, outputPaddedForLongestPathThroughEachPoint) {
+		sweep.points = { point("x", 0, 2), point("y", 0, 8) };
+		sweeper.run(sweep);
+		assertEqual(std::size_t{ 2 + 1 + 1 }, writerFactory.written("x").at(0).size());
+		assertEqual(std::size_t{ 2 + 1 + 4 }, writerFactory.written("y").at(0).size());
+	}
+
+	TEST_F(ParameterSweepTests, prefixRenderedOncePerSweep) {
+		sweep.points = { point("x", 0), point("y", 0), point("z", 0) };
+		sweeper.run(sweep);
+		assertEqual(2, channelFactory.spatializations());
+		assertEqual(std::size_t{ 6 }, channelFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(ParameterSweepTests, eachSweepBeginsOneArena) {
+		sweep.points = { point("x", 0), point("y", 0) };
+		sweeper.run(sweep);
+		sweeper.run(sweep);
+		assertEqual(2, channelFactory.arenasBegun());
+	}
+
+	TEST_F(ParameterSweepTests, prefixReusedAcrossSweeps) {
+		sweep.points = { point("x", 0) };
+		sweeper.run(sweep);
+		sweep.points = { point("y", 0) };
+		sweeper.run(sweep);
+		assertEqual(1, readerFactory.made());
+		assertEqual(1, brirReader.reads());
+		assertEqual(2, channelFactory.spatializations());
+	}
+
+	TEST_F(ParameterSweepTests, newLevelRendersNewPrefixFromDecodedStimulus) {
+		sweep.points = { point("x", 0) };
+		sweeper.run(sweep);
+		sweep.level_dB_Spl = 1;
+		sweeper.run(sweep);
+		assertEqual(1, readerFactory.made());
+		assertEqual(4, channelFactory.spatializations());
+	}
+
+	TEST_F(ParameterSweepTests, longerHearingAidDelayReusesPrefix) {
+		sweep.points = { point("x", 0, 2) };
+		sweeper.run(sweep);
+		sweep.points = { point("y", 0, 8) };
+		sweeper.run(sweep);
+		assertEqual(2, channelFactory.spatializations());
+		assertEqual(std::size_t{ 2 + 1 + 4 }, writerFactory.written("y").at(0).size());
+	}
+
+	TEST_F(ParameterSweepTests, prefixRenderedInBuffers) {
+		sweep.framesPerBuffer = 2;
+		sweep.points = { point("x", 0) };
+		sweeper.run(sweep);
+		const auto &sizes = channelFactory.spatializationBlockSizes();
+		assertEqual(std::size_t{ 4 }, sizes.size());
+		for (std::size_t i = 0; i < sizes.size(); ++i)
+			assertEqual(SignalProcessor::index_type{ i % 2 == 0 ? 2 : 1 }, sizes.at(i));
+	}
+
+	TEST_F(ParameterSweepTests, hearingAidReceivesWholeChunks) {
+		sweep.points = { point("x", 0, 8, 4) };
+		sweeper.run(sweep);
+		for (auto size : channelFactory.blockSizes())
+			assertEqual(SignalProcessor::index_type{ 4 }, size);
+	}
+
+	TEST_F(ParameterSweepTests, hearingAidBuiltAtUnitScaleWithPointParameters) {
+		auto p = point("x", 1, 2, 4);
+		p.release_ms = 5;
+		sweep.points = { p };
+		sweeper.run(sweep);
+		auto simulation = channelFactory.hearingAidSimulation().at(0);
+		assertEqual(1.0, simulation.attack_ms);
+		assertEqual(5.0, simulation.release_ms);
+		assertEqual(2, simulation.windowSize);
+		assertEqual(4, simulation.chunkSize);
+		assertEqual(48000, simulation.sampleRate);
+		assertEqual(1.0f, channelFactory.hearingAidScale().at(0));
+	}
+
+	TEST_F(ParameterSweepTests, hearingAidReceivesEachEarsPrescription) {
+		PrescriptionReader::Dsl left{};
+		left.channels = 1;
+		PrescriptionReader::Dsl right{};
+		right.channels = 2;
+		prescriptionReader.addPrescription("l", left);
+		prescriptionReader.addPrescription("r", right);
+		sweep.leftDslPrescriptionFilePath = "l";
+		sweep.rightDslPrescriptionFilePath = "r";
+		sweep.points = { point("x", 0) };
+		sweeper.run(sweep);
+		assertEqual(1, channelFactory.hearingAidSimulation().at(0).prescription.channels);
+		assertEqual(2, channelFactory.hearingAidSimulation().at(1).prescription.channels);
+	}
+
+	TEST_F(ParameterSweepTests, withoutSpatializationPrefixOnlyScales) {
+		sweep.usingSpatialization = false;
+		sweep.points = { point("x", 0) };
+		sweeper.run(sweep);
+		assertEqual(0, brirReader.reads());
+		assertEqual(2.0f, channelFactory.withoutSimulationScale().at(0));
+		assertEqual(3.0f, channelFactory.withoutSimulationScale().at(1));
+	}
+
+	TEST_F(ParameterSweepTests, writesInStimulusFormat) {
+		sweep.points = { point("x", 0) };
+		sweeper.run(sweep);
+		assertEqual(2, writerFactory.format().channels);
+		assertEqual(48000, writerFactory.format().sampleRate);
+	}
+
+	TEST_F(ParameterSweepTests, emptySweepReadsNothing) {
+		sweeper.run(sweep);
+		assertEqual(0, readerFactory.made());
+	}
+
+	TEST_F(ParameterSweepTests, nonPowerOfTwoChunkSizeThrowsSweepFailure) {
+		sweep.points = { point("x", 0, 2, 3) };
+		assertRunThrowsSweepFailure(
+			"Both the chunk size and window size must be powers of two; 3 is not a power of two."
+		);
+	}
+
+	TEST_F(ParameterSweepTests, prefixesBeyondBudgetSpillToStore) {
+		SignalCache smallCache{ &store, 0 };
+		ParameterSweep sweeper_{
+			&readerFactory,
+			&writerFactory,
+			&brirReader,
+			&prescriptionReader,
+			&channelFactory,
+			&calibrationFactory,
+			&smallCache
+		};
+		sweep.points = { point("x", 10) };
+		sweeper_.run(sweep);
+		sweep.points = { point("y", 10) };
+		sweeper_.run(sweep);
+		assertFalse(store.loaded().empty());
+		assertEqual(writerFactory.written("x").at(0), writerFactory.written("y").at(0));
+		assertEqual(writerFactory.written("x").at(1), writerFactory.written("y").at(1));
+	}
+
+	class ParameterSweepFailureTests : public ::testing::Test {
+	protected:
+		ParameterSweep::Sweep sweep{};
+		InMemoryReaderFactory defaultReaderFactory{ { { 1, 2 } }, 48000 };
+		RecordingWriterFactory defaultWriterFactory{};
+		CountingBrirReader defaultBrirReader{ singleTapBrir() };
+		PrescriptionReaderStub defaultPrescriptionReader{};
+		SimulationChannelFactoryFake channelFactory{};
+		CalibrationComputerStubFactory calibrationFactory{};
+		SignalStoreStub defaultStore{};
+		AudioFrameReaderFactory *readerFactory{ &defaultReaderFactory };
+		AudioFrameWriterFactory *writerFactory{ &defaultWriterFactory };
+		BrirReader *brirReader{ &defaultBrirReader };
+		PrescriptionReader *prescriptionReader{ &defaultPrescriptionReader };
+		SignalStore *store{ &defaultStore };
+		std::size_t budget{ 1 << 20 };
+
+		ParameterSweepFailureTests() {
+			sweep.audioFilePath = "a";
+			sweep.brirFilePath = "b";
+			sweep.leftDslPrescriptionFilePath = "c";
+			sweep.usingSpatialization = true;
+			sweep.points = { point("d", 0) };
+		}
+
+		void assertRunThrowsSweepFailure(std::string what) {
+			SignalCache cache{ store, budget };
+			ParameterSweep sweeper{
+				readerFactory,
+				writerFactory,
+				brirReader,
+				prescriptionReader,
+				&channelFactory,
+				&calibrationFactory,
+				&cache
+			};
+			try {
+				sweeper.run(sweep);
+				FAIL() << "Expected ParameterSweep::SweepFailure.";
+			}
+			catch (const ParameterSweep::SweepFailure &e) {
+				assertEqual(std::move(what), e.what());
+			}
+		}
+	};
+
+	TEST_F(ParameterSweepFailureTests, audioReaderFailure) {
+		ErrorAudioFrameReaderFactory failing{};
+		readerFactory = &failing;
+		assertRunThrowsSweepFailure("Audio file 'a' cannot be read.");
+	}
+
+	TEST_F(ParameterSweepFailureTests, audioWriterFailure) {
+		ErrorAudioFrameWriterFactory failing{};
+		writerFactory = &failing;
+		assertRunThrowsSweepFailure("Audio file 'd' cannot be written.");
+	}
+
+	TEST_F(ParameterSweepFailureTests, pointsAfterFailureBuildNoHearingAid) {
+		ErrorAudioFrameWriterFactory failing{};
+		writerFactory = &failing;
+		sweep.points = { point("d", 0), point("e", 0) };
+		assertRunThrowsSweepFailure("Audio file 'd' cannot be written.");
+		assertEqual(std::size_t{ 1 }, channelFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(ParameterSweepFailureTests, brirReaderFailure) {
+		FailingBrirReader failing{};
+		brirReader = &failing;
+		assertRunThrowsSweepFailure("BRIR 'b' cannot be read.");
+	}
+
+	TEST_F(ParameterSweepFailureTests, prescriptionReaderFailure) {
+		FailingPrescriptionReader failing{};
+		prescriptionReader = &failing;
+		assertRunThrowsSweepFailure("Prescription 'c' cannot be read.");
+	}
+
+	TEST_F(ParameterSweepFailureTests, storeFailure) {
+		FailingSignalStore failing{};
+		failing.setErrorMessage("error.");
+		store = &failing;
+		budget = 0;
+		assertRunThrowsSweepFailure("error.");
+	}
+}
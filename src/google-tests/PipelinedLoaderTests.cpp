@@ -0,0 +1,148 @@
+#include "assert-utility.h"
+#include "AudioFrameReaderStub.h"
+#include "AudioFrameProcessorStub.h"
+#include "FakeAudioFile.h"
+#include <audio-file-reading-writing/AudioFileInMemory.h>
+#include <spatialized-hearing-aid-simulation/PipelinedLoader.h>
+#include <spatialized-hearing-aid-simulation/ZeroPaddedLoader.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class AddsChannelNumber : public AudioFrameProcessor {
+		channel_type::index_type groupDelay_;
+	public:
+		explicit AddsChannelNumber(channel_type::index_type groupDelay_ = 0) noexcept :
+			groupDelay_{ groupDelay_ } {}
+
+		void process(gsl::span<channel_type> audio) override {
+			for (channel_type::index_type i = 0; i < audio.size(); ++i)
+				for (auto &x : audio.at(i))
+					x += i + 1;
+		}
+
+		channel_type::index_type groupDelay() override { return groupDelay_; }
+		void reset() override {}
+	};
+
+	class FailingProcessor : public AudioFrameProcessor {
+		void process(gsl::span<channel_type>) override {
+			throw std::runtime_error{ "error." };
+		}
+
+		channel_type::index_type groupDelay() override { return {}; }
+		void reset() override {}
+	};
+
+	class PipelinedLoaderTests : public ::testing::Test {
+	protected:
+		using channel_type = AudioLoader::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+		using size_type = buffer_type::size_type;
+
+		static std::vector<buffer_type> loadAll(AudioLoader &loader, size_type frames) {
+			buffer_type left(frames);
+			buffer_type right(frames);
+			std::vector<channel_type> stereo{ left, right };
+			std::vector<buffer_type> loaded(2);
+			while (!loader.complete()) {
+				loader.load(stereo);
+				loaded.at(0).insert(loaded.at(0).end(), left.begin(), left.end());
+				loaded.at(1).insert(loaded.at(1).end(), right.begin(), right.end());
+			}
+			return loaded;
+		}
+
+		static std::shared_ptr<AudioFrameReader> makeReader(std::vector<float> interleaved) {
+			FakeAudioFileReader file{ std::move(interleaved) };
+			file.setChannels(2);
+			return std::make_shared<AudioFileInMemory>(file);
+		}
+
+		static std::vector<float> interleavedRamp(int frames) {
+			std::vector<float> ramp;
+			for (int i = 0; i < 2 * frames; ++i)
+				ramp.push_back(i / 8.0f);
+			return ramp;
+		}
+
+		void assertMatchesZeroPaddedLoader(
+			std::vector<float> interleaved, 
+			channel_type::index_type groupDelay, 
+			size_type frames
+		) {
+			ZeroPaddedLoader sequential{ 
+				makeReader(interleaved), 
+				std::make_shared<AddsChannelNumber>(groupDelay) 
+			};
+			PipelinedLoader pipelined{ 
+				makeReader(interleaved), 
+				std::make_shared<AddsChannelNumber>(groupDelay),
+				2
+			};
+			auto expected = loadAll(sequential, frames);
+			auto actual = loadAll(pipelined, frames);
+			assertEqual(expected.at(0), actual.at(0));
+			assertEqual(expected.at(1), actual.at(1));
+		}
+	};
+
+	TEST_F(PipelinedLoaderTests, completeWhenNothingToLoad) {
+		PipelinedLoader loader{ 
+			std::make_shared<AudioFrameReaderStub>(), 
+			std::make_shared<AudioFrameProcessorStub>() 
+		};
+		assertTrue(loader.complete());
+	}
+
+	TEST_F(PipelinedLoaderTests, notCompleteIfReaderStillHasFramesRemaining) {
+		auto reader = std::make_shared<AudioFrameReaderStub>();
+		reader->setRemainingFrames(1);
+		PipelinedLoader loader{ reader, std::make_shared<AudioFrameProcessorStub>() };
+		assertFalse(loader.complete());
+	}
+
+	TEST_F(PipelinedLoaderTests, loadPadsZerosBeforeProcessing) {
+		PipelinedLoader loader{ 
+			makeReader({ 1, 2, 3, 4, 5, 6 }), 
+			std::make_shared<AddsChannelNumber>() 
+		};
+		auto loaded = loadAll(loader, 4);
+		assertEqual({ 1 + 1, 3 + 1, 5 + 1, 0 + 1 }, loaded.at(0));
+		assertEqual({ 2 + 2, 4 + 2, 6 + 2, 0 + 2 }, loaded.at(1));
+	}
+
+	TEST_F(PipelinedLoaderTests, loadsSameBlocksAsZeroPaddedLoader) {
+		assertMatchesZeroPaddedLoader(interleavedRamp(1000), 0, 64);
+	}
+
+	TEST_F(PipelinedLoaderTests, loadsSameGroupDelayPaddingAsZeroPaddedLoader) {
+		assertMatchesZeroPaddedLoader(interleavedRamp(1000), 150, 64);
+	}
+
+	TEST_F(PipelinedLoaderTests, loadsSameBlocksAsZeroPaddedLoaderForShortInput) {
+		assertMatchesZeroPaddedLoader(interleavedRamp(3), 5, 64);
+	}
+
+	TEST_F(PipelinedLoaderTests, processingFailureIsRethrownToCaller) {
+		PipelinedLoader loader{ 
+			makeReader(interleavedRamp(100)), 
+			std::make_shared<FailingProcessor>() 
+		};
+		buffer_type left(10);
+		buffer_type right(10);
+		std::vector<channel_type> stereo{ left, right };
+		EXPECT_THROW(loader.load(stereo), std::runtime_error);
+	}
+
+	TEST_F(PipelinedLoaderTests, destroyingBeforeCompleteStopsStages) {
+		PipelinedLoader loader{ 
+			makeReader(interleavedRamp(1000)), 
+			std::make_shared<AddsChannelNumber>() 
+		};
+		buffer_type left(10);
+		buffer_type right(10);
+		std::vector<channel_type> stereo{ left, right };
+		loader.load(stereo);
+		assertFalse(loader.complete());
+	}
+}
@@ -122,6 +122,24 @@ namespace {
 		}
 	};
 
+	class BrowsingForProcessingGraph : public BrowsingForEnteredFilePathUseCase {
+		void run(View::EventListener *listener) override {
+			listener->browseForProcessingGraph();
+		}
+
+		std::string &entry(ViewStub &view) override {
+			return view.testSetup_.processingGraphFilePath_;
+		}
+
+		std::string &result(ViewStub &view) override {
+			return browseForOpeningFileResult(view);
+		}
+
+		const std::vector<std::string>& filters(const ViewStub &view) override {
+			return browseFiltersForOpeningFile(view);
+		}
+	};
+
 	class BrowsingForLeftDslPrescription : public BrowsingForEnteredFilePathUseCase {
 		void run(View::EventListener *listener) override {
 			listener->browseForLeftDslPrescription();
@@ -338,6 +356,7 @@ namespace {
 		SavingAudio savingAudio{};
 		BrowsingForAudioFile browsingForAudioFile{};
 		BrowsingForBrir browsingForBrir{};
+		BrowsingForProcessingGraph browsingForProcessingGraph{};
 		BrowsingForLeftDslPrescription browsingForLeftDslPrescription{};
 		BrowsingForRightDslPrescription browsingForRightDslPrescription{};
 		BrowsingForStimulusList browsingForStimulusList{};
@@ -620,6 +639,32 @@ namespace {
 			runUseCase(useCase);
 			assertFalse(useCase->processing(model).usingHearingAidSimulation);
 		}
+
+		void assertNotUsingProcessingGraphFollowingRequest(SignalProcessingUseCase *useCase) {
+			runUseCase(useCase);
+			assertFalse(useCase->processing(model).usingProcessingGraph);
+		}
+
+		void assertUsingProcessingGraphFollowingRequest(SignalProcessingUseCase *useCase) {
+			view.testSetup_.setProcessingGraphFilePath("a");
+			runUseCase(useCase);
+			assertTrue(useCase->processing(model).usingProcessingGraph);
+			assertEqual("a", useCase->processing(model).processingGraphFilePath);
+		}
+
+		void assertProcessingGraphCompressionMatchesViewFollowingRequest(SignalProcessingUseCase *useCase) {
+			view.setHearingAidSimulationOff();
+			view.testSetup_.setProcessingGraphFilePath("a");
+			view.testSetup_.setAttack_ms("1.1");
+			view.testSetup_.setRelease_ms("2.2");
+			view.testSetup_.setChunkSize("3");
+			view.testSetup_.setWindowSize("4");
+			runUseCase(useCase);
+			assertEqual(1.1, useCase->processing(model).attack_ms);
+			assertEqual(2.2, useCase->processing(model).release_ms);
+			assertEqual(3, useCase->processing(model).chunkSize);
+			assertEqual(4, useCase->processing(model).windowSize);
+		}
 	};
 
 	TEST_F(PresenterTests, constructorSubscribesToViewEvents) {
@@ -656,6 +701,10 @@ namespace {
 		assertCancellingBrowseDoesNotChangePath(&browsingForBrir);
 	}
 
+	TEST_F(PresenterTests, cancellingBrowseForProcessingGraphDoesNotChangeProcessingGraphFilePath) {
+		assertCancellingBrowseDoesNotChangePath(&browsingForProcessingGraph);
+	}
+
 	TEST_F(PresenterTests, browseForTestFileFiltersTextFiles) {
 		assertBrowsingFilters(&browsingForTestFile, { "*.txt" });
 	}
@@ -668,6 +717,10 @@ namespace {
 		assertBrowsingFilters(&browsingForBrir, { "*.wav" });
 	}
 
+	TEST_F(PresenterTests, browseForProcessingGraphFiltersJsonFiles) {
+		assertBrowsingFilters(&browsingForProcessingGraph, { "*.json" });
+	}
+
 	TEST_F(PresenterTests, browseForPrescriptionsFiltersJsonFiles) {
 		assertBrowsingFilters(&browsingForLeftDslPrescription, { "*.json" });
 		assertBrowsingFilters(&browsingForRightDslPrescription, { "*.json" });
@@ -698,6 +751,10 @@ namespace {
 		assertBrowseResultPassedToEntry(&browsingForBrir);
 	}
 
+	TEST_F(PresenterTests, browseForProcessingGraphUpdatesProcessingGraphFilePath) {
+		assertBrowseResultPassedToEntry(&browsingForProcessingGraph);
+	}
+
 	TEST_F(PresenterTests, togglingSpatializationOffDeactivatesUI) {
 		view.clearActivationState();
 		view.setSpatializationOff();
@@ -730,6 +787,13 @@ namespace {
 		confirmTestSetupShowsTesterView();
 	}
 
+	TEST_F(PresenterTests, confirmTestSetupShowsStimuliLoaded) {
+		confirmTestSetup();
+		model.testing().stimuliLoaded(3, 4);
+		assertEqual(3, view.stimuliLoaded());
+		assertEqual(4, view.stimuliToLoad());
+	}
+
 	TEST_F(PresenterTests, confirmTestSetupHidesTestSetupView) {
 		confirmTestSetupHidesSetupView();
 	}
@@ -963,6 +1027,33 @@ namespace {
 		assertFalse(model.audioSaved());
 	}
 
+	TEST_F(PresenterTests, sweepParametersPassesParametersToModel) {
+		view.testSetup_.setAudioFilePath("a");
+		view.testSetup_.setLevel_dB_Spl("1.1");
+		view.testSetup_.setAttack_ms("2, 3");
+		view.testSetup_.setRelease_ms("4");
+		view.setBrowseDirectory("b");
+		view.sweepParameters();
+		assertEqual("a", model.parameterSweeping().inputAudioFilePath);
+		assertEqual("b", model.parameterSweeping().outputDirectory);
+		assertEqual(1.1, model.parameterSweeping().level_dB_Spl);
+		assertEqual({ 2, 3 }, model.parameterSweeping().attack_ms);
+		assertEqual({ 4 }, model.parameterSweeping().release_ms);
+	}
+
+	TEST_F(PresenterTests, cancellingSweepParametersDoesNotSweep) {
+		view.setBrowseCancelled();
+		view.sweepParameters();
+		assertFalse(model.parametersSwept());
+	}
+
+	TEST_F(PresenterTests, sweepParametersWithInvalidAttackListShowsErrorMessage) {
+		view.testSetup_.setAttack_ms("1,,2");
+		view.sweepParameters();
+		assertEqual("'' is not a valid attack time.", view.errorMessage());
+		assertFalse(model.parametersSwept());
+	}
+
 	TEST_F(PresenterTests, confirmTestSetupPassesHearingAidParametersToModel) {
 		assertHearingAidSimulationMatchesViewFollowingRequest(&confirmingTestSetup);
 	}
@@ -1035,6 +1126,38 @@ namespace {
 		assertNotUsingHearingAidSimulationFollowingRequest(&savingAudio);
 	}
 
+	TEST_F(PresenterTests, confirmTestSetupNotUsingProcessingGraph) {
+		assertNotUsingProcessingGraphFollowingRequest(&confirmingTestSetup);
+	}
+
+	TEST_F(PresenterTests, playCalibrationNotUsingProcessingGraph) {
+		assertNotUsingProcessingGraphFollowingRequest(&playingCalibration);
+	}
+
+	TEST_F(PresenterTests, saveAudioNotUsingProcessingGraph) {
+		assertNotUsingProcessingGraphFollowingRequest(&savingAudio);
+	}
+
+	TEST_F(PresenterTests, confirmTestSetupUsingProcessingGraphWhenEntered) {
+		assertUsingProcessingGraphFollowingRequest(&confirmingTestSetup);
+	}
+
+	TEST_F(PresenterTests, playCalibrationUsingProcessingGraphWhenEntered) {
+		assertUsingProcessingGraphFollowingRequest(&playingCalibration);
+	}
+
+	TEST_F(PresenterTests, saveAudioUsingProcessingGraphWhenEntered) {
+		assertUsingProcessingGraphFollowingRequest(&savingAudio);
+	}
+
+	TEST_F(PresenterTests, confirmTestSetupPassesCompressionToProcessingGraph) {
+		assertProcessingGraphCompressionMatchesViewFollowingRequest(&confirmingTestSetup);
+	}
+
+	TEST_F(PresenterTests, playCalibrationPassesCompressionToProcessingGraph) {
+		assertProcessingGraphCompressionMatchesViewFollowingRequest(&playingCalibration);
+	}
+
 	TEST_F(PresenterTests, playCalibrationWithInvalidLevelDoesNotPlay) {
 		setInvalidLevel();
 		playCalibrationDoesNotPlay();
@@ -0,0 +1,80 @@
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/ProcessingArena.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+	class ProcessingArenaTests : public ::testing::Test {
+	protected:
+		using buffer_type = std::pmr::vector<float>;
+
+		static auto resource(const buffer_type &buffer) {
+			return buffer.get_allocator().resource();
+		}
+	};
+
+	class TakesLeadingAllocator {
+	public:
+		using allocator_type = ProcessingArena::allocator_type;
+		std::pmr::memory_resource *resource;
+
+		TakesLeadingAllocator(std::allocator_arg_t, const allocator_type &allocator) noexcept :
+			resource{ allocator.resource() } {}
+	};
+
+	TEST_F(ProcessingArenaTests, makeConstructsWithArguments) {
+		ProcessingArena arena{};
+		auto made = arena.make<std::vector<int>>(3, 1);
+		assertEqual({ 1, 1, 1 }, *made);
+	}
+
+	TEST_F(ProcessingArenaTests, containersTakeArenaResource) {
+		ProcessingArena arena{};
+		auto first = arena.makeUsingAllocator<buffer_type>();
+		auto second = arena.makeUsingAllocator<buffer_type>();
+		assertTrue(resource(*first) == resource(*second));
+		assertTrue(resource(*first) != std::pmr::get_default_resource());
+	}
+
+	TEST_F(ProcessingArenaTests, allocatorPassedFirstWhenTaken) {
+		ProcessingArena arena{};
+		auto buffer = arena.makeUsingAllocator<buffer_type>();
+		auto made = arena.makeUsingAllocator<TakesLeadingAllocator>();
+		assertTrue(resource(*buffer) == made->resource);
+	}
+
+	TEST_F(ProcessingArenaTests, madeObjectsOutliveArena) {
+		std::shared_ptr<buffer_type> buffer;
+		{
+			ProcessingArena arena{};
+			buffer = arena.makeUsingAllocator<buffer_type>();
+		}
+		buffer->assign({ 1, 2, 3 });
+		assertEqual({ 1, 2, 3 }, std::vector<float>(buffer->begin(), buffer->end()));
+	}
+
+	TEST_F(ProcessingArenaTests, separateArenasUseSeparateResources) {
+		ProcessingArena first{};
+		ProcessingArena second{};
+		assertTrue(
+			resource(*first.makeUsingAllocator<buffer_type>()) != 
+			resource(*second.makeUsingAllocator<buffer_type>())
+		);
+	}
+
+	TEST_F(ProcessingArenaTests, containersGrowingOnSeparateThreadsKeepTheirContents) {
+		ProcessingArena arena{ 16 };
+		auto first = arena.makeUsingAllocator<buffer_type>();
+		auto second = arena.makeUsingAllocator<buffer_type>();
+		const auto fill = [](buffer_type &buffer, float value) {
+			for (int i = 0; i < 1 << 14; ++i)
+				buffer.push_back(value);
+		};
+		std::thread other{ fill, std::ref(*first), 1.0f };
+		fill(*second, 2.0f);
+		other.join();
+		assertEqual(std::vector<float>(1 << 14, 1), std::vector<float>(first->begin(), first->end()));
+		assertEqual(std::vector<float>(1 << 14, 2), std::vector<float>(second->begin(), second->end()));
+	}
+}
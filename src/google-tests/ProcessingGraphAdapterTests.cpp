@@ -0,0 +1,107 @@
+#include "FakeConfigurationFileParser.h"
+#include "assert-utility.h"
+#include <dsl-prescription/ProcessingGraphAdapter.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class ProcessingGraphAdapterTests : public ::testing::Test {
+	protected:
+		using NodeType = ProcessingGraphReader::NodeType;
+		std::shared_ptr<FakeConfigurationFileParser> parser =
+			std::make_shared<FakeConfigurationFileParser>();
+		FakeConfigurationFileParserFactory factory{ parser };
+		ProcessingGraphAdapter adapter{ &factory };
+
+		void setNodes(int n) {
+			using namespace processing_graph;
+			parser->setIntProperty(propertyName(Property::nodes), n);
+		}
+
+		void setType(int node, NodeType type) {
+			setType(node, processing_graph::typeName(type));
+		}
+
+		void setType(int node, std::string type) {
+			using namespace processing_graph;
+			parser->setStringProperty(propertyName(node, Property::type), std::move(type));
+		}
+
+		void setInputs(int node, std::vector<double> inputs) {
+			using namespace processing_graph;
+			parser->setVectorProperty(propertyName(node, Property::inputs), std::move(inputs));
+		}
+
+		void setChannel(int node, int channel) {
+			using namespace processing_graph;
+			parser->setIntProperty(propertyName(node, Property::channel), channel);
+		}
+
+		void setFile(int node, std::string file) {
+			using namespace processing_graph;
+			parser->setStringProperty(propertyName(node, Property::file), std::move(file));
+		}
+
+		void assertReadThrowsReadFailure(std::string what) {
+			try {
+				adapter.read({});
+				FAIL() << "Expected ProcessingGraphAdapter::ReadFailure.";
+			}
+			catch (const ProcessingGraphAdapter::ReadFailure &e) {
+				assertEqual(std::move(what), e.what());
+			}
+		}
+	};
+
+	TEST_F(ProcessingGraphAdapterTests, readPassesFilePathToFactory) {
+		setNodes(0);
+		adapter.read("a");
+		assertEqual("a", factory.filePaths().at(0));
+	}
+
+	TEST_F(ProcessingGraphAdapterTests, nodesReceivedAsParsed) {
+		setNodes(4);
+		setType(0, NodeType::input);
+		setChannel(0, 1);
+		setType(1, NodeType::fir);
+		setInputs(1, { 0 });
+		setChannel(1, 1);
+		setFile(1, "a");
+		setType(2, NodeType::hearingAid);
+		setInputs(2, { 1 });
+		setFile(2, "b");
+		setType(3, NodeType::output);
+		setInputs(3, { 2 });
+		setChannel(3, 0);
+		const auto nodes = adapter.read({});
+		assertEqual(std::size_t{ 4 }, nodes.size());
+		assertTrue(NodeType::input == nodes.at(0).type);
+		assertEqual(1, nodes.at(0).channel);
+		assertTrue(NodeType::fir == nodes.at(1).type);
+		assertEqual({ 0 }, nodes.at(1).inputs);
+		assertEqual("a", nodes.at(1).filePath);
+		assertTrue(NodeType::hearingAid == nodes.at(2).type);
+		assertEqual({ 1 }, nodes.at(2).inputs);
+		assertEqual("b", nodes.at(2).filePath);
+		assertTrue(NodeType::output == nodes.at(3).type);
+		assertEqual({ 2 }, nodes.at(3).inputs);
+		assertEqual(0, nodes.at(3).channel);
+	}
+
+	TEST_F(ProcessingGraphAdapterTests, mixReceivesEveryInput) {
+		setNodes(1);
+		setType(0, NodeType::mix);
+		setInputs(0, { 1, 2, 3 });
+		assertEqual({ 1, 2, 3 }, adapter.read({}).at(0).inputs);
+	}
+
+	TEST_F(ProcessingGraphAdapterTests, unknownTypeThrowsReadFailure) {
+		setNodes(1);
+		setType(0, "reverb");
+		assertReadThrowsReadFailure("unknown node type 'reverb'.");
+	}
+
+	TEST_F(ProcessingGraphAdapterTests, throwsWhenParserThrows) {
+		factory.setParser(std::make_shared<ErrorParser>("error."));
+		assertReadThrowsReadFailure("error.");
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/ProcessingGraphReader.h>
+
+class ProcessingGraphReaderStub : public ProcessingGraphReader {
+	std::vector<Node> nodes_{};
+	std::string filePath_{};
+	bool readCalled_{};
+public:
+	void setNodes(std::vector<Node> nodes) {
+		nodes_ = std::move(nodes);
+	}
+
+	std::vector<Node> read(std::string filePath) override {
+		readCalled_ = true;
+		filePath_ = std::move(filePath);
+		return nodes_;
+	}
+
+	auto filePath() const {
+		return filePath_;
+	}
+
+	auto readCalled() const noexcept {
+		return readCalled_;
+	}
+};
+
+class FailingProcessingGraphReader : public ProcessingGraphReader {
+	std::string errorMessage{};
+public:
+	void setErrorMessage(std::string s) {
+		errorMessage = std::move(s);
+	}
+
+	std::vector<Node> read(std::string) override {
+		throw ReadFailure{ errorMessage };
+	}
+};
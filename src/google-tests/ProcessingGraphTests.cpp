@@ -0,0 +1,210 @@
+#include "assert-utility.h"
+#include "SignalProcessorStub.h"
+#include <spatialized-hearing-aid-simulation/ProcessingGraph.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class DelaysBy : public SignalProcessor {
+		index_type delay;
+	public:
+		explicit DelaysBy(index_type delay) noexcept : delay{ delay } {}
+		void process(signal_type) override {}
+		index_type groupDelay() override { return delay; }
+		void reset() override {}
+		void setScale(float) override {}
+	};
+
+	class ProcessingGraphTests : public ::testing::Test {
+	protected:
+		using channel_type = ProcessingGraph::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+		using Operation = ProcessingGraph::Operation;
+		std::vector<ProcessingGraph::Node> nodes{};
+		int maximumWorkers{ 4 };
+
+		int add(
+			Operation operation, 
+			std::vector<int> inputs = {}, 
+			int channel = 0,
+			std::shared_ptr<SignalProcessor> processor = {}
+		) {
+			ProcessingGraph::Node node{};
+			node.operation = operation;
+			node.inputs = std::move(inputs);
+			node.channel = channel;
+			node.processor = std::move(processor);
+			nodes.push_back(std::move(node));
+			return gsl::narrow<int>(nodes.size() - 1);
+		}
+
+		int addInput(int channel) {
+			return add(Operation::input, {}, channel);
+		}
+
+		int addOutput(int input, int channel) {
+			return add(Operation::output, { input }, channel);
+		}
+
+		int addProcessor(int input, std::shared_ptr<SignalProcessor> processor) {
+			return add(Operation::process, { input }, 0, std::move(processor));
+		}
+
+		ProcessingGraph construct(channel_type::index_type framesPerBuffer = 4) {
+			return { nodes, framesPerBuffer, maximumWorkers };
+		}
+
+		void assertConstructionThrowsInvalidTopology(std::string what) {
+			try {
+				construct();
+				FAIL() << "Expected ProcessingGraph::InvalidTopology.";
+			}
+			catch (const ProcessingGraph::InvalidTopology &e) {
+				assertEqual(std::move(what), e.what());
+			}
+		}
+	};
+
+	TEST_F(ProcessingGraphTests, chainProcessesInOrder) {
+		auto input = addInput(0);
+		auto added = addProcessor(input, std::make_shared<AddsSamplesBy>(1.0f));
+		auto multiplied = addProcessor(added, std::make_shared<MultipliesSamplesBy>(2.0f));
+		addOutput(multiplied, 0);
+		auto graph = construct();
+		buffer_type x{ 1, 2, 3 };
+		std::vector<channel_type> audio{ x };
+		graph.process(audio);
+		assertEqual({ 4, 6, 8 }, x);
+	}
+
+	TEST_F(ProcessingGraphTests, outputsMayCrossChannels) {
+		addOutput(addInput(0), 1);
+		addOutput(addInput(1), 0);
+		auto graph = construct();
+		buffer_type left{ 1, 2 };
+		buffer_type right{ 3, 4 };
+		std::vector<channel_type> audio{ left, right };
+		graph.process(audio);
+		assertEqual({ 3, 4 }, left);
+		assertEqual({ 1, 2 }, right);
+	}
+
+	TEST_F(ProcessingGraphTests, splitBranchesProcessIndependentlyAndMix) {
+		auto input = addInput(0);
+		auto split = addProcessor(input, {});
+		auto added = addProcessor(split, std::make_shared<AddsSamplesBy>(1.0f));
+		auto multiplied = addProcessor(split, std::make_shared<MultipliesSamplesBy>(3.0f));
+		auto mixed = add(Operation::mix, { added, multiplied });
+		addOutput(mixed, 0);
+		addOutput(split, 1);
+		auto graph = construct();
+		buffer_type left{ 1, 2 };
+		buffer_type right{ 0, 0 };
+		std::vector<channel_type> audio{ left, right };
+		graph.process(audio);
+		assertEqual({ (1 + 1) + 1 * 3.0f, (2 + 1) + 2 * 3.0f }, left);
+		assertEqual({ 1, 2 }, right);
+	}
+
+	TEST_F(ProcessingGraphTests, runsIndependentBranchesOnWorkers) {
+		auto left = addInput(0);
+		auto right = addInput(1);
+		addOutput(addProcessor(left, std::make_shared<AddsSamplesBy>(1.0f)), 0);
+		addOutput(addProcessor(right, std::make_shared<AddsSamplesBy>(2.0f)), 1);
+		auto graph = construct();
+		assertEqual(1, graph.workers());
+		for (int i = 0; i < 100; ++i) {
+			buffer_type a{ float(i) };
+			buffer_type b{ float(i) };
+			std::vector<channel_type> audio{ a, b };
+			graph.process(audio);
+			assertEqual({ i + 1.0f }, a);
+			assertEqual({ i + 2.0f }, b);
+		}
+	}
+
+	TEST_F(ProcessingGraphTests, chainNeedsNoWorkers) {
+		addOutput(addProcessor(addInput(0), {}), 0);
+		auto graph = construct();
+		assertEqual(0, graph.workers());
+	}
+
+	TEST_F(ProcessingGraphTests, workersLimitedByMaximum) {
+		maximumWorkers = 0;
+		addOutput(addProcessor(addInput(0), {}), 0);
+		addOutput(addProcessor(addInput(1), {}), 1);
+		auto graph = construct();
+		assertEqual(0, graph.workers());
+	}
+
+	TEST_F(ProcessingGraphTests, processesBlocksLargerThanAnnounced) {
+		addOutput(addProcessor(addInput(0), std::make_shared<AddsSamplesBy>(1.0f)), 0);
+		auto graph = construct(1);
+		buffer_type x{ 1, 2, 3 };
+		std::vector<channel_type> audio{ x };
+		graph.process(audio);
+		assertEqual({ 2, 3, 4 }, x);
+	}
+
+	TEST_F(ProcessingGraphTests, missingInputChannelReadsAsZeros) {
+		addOutput(addInput(1), 0);
+		auto graph = construct();
+		buffer_type x{ 1, 2 };
+		std::vector<channel_type> audio{ x };
+		graph.process(audio);
+		assertEqual({ 0, 0 }, x);
+	}
+
+	TEST_F(ProcessingGraphTests, groupDelayIsLongestPathToAnOutput) {
+		auto input = addInput(0);
+		auto shortPath = addProcessor(input, std::make_shared<DelaysBy>(1));
+		auto longPath = addProcessor(
+			addProcessor(input, std::make_shared<DelaysBy>(2)), 
+			std::make_shared<DelaysBy>(3)
+		);
+		addOutput(add(Operation::mix, { shortPath, longPath }), 0);
+		addProcessor(input, std::make_shared<DelaysBy>(10));
+		auto graph = construct();
+		assertEqual(channel_type::index_type{ 2 + 3 }, graph.groupDelay());
+	}
+
+	TEST_F(ProcessingGraphTests, cycleThrowsInvalidTopology) {
+		add(Operation::mix, { 1 });
+		add(Operation::mix, { 0 });
+		assertConstructionThrowsInvalidTopology("The graph contains a cycle.");
+	}
+
+	TEST_F(ProcessingGraphTests, missingNodeThrowsInvalidTopology) {
+		addOutput(1, 0);
+		assertConstructionThrowsInvalidTopology("A node refers to a node that does not exist.");
+	}
+
+	TEST_F(ProcessingGraphTests, outputFeedingNodeThrowsInvalidTopology) {
+		auto output = addOutput(addInput(0), 0);
+		addProcessor(output, {});
+		assertConstructionThrowsInvalidTopology("An output node cannot feed another node.");
+	}
+
+	TEST_F(ProcessingGraphTests, processorWithoutInputThrowsInvalidTopology) {
+		add(Operation::process);
+		assertConstructionThrowsInvalidTopology(
+			"Output and processing nodes take exactly one input."
+		);
+	}
+
+	TEST_F(ProcessingGraphTests, topologicalOrderPlacesInputsFirst) {
+		add(Operation::output, { 1 });
+		add(Operation::process, { 2 });
+		add(Operation::input);
+		assertEqual({ 2, 1, 0 }, ProcessingGraph::topologicalOrder(nodes));
+	}
+
+	TEST_F(ProcessingGraphTests, resetResetsEveryNodeProcessor) {
+		auto first = std::make_shared<SignalProcessorStub>();
+		auto second = std::make_shared<SignalProcessorStub>();
+		addOutput(addProcessor(addProcessor(addInput(0), first), second), 0);
+		auto graph = construct();
+		graph.reset();
+		assertEqual(1, first->resets());
+		assertEqual(1, second->resets());
+	}
+}
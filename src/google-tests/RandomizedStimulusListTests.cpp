@@ -75,6 +75,16 @@ namespace {
 		assertEqual("C:/a", next());
 	}
 
+	TEST_F(
+		RandomizedStimulusListTests,
+		remainingReturnsFullPathsOfFilesNotYetReturned
+	) {
+		reader->setFileNames({ "a", "b", "c" });
+		initialize({ "C:" });
+		next();
+		assertEqual<std::string>({ "C:/b", "C:/c" }, stimulusList.remaining());
+	}
+
 	TEST_F(
 		RandomizedStimulusListTests,
 		initializeShufflesFileNames
@@ -0,0 +1,311 @@
+#include "AllocationFreeRegion.h"
+#include "AudioDeviceStub.h"
+#include "BrirReaderStub.h"
+#include "DocumenterStub.h"
+#include "FakeAudioFile.h"
+#include "FakeStimulusList.h"
+#include "PrescriptionReaderStub.h"
+#include "ProcessingGraphReaderStub.h"
+#include "SignalStoreStub.h"
+#include "TaskRunnerStub.h"
+#include "TemporaryFilesStub.h"
+#include "assert-utility.h"
+#include <audio-file-reading-writing/AudioFileInMemory.h>
+#include <fir-filtering/FirFilter.h>
+#include <hearing-aid-processing/HearingAidProcessor.h>
+#include <main/Chapro.h>
+#include <playing-audio/AudioDevicePlayer.h>
+#include <signal-processing/ScalingProcessor.h>
+#include <spatialized-hearing-aid-simulation/CalibrationComputerImpl.h>
+#include <spatialized-hearing-aid-simulation/ChannelCopier.h>
+#include <spatialized-hearing-aid-simulation/ChannelProcessingGroup.h>
+#include <spatialized-hearing-aid-simulation/ParallelChannelProcessingGroup.h>
+#include <spatialized-hearing-aid-simulation/PipelinedLoader.h>
+#include <spatialized-hearing-aid-simulation/SpatialHearingAidModel.h>
+#include <spatialized-hearing-aid-simulation/StaticSimulationChannelFactory.h>
+#include <spatialized-hearing-aid-simulation/ZeroPaddedLoader.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class CalibrationComputerImplFactory : public CalibrationComputerFactory {
+	public:
+		std::shared_ptr<CalibrationComputer> make(AudioFrameReader *r) override {
+			return std::make_shared<CalibrationComputerImpl>(*r);
+		}
+	};
+
+	ProcessingGraphReader::Node graphNode(
+		ProcessingGraphReader::NodeType type,
+		std::vector<int> inputs,
+		int channel,
+		std::string filePath = {}
+	) {
+		ProcessingGraphReader::Node node{};
+		node.type = type;
+		node.inputs = std::move(inputs);
+		node.channel = channel;
+		node.filePath = std::move(filePath);
+		return node;
+	}
+
+	// Composes the model the way the application does, with in-memory
+	// files and the real compressor, and plays trials through the device
+	// callback.
+	class RealTimeAllocationTests : public ::testing::Test {
+	protected:
+		using sample_type = AudioFrameProcessor::channel_type::element_type;
+
+		SpatialHearingAidModel::Testing testing{};
+		SpatialHearingAidModel::Trial trial{};
+		SpatialHearingAidModel::Calibration calibration{};
+		FakeStimulusList stimulusList{};
+		DocumenterStub documenter{};
+		AudioDeviceStub device{};
+		std::unique_ptr<AudioDevicePlayer> player{};
+		int framesPerDeviceBuffer{};
+		ZeroPaddedLoaderFactory audioLoaderFactory{};
+		PipelinedLoaderFactory offlineLoaderFactory{};
+		std::shared_ptr<FakeAudioFileReader> audioFile =
+			std::make_shared<FakeAudioFileReader>();
+		FakeAudioFileFactory audioFileFactory{ audioFile };
+		AudioFileInMemoryFactory inMemoryFactory{ &audioFileFactory };
+		ChannelCopierFactory audioFrameReaderFactory{ &inMemoryFactory };
+		PrescriptionReaderStub prescriptionReader{};
+		BrirReaderStub brirReader{};
+		ProcessingGraphReaderStub graphReader{};
+		ChaproFactory compressorFactory{};
+		StaticSimulationChannelFactory<
+			ScalingProcessor<float>,
+			FirFilter<float>,
+			HearingAidProcessor
+		> simulationFactory{ &compressorFactory };
+		CalibrationComputerImplFactory calibrationComputerFactory{};
+		ChannelProcessingGroupFactory sequentialGroupFactory{};
+		ParallelChannelProcessingGroupFactory parallelGroupFactory{};
+		SignalStoreStub spillStore{};
+		SignalCache renderedStimuli{ &spillStore, 1 << 20 };
+		TaskRunnerStub backgroundTasks{};
+		TemporaryFilesStub temporaryFiles{};
+		std::vector<std::vector<sample_type>> deviceBuffers{};
+		std::vector<sample_type *> deviceChannels{};
+
+		RealTimeAllocationTests() {
+			std::vector<float> stereo(2 * 5000);
+			for (std::size_t i = 0; i < stereo.size(); ++i)
+				stereo.at(i) = (i % 7) / 7.0f - 0.5f;
+			audioFile->setContents(std::move(stereo));
+			audioFile->setChannels(2);
+			audioFile->setSampleRate(48000);
+			stimulusList.setContents({ "a.wav", "b.wav", "c.wav" });
+			// Pre-rendering happens between trials, not while the region
+			// is open, so trials also play what was pre-rendered.
+			backgroundTasks.runTasksWhenAwaited();
+			BrirReader::BinauralRoomImpulseResponse brir;
+			brir.left = { 0.5f, 0.25f, 0.125f };
+			brir.right = { 0.25f, 0.5f };
+			brir.sampleRate = 48000;
+			brirReader.setBrir(std::move(brir));
+			prescriptionReader.addPrescription("left", prescription());
+			prescriptionReader.addPrescription("right", prescription());
+			auto &processing = testing.processing;
+			processing.brirFilePath = "brir";
+			processing.leftDslPrescriptionFilePath = "left";
+			processing.rightDslPrescriptionFilePath = "right";
+			processing.processingGraphFilePath = "graph";
+			processing.chunkSize = 256;
+			processing.windowSize = 128;
+			trial.level_dB_Spl = 65;
+			calibration.processing = processing;
+			calibration.audioFilePath = "calibration.wav";
+			calibration.level_dB_Spl = 65;
+		}
+
+		static PrescriptionReader::Dsl prescription() {
+			PrescriptionReader::Dsl dsl{};
+			dsl.channels = 2;
+			dsl.crossFrequenciesHz = { 1000 };
+			dsl.compressionRatios = { 1.5, 2 };
+			dsl.kneepoints_dBSpl = { 45, 45 };
+			dsl.kneepointGains_dB = { 10, 15 };
+			dsl.broadbandOutputLimitingThresholds_dBSpl = { 100, 100 };
+			return dsl;
+		}
+
+		std::shared_ptr<SpatialHearingAidModel> makeModel(ProcessingGroupFactory *groupFactory) {
+			player = std::make_unique<AudioDevicePlayer>(&device, framesPerDeviceBuffer);
+			return std::make_shared<SpatialHearingAidModel>(
+				&stimulusList,
+				&documenter,
+				player.get(),
+				&audioLoaderFactory,
+				&offlineLoaderFactory,
+				&audioFrameReaderFactory,
+				nullptr,
+				&prescriptionReader,
+				&brirReader,
+				&graphReader,
+				&simulationFactory,
+				&calibrationComputerFactory,
+				groupFactory,
+				&renderedStimuli,
+				&backgroundTasks,
+				&temporaryFiles
+			);
+		}
+
+		void setHearingAidSimulation() noexcept {
+			testing.processing.usingHearingAidSimulation = true;
+		}
+
+		void setSpatialization() noexcept {
+			testing.processing.usingSpatialization = true;
+		}
+
+		void setProcessingGraph() {
+			testing.processing.usingProcessingGraph = true;
+			using NodeType = ProcessingGraphReader::NodeType;
+			graphReader.setNodes({
+				graphNode(NodeType::input, {}, 0),
+				graphNode(NodeType::input, {}, 1),
+				graphNode(NodeType::scale, { 0 }, 0),
+				graphNode(NodeType::scale, { 1 }, 1),
+				graphNode(NodeType::fir, { 2 }, 0, "brir"),
+				graphNode(NodeType::fir, { 3 }, 1, "brir"),
+				graphNode(NodeType::hearingAid, { 4 }, 0, "left"),
+				graphNode(NodeType::hearingAid, { 5 }, 1, "right"),
+				graphNode(NodeType::mix, { 6, 7 }, 0),
+				graphNode(NodeType::output, { 8 }, 0),
+				graphNode(NodeType::output, { 7 }, 1)
+			});
+		}
+
+		void prepareDeviceBuffers() {
+			const auto parameters = device.streamParameters();
+			deviceBuffers.assign(
+				parameters.channels,
+				std::vector<sample_type>(parameters.framesPerBuffer)
+			);
+			deviceChannels.clear();
+			for (auto &buffer : deviceBuffers)
+				deviceChannels.push_back(buffer.data());
+		}
+
+		void assertCallbacksAllocationFree() {
+			prepareDeviceBuffers();
+			const auto frames = device.streamParameters().framesPerBuffer;
+			assertAllocationFree([&]() {
+				for (int i = 0; i < 1000 && !device.complete(); ++i)
+					device.fillStreamBuffer(deviceChannels.data(), frames);
+			});
+			assertTrue(device.complete());
+		}
+
+		void assertTrialsAllocationFree(ProcessingGroupFactory *groupFactory) {
+			auto model = makeModel(groupFactory);
+			model->prepareNewTest(testing);
+			for (int i = 0; i < 2; ++i) {
+				model->playNextTrial(trial);
+				assertCallbacksAllocationFree();
+			}
+		}
+
+		void assertTrialsAllocationFree() {
+			assertTrialsAllocationFree(&sequentialGroupFactory);
+			assertTrialsAllocationFree(&parallelGroupFactory);
+		}
+	};
+
+	TEST_F(RealTimeAllocationTests, noSimulation) {
+		assertTrialsAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, spatialization) {
+		setSpatialization();
+		assertTrialsAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, hearingAidSimulation) {
+		setHearingAidSimulation();
+		assertTrialsAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, hearingAidSimulationWithDifferentEars) {
+		setHearingAidSimulation();
+		auto right = prescription();
+		right.compressionRatios = { 2, 3 };
+		prescriptionReader.addPrescription("right", right);
+		assertTrialsAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, fullSimulation) {
+		setSpatialization();
+		setHearingAidSimulation();
+		assertTrialsAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, processingGraph) {
+		setProcessingGraph();
+		assertTrialsAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, noSimulationOnSmallDeviceBuffers) {
+		framesPerDeviceBuffer = 64;
+		assertTrialsAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, fullSimulationOnSmallDeviceBuffers) {
+		framesPerDeviceBuffer = 96;
+		setSpatialization();
+		setHearingAidSimulation();
+		assertTrialsAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, calibration) {
+		setSpatialization();
+		setHearingAidSimulation();
+		calibration.processing = testing.processing;
+		auto model = makeModel(&parallelGroupFactory);
+		model->playCalibration(calibration);
+		assertCallbacksAllocationFree();
+	}
+
+	TEST_F(RealTimeAllocationTests, calibrationLevelChangedWhilePlaying) {
+		calibration.processing = testing.processing;
+		auto model = makeModel(&parallelGroupFactory);
+		model->playCalibration(calibration);
+		device.setStreaming();
+		calibration.level_dB_Spl = 70;
+		model->playCalibration(calibration);
+		assertCallbacksAllocationFree();
+		assertFalse(device.streamStopped());
+	}
+
+	TEST_F(RealTimeAllocationTests, calibrationChainReplacedWhilePlaying) {
+		setHearingAidSimulation();
+		calibration.processing = testing.processing;
+		auto model = makeModel(&parallelGroupFactory);
+		model->playCalibration(calibration);
+		device.setStreaming();
+		calibration.level_dB_Spl = 70;
+		model->playCalibration(calibration);
+		calibration.processing.release_ms = calibration.processing.release_ms + 1;
+		model->playCalibration(calibration);
+		assertCallbacksAllocationFree();
+		assertFalse(device.streamStopped());
+		model->stopCalibration();
+	}
+
+	TEST(AllocationFreeRegionTests, countsAllocationsInsideRegion) {
+		AllocationFreeRegion region{};
+		const auto allocated = ::operator new(1);
+		::operator delete(allocated);
+		assertEqual(1LL, region.allocations());
+	}
+
+	TEST(AllocationFreeRegionTests, ignoresAllocationsOutsideRegion) {
+		const auto allocated = ::operator new(1);
+		AllocationFreeRegion region{};
+		::operator delete(allocated);
+		assertEqual(0LL, region.allocations());
+	}
+}
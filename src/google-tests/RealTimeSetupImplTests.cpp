@@ -0,0 +1,135 @@
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/RealTimeSetupImpl.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class RealTimeHostStub : public RealTimeHost {
+		std::vector<int> pinnedCores_{};
+		int denormalsFlushed_{};
+		int prioritiesRaised_{};
+		int memoryLocks_{};
+		bool succeeding_{ true };
+	public:
+		void setFailing() noexcept {
+			succeeding_ = false;
+		}
+
+		bool flushDenormals() override {
+			++denormalsFlushed_;
+			return succeeding_;
+		}
+
+		bool raisePriority() override {
+			++prioritiesRaised_;
+			return succeeding_;
+		}
+
+		bool pinToCore(int core) override {
+			pinnedCores_.push_back(core);
+			return succeeding_;
+		}
+
+		bool lockMemory() override {
+			++memoryLocks_;
+			return succeeding_;
+		}
+
+		auto pinnedCores() const {
+			return pinnedCores_;
+		}
+
+		auto denormalsFlushed() const noexcept {
+			return denormalsFlushed_;
+		}
+
+		auto prioritiesRaised() const noexcept {
+			return prioritiesRaised_;
+		}
+
+		auto memoryLocks() const noexcept {
+			return memoryLocks_;
+		}
+	};
+
+	class RealTimeSetupImplTests : public ::testing::Test {
+	protected:
+		RealTimeHostStub host{};
+		RealTimeSetupImpl::Settings settings{};
+
+		RealTimeSetupImpl construct() {
+			return { &host, settings };
+		}
+	};
+
+	TEST_F(RealTimeSetupImplTests, configuresDenormalsAndPriorityByDefault) {
+		auto setup = construct();
+		setup.configureCurrentThread();
+		assertEqual(1, host.denormalsFlushed());
+		assertEqual(1, host.prioritiesRaised());
+		assertTrue(host.pinnedCores().empty());
+	}
+
+	TEST_F(RealTimeSetupImplTests, skipsStepsNotSet) {
+		settings.flushDenormals = false;
+		settings.raisePriority = false;
+		auto setup = construct();
+		setup.configureCurrentThread();
+		assertEqual(0, host.denormalsFlushed());
+		assertEqual(0, host.prioritiesRaised());
+	}
+
+	TEST_F(RealTimeSetupImplTests, pinsThreadsToCoresInTurn) {
+		settings.cores = { 2, 3 };
+		auto setup = construct();
+		setup.configureCurrentThread();
+		setup.configureCurrentThread();
+		setup.configureCurrentThread();
+		assertEqual({ 2, 3, 2 }, host.pinnedCores());
+	}
+
+	TEST_F(RealTimeSetupImplTests, locksMemoryOnlyWhenSet) {
+		auto setup = construct();
+		setup.lockMemory();
+		assertEqual(0, host.memoryLocks());
+		settings.lockMemory = true;
+		auto locking = construct();
+		locking.lockMemory();
+		assertEqual(1, host.memoryLocks());
+	}
+
+	TEST_F(RealTimeSetupImplTests, reportCountsAttemptsAndSuccesses) {
+		settings.cores = { 0 };
+		settings.lockMemory = true;
+		auto setup = construct();
+		setup.configureCurrentThread();
+		host.setFailing();
+		setup.configureCurrentThread();
+		setup.lockMemory();
+		auto report = setup.report();
+		assertEqual(2, report.denormalsFlushed.attempts);
+		assertEqual(1, report.denormalsFlushed.successes);
+		assertEqual(2, report.priorityRaised.attempts);
+		assertEqual(1, report.priorityRaised.successes);
+		assertEqual(2, report.pinnedToCore.attempts);
+		assertEqual(1, report.pinnedToCore.successes);
+		assertEqual(1, report.memoryLocked.attempts);
+		assertEqual(0, report.memoryLocked.successes);
+	}
+
+	TEST_F(RealTimeSetupImplTests, summaryListsSuccessesOfAttempts) {
+		settings.lockMemory = true;
+		auto setup = construct();
+		setup.configureCurrentThread();
+		host.setFailing();
+		setup.lockMemory();
+		assertEqual(
+			std::string{
+				"denormals flushed: 1 of 1\n"
+				"priority raised: 1 of 1\n"
+				"pinned to core: 0 of 0\n"
+				"memory locked: 0 of 1\n"
+			},
+			setup.summary()
+		);
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/RealTimeSetup.h>
+#include <atomic>
+
+class RealTimeSetupStub : public RealTimeSetup {
+	std::atomic<int> threadsConfigured_{ 0 };
+	int memoryLocks_{};
+public:
+	void configureCurrentThread() override {
+		++threadsConfigured_;
+	}
+
+	void lockMemory() override {
+		++memoryLocks_;
+	}
+
+	int threadsConfigured() const noexcept {
+		return threadsConfigured_;
+	}
+
+	int memoryLocks() const noexcept {
+		return memoryLocks_;
+	}
+};
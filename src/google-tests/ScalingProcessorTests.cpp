@@ -16,6 +16,14 @@ namespace {
 		assertEqual({ 1 * 0.5, 2 * 0.5, 3 * 0.5 }, x);
 	}
 
+	TEST_F(ScalingProcessorTests, setScaleReplacesScalar) {
+		ScalingProcessor<float> processor{ 0.5 };
+		processor.setScale(2);
+		buffer_type x{ 1, 2, 3 };
+		processor.process(x);
+		assertEqual({ 1 * 2, 2 * 2, 3 * 2 }, x);
+	}
+
 	TEST_F(ScalingProcessorTests, groupDelayReturnsZero) {
 		ScalingProcessor<float> processor{ {} };
 		using index_type = typename ScalingProcessor<float>::index_type;
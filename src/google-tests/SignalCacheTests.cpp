@@ -0,0 +1,109 @@
+#include "SignalStoreStub.h"
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/SignalCache.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class SignalCacheTests : public ::testing::Test {
+	protected:
+		using channels_type = SignalCache::channels_type;
+		SignalStoreStub store{};
+		std::size_t budget{ 4 * sizeof(float) };
+
+		std::unique_ptr<SignalCache> construct() {
+			return std::make_unique<SignalCache>(&store, budget);
+		}
+	};
+
+	TEST_F(SignalCacheTests, findReturnsNullWhenNothingInserted) {
+		auto cache = construct();
+		assertTrue(cache->find("a") == nullptr);
+	}
+
+	TEST_F(SignalCacheTests, findReturnsInsertedSignal) {
+		auto cache = construct();
+		cache->insert("a", { { 1, 2 }, { 3, 4 } });
+		auto found = cache->find("a");
+		assertEqual({ 1, 2 }, found->at(0));
+		assertEqual({ 3, 4 }, found->at(1));
+	}
+
+	TEST_F(SignalCacheTests, insertReplacesSignalUnderSameKey) {
+		auto cache = construct();
+		cache->insert("a", { { 1 } });
+		cache->insert("a", { { 2, 3 } });
+		assertEqual({ 2, 3 }, cache->find("a")->at(0));
+		assertEqual(2 * sizeof(float), cache->residentBytes());
+	}
+
+	TEST_F(SignalCacheTests, signalsWithinBudgetStayInMemory) {
+		auto cache = construct();
+		cache->insert("a", { { 1, 2 } });
+		cache->insert("b", { { 3, 4 } });
+		assertTrue(cache->resident("a"));
+		assertTrue(cache->resident("b"));
+		assertTrue(store.saved().empty());
+	}
+
+	TEST_F(SignalCacheTests, leastRecentlyUsedSpillsWhenOverBudget) {
+		auto cache = construct();
+		cache->insert("a", { { 1, 2 } });
+		cache->insert("b", { { 3, 4 } });
+		cache->find("a");
+		cache->insert("c", { { 5, 6 } });
+		assertTrue(cache->resident("a"));
+		assertFalse(cache->resident("b"));
+		assertTrue(cache->resident("c"));
+		assertEqual(4 * sizeof(float), cache->residentBytes());
+	}
+
+	TEST_F(SignalCacheTests, spilledSignalLoadsFromStore) {
+		auto cache = construct();
+		cache->insert("a", { { 1, 2 }, { 3 } });
+		cache->insert("b", { { 4, 5, 6 } });
+		assertFalse(cache->resident("a"));
+		auto found = cache->find("a");
+		assertEqual({ 1, 2 }, found->at(0));
+		assertEqual({ 3 }, found->at(1));
+		assertEqual(std::size_t{ 2 }, store.loaded().size());
+	}
+
+	TEST_F(SignalCacheTests, signalSavedOnceAcrossSpills) {
+		auto cache = construct();
+		cache->insert("a", { { 1, 2, 3 } });
+		cache->insert("b", { { 4, 5, 6 } });
+		cache->find("a");
+		cache->find("b");
+		assertEqual(std::size_t{ 2 }, store.saved().size());
+	}
+
+	TEST_F(SignalCacheTests, signalLargerThanBudgetStillReturned) {
+		auto cache = construct();
+		auto inserted = cache->insert("a", { { 1, 2, 3, 4, 5 } });
+		assertFalse(cache->resident("a"));
+		assertEqual({ 1, 2, 3, 4, 5 }, inserted->at(0));
+		assertEqual(std::size_t{ 0 }, cache->residentBytes());
+	}
+
+	TEST_F(SignalCacheTests, fitsOnlySignalsWithinBudget) {
+		auto cache = construct();
+		assertTrue(cache->fits(4 * sizeof(float)));
+		assertFalse(cache->fits(5 * sizeof(float)));
+	}
+
+	TEST_F(SignalCacheTests, destructionRemovesStoredSignals) {
+		auto cache = construct();
+		cache->insert("a", { { 1, 2, 3 } });
+		cache->insert("b", { { 4, 5, 6 } });
+		cache.reset();
+		assertEqual(std::size_t{ 0 }, store.stored());
+	}
+
+	TEST_F(SignalCacheTests, replacingSpilledSignalRemovesStoredCopy) {
+		auto cache = construct();
+		cache->insert("a", { { 1, 2, 3 } });
+		cache->insert("b", { { 4, 5, 6 } });
+		cache->insert("a", { { 7 } });
+		assertEqual("0-0", store.removed().at(0));
+	}
+}
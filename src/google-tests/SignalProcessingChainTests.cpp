@@ -37,4 +37,31 @@ namespace {
 		using index_type = typename SignalProcessingChain::index_type;
 		assertEqual(index_type{ 1 + 2 + 3 }, chain.groupDelay());
 	}
+
+	TEST_F(SignalProcessingChainTests, resetResetsEachComponent) {
+		auto processor2 = std::make_shared<SignalProcessorStub>();
+		chain.add(processor2);
+		chain.reset();
+		assertEqual(1, processor->resets());
+		assertEqual(1, processor2->resets());
+	}
+
+	TEST_F(SignalProcessingChainTests, addScalableProcessesInOrder) {
+		chain.addScalable(std::make_shared<AddsSamplesBy>(1.0f));
+		chain.add(std::make_shared<MultipliesSamplesBy>(2.0f));
+		buffer_type x = { 1, 2, 3 };
+		chain.process(x);
+		assertEqual({ 4, 6, 8 }, x);
+	}
+
+	TEST_F(SignalProcessingChainTests, setScalePassesScaleOnlyToScalableComponents) {
+		auto processor2 = std::make_shared<SignalProcessorStub>();
+		auto processor3 = std::make_shared<SignalProcessorStub>();
+		chain.addScalable(processor2);
+		chain.addScalable(processor3);
+		chain.setScale(2);
+		assertEqual(0.0f, processor->scale());
+		assertEqual(2.0f, processor2->scale());
+		assertEqual(2.0f, processor3->scale());
+	}
 }
@@ -5,8 +5,10 @@
 
 class SignalProcessorStub : public SignalProcessor {
 	std::vector<signal_type::element_type> processed_{};
+	float scale_{};
 	int samples_{};
 	int groupDelay_{};
+	int resets_{};
 public:
 	void process(signal_type signal) override {
 		std::copy(signal.begin(), signal.end(), std::back_inserter(processed_));
@@ -23,6 +25,22 @@ public:
 	index_type groupDelay() override {
 		return groupDelay_;
 	}
+
+	void reset() override {
+		++resets_;
+	}
+
+	auto resets() const noexcept {
+		return resets_;
+	}
+
+	void setScale(float s) override {
+		scale_ = s;
+	}
+
+	auto scale() const noexcept {
+		return scale_;
+	}
 };
 
 class AddsSamplesBy : public SignalProcessor {
@@ -36,6 +54,8 @@ public:
 	}
 
 	index_type groupDelay() override { return {}; }
+	void reset() override {}
+	void setScale(float) override {}
 };
 
 class MultipliesSamplesBy : public SignalProcessor {
@@ -49,4 +69,6 @@ public:
 	}
 
 	index_type groupDelay() override { return {}; }
+	void reset() override {}
+	void setScale(float) override {}
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ArgumentCollection.h"
+#include <spatialized-hearing-aid-simulation/SignalStore.h>
+#include <vector>
+#include <map>
+
+class SignalStoreStub : public SignalStore {
+	std::map<std::string, std::vector<float>> signals_{};
+	ArgumentCollection<std::string> saved_{};
+	ArgumentCollection<std::string> loaded_{};
+	ArgumentCollection<std::string> removed_{};
+public:
+	void save(std::string name, gsl::span<const float> signal) override {
+		saved_.push_back(name);
+		signals_[std::move(name)] = { signal.begin(), signal.end() };
+	}
+
+	void load(std::string name, signal_type signal) override {
+		loaded_.push_back(name);
+		const auto &stored = signals_.at(std::move(name));
+		std::copy(stored.begin(), stored.end(), signal.begin());
+	}
+
+	void remove(std::string name) override {
+		removed_.push_back(name);
+		signals_.erase(std::move(name));
+	}
+
+	auto saved() const {
+		return saved_;
+	}
+
+	auto loaded() const {
+		return loaded_;
+	}
+
+	auto removed() const {
+		return removed_;
+	}
+
+	auto stored() const {
+		return signals_.size();
+	}
+};
+
+class FailingSignalStore : public SignalStore {
+	std::string errorMessage{};
+public:
+	void setErrorMessage(std::string s) {
+		errorMessage = std::move(s);
+	}
+
+	void save(std::string, gsl::span<const float>) override {
+		throw StoreFailure{ errorMessage };
+	}
+
+	void load(std::string, signal_type) override {
+		throw StoreFailure{ errorMessage };
+	}
+
+	void remove(std::string) override {}
+};
@@ -226,6 +226,22 @@ namespace {
 		assertEqual({ (4 + 1) * 2.0f }, x);
 	}
 
+	TEST_F(
+		SimulationChannelFactoryImplTests,
+		makeFullSimulationPassesScaleOnlyToScalarProcessor
+	) {
+		auto scalar = std::make_shared<SignalProcessorStub>();
+		auto filter = std::make_shared<SignalProcessorStub>();
+		auto hearingAid = std::make_shared<SignalProcessorStub>();
+		scalarFactory.setProcessor(scalar);
+		firFilterFactory.setProcessor(filter);
+		hearingAidFactory.setProcessor(hearingAid);
+		simulationFactory.makeFullSimulation({}, {})->setScale(2);
+		assertEqual(2.0f, scalar->scale());
+		assertEqual(0.0f, filter->scale());
+		assertEqual(0.0f, hearingAid->scale());
+	}
+
 	TEST_F(
 		SimulationChannelFactoryImplTests,
 		makeWithoutSimulationReturnsScalarProcessor
@@ -4,20 +4,45 @@
 #include "AudioLoaderStub.h"
 #include "PrescriptionReaderStub.h"
 #include "BrirReaderStub.h"
+#include "ProcessingGraphReaderStub.h"
 #include "FakeAudioFile.h"
 #include "SignalProcessorStub.h"
 #include "AudioPlayerStub.h"
 #include "FakeStimulusList.h"
+#include "RealTimeSetupStub.h"
 #include "DocumenterStub.h"
+#include "FileVersionsStub.h"
 #include "CalibrationComputerStub.h"
 #include "SpatializedHearingAidSimulationFactoryStub.h"
 #include "AudioFrameWriterStub.h"
+#include "SignalStoreStub.h"
+#include "StimulusCacheStub.h"
+#include "TaskRunnerStub.h"
+#include "TemporaryFilesStub.h"
 #include "assert-utility.h"
 #include <audio-file-reading-writing/AudioFileInMemory.h>
+#include <spatialized-hearing-aid-simulation/ChannelProcessingGroup.h>
 #include <spatialized-hearing-aid-simulation/SpatialHearingAidModel.h>
 #include <gtest/gtest.h>
 
 namespace {
+	class ProcessingGroupFactorySpy : public ProcessingGroupFactory {
+		ChannelProcessingGroupFactory groups{};
+		std::vector<RealTimeSetup *> realTimes_{};
+	public:
+		std::shared_ptr<AudioFrameProcessor> make(
+			processing_group_type group,
+			RealTimeSetup *realTime
+		) override {
+			realTimes_.push_back(realTime);
+			return groups.make(std::move(group), realTime);
+		}
+
+		auto realTimes() const {
+			return realTimes_;
+		}
+	};
+
 	class UseCase {
 	public:
         INTERFACE_OPERATIONS(UseCase)
@@ -52,6 +77,8 @@ namespace {
 		virtual void setLeftDslPrescriptionFilePath(std::string) = 0;
 		virtual void setRightDslPrescriptionFilePath(std::string) = 0;
 		virtual void setBrirFilePath(std::string) = 0;
+		virtual void setProcessingGraphOn() = 0;
+		virtual void setProcessingGraphFilePath(std::string) = 0;
 	};
 
 	class SignalProcessingWithLevelUseCase :
@@ -106,6 +133,26 @@ namespace {
 		p.brirFilePath = std::move(s);
 	}
 
+	void setProcessingGraphOn(Model::SignalProcessing &p) noexcept {
+		p.usingProcessingGraph = true;
+	}
+
+	void setProcessingGraphFilePath(Model::SignalProcessing &p, std::string s) {
+		p.processingGraphFilePath = std::move(s);
+	}
+
+	ProcessingGraphReader::Node graphNode(
+		ProcessingGraphReader::NodeType type,
+		std::vector<int> inputs = {},
+		std::string filePath = {}
+	) {
+		ProcessingGraphReader::Node node{};
+		node.type = type;
+		node.inputs = std::move(inputs);
+		node.filePath = std::move(filePath);
+		return node;
+	}
+
 	class PreparingNewTest : public SignalProcessingUseCase {
 		SpatialHearingAidModel::Testing testing{};
 	public:
@@ -157,6 +204,14 @@ namespace {
 			::setBrirFilePath(testing.processing, std::move(s));
 		}
 
+		void setProcessingGraphOn() override {
+			::setProcessingGraphOn(testing.processing);
+		}
+
+		void setProcessingGraphFilePath(std::string s) override {
+			::setProcessingGraphFilePath(testing.processing, std::move(s));
+		}
+
 		void setTestFilePath(std::string s) {
 			testing.testFilePath = std::move(s);
 		}
@@ -242,6 +297,14 @@ namespace {
 		void setBrirFilePath(std::string s) override {
 			preparingNewTest.setBrirFilePath(std::move(s));
 		}
+
+		void setProcessingGraphOn() override {
+			preparingNewTest.setProcessingGraphOn();
+		}
+
+		void setProcessingGraphFilePath(std::string s) override {
+			preparingNewTest.setProcessingGraphFilePath(std::move(s));
+		}
 	};
 
 	class PlayingCalibration : public SignalProcessingUseCase, public AudioFileUseCase, public PlayingAudioUseCase {
@@ -299,6 +362,14 @@ namespace {
 			::setBrirFilePath(calibration.processing, std::move(s));
 		}
 
+		void setProcessingGraphOn() override {
+			::setProcessingGraphOn(calibration.processing);
+		}
+
+		void setProcessingGraphFilePath(std::string s) override {
+			::setProcessingGraphFilePath(calibration.processing, std::move(s));
+		}
+
 		void setAudioFilePath(std::string s) override {
 			calibration.audioFilePath = std::move(s);
 		}
@@ -363,6 +434,14 @@ namespace {
 			::setBrirFilePath(savingAudio.processing, std::move(s));
 		}
 
+		void setProcessingGraphOn() override {
+			::setProcessingGraphOn(savingAudio.processing);
+		}
+
+		void setProcessingGraphFilePath(std::string s) override {
+			::setProcessingGraphFilePath(savingAudio.processing, std::move(s));
+		}
+
 		void setAudioFilePath(std::string s) override {
 			savingAudio.inputAudioFilePath = std::move(s);
 		}
@@ -391,6 +470,7 @@ namespace {
 		SpatialHearingAidModel::SavingAudio savingAudio{};
 		PrescriptionReaderStub prescriptionReader{};
 		BrirReaderStub brirReader{};
+		ProcessingGraphReaderStub graphReader{};
 		FakeStimulusList stimulusList{};
 		DocumenterStub documenter{};
 		std::shared_ptr<AudioFrameReaderStub> audioFrameReader
@@ -407,17 +487,36 @@ namespace {
 		std::shared_ptr<CalibrationComputerStub> calibrationComputer =
 			std::make_shared<CalibrationComputerStub>();
 		CalibrationComputerStubFactory calibrationComputerFactory{ calibrationComputer };
+		ProcessingGroupFactorySpy groupFactory{};
+		RealTimeSetupStub realTime{};
+		SignalStoreStub spillStore{};
+		SignalCache renderedStimuli{ &spillStore, 1 << 20 };
+		TaskRunnerStub backgroundTasks{};
+		TaskRunnerStub preloading{};
+		TemporaryFilesStub temporaryFiles{};
+		StimulusCacheStub stimulusCache{};
+		FileVersionsStub fileVersions{};
 		SpatialHearingAidModel model{
 			&stimulusList,
 			&documenter,
 			&audioPlayer,
 			&audioLoaderFactory,
+			&audioLoaderFactory,
 			&audioFrameReaderFactory,
 			&audioFrameWriterFactory,
 			&prescriptionReader,
 			&brirReader,
+			&graphReader,
 			&simulationFactory,
-			&calibrationComputerFactory
+			&calibrationComputerFactory,
+			&groupFactory,
+			&renderedStimuli,
+			&backgroundTasks,
+			&temporaryFiles,
+			&realTime,
+			&stimulusCache,
+			&fileVersions,
+			&preloading
 		};
 		
 		PreparingNewTest preparingNewTest{};
@@ -913,6 +1012,29 @@ namespace {
 			assertEqual("a", brirReader.filePath());
 		}
 
+		void assertGraphReaderReceivesFilePathWhenUsingProcessingGraph(
+			SignalProcessingUseCase *useCase
+		) {
+			useCase->setProcessingGraphOn();
+			useCase->setProcessingGraphFilePath("a");
+			runUseCase(useCase);
+			assertEqual("a", graphReader.filePath());
+		}
+
+		void assertGraphNodesReadTheirFiles(SignalProcessingUseCase *useCase) {
+			using NodeType = ProcessingGraphReader::NodeType;
+			graphReader.setNodes({
+				graphNode(NodeType::input),
+				graphNode(NodeType::fir, { 0 }, "a"),
+				graphNode(NodeType::hearingAid, { 1 }, "b"),
+				graphNode(NodeType::output, { 2 })
+			});
+			useCase->setProcessingGraphOn();
+			runUseCase(useCase);
+			assertEqual("a", brirReader.filePath());
+			assertTrue(prescriptionReader.filePaths().contains("b"));
+		}
+
 		void assertAudioReaderFactoryReceivesFilePath(
 			AudioFileUseCase *useCase
 		) {
@@ -1089,6 +1211,36 @@ namespace {
 		assertBrirReaderReceivesFilePathWhenUsingSpatialization(&processingAudioForSaving);
 	}
 
+	TEST_F(
+		SpatialHearingAidModelTests,
+		prepareNewTestPassesProcessingGraphFilePathToReaderWhenUsingProcessingGraph
+	) {
+		assertGraphReaderReceivesFilePathWhenUsingProcessingGraph(&preparingNewTest);
+	}
+
+	TEST_F(
+		SpatialHearingAidModelTests,
+		playCalibrationPassesProcessingGraphFilePathToReaderWhenUsingProcessingGraph
+	) {
+		assertGraphReaderReceivesFilePathWhenUsingProcessingGraph(&playingCalibration);
+	}
+
+	TEST_F(
+		SpatialHearingAidModelTests,
+		processAudioForSavingPassesProcessingGraphFilePathToReaderWhenUsingProcessingGraph
+	) {
+		assertGraphReaderReceivesFilePathWhenUsingProcessingGraph(&processingAudioForSaving);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestReadsProcessingGraphNodeFiles) {
+		assertGraphNodesReadTheirFiles(&preparingNewTest);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestDoesNotReadProcessingGraphWhenNotUsingIt) {
+		runUseCase(&preparingNewTest);
+		assertFalse(graphReader.readCalled());
+	}
+
 	TEST_F(SpatialHearingAidModelTests, prepareNewTestDoesNotReadBrirWhenNotUsingSpatialization) {
 		assertBrirReaderDoesNotReadWhenNotUsingSpatialization(&preparingNewTest);
 	}
@@ -1113,6 +1265,13 @@ namespace {
 		assertAudioReaderFactoryReceivesFilePath(&playingCalibration);
 	}
 
+	TEST_F(SpatialHearingAidModelTests, playCalibrationMeasuresEachFileOnce) {
+		playingCalibration.setAudioFilePath("a");
+		runUseCase(&playingCalibration);
+		runUseCase(&playingCalibration);
+		assertEqual(1, calibrationComputerFactory.made());
+	}
+
 	TEST_F(SpatialHearingAidModelTests, processAudioForSavingPassesAudioFileToFactory) {
 		assertAudioReaderFactoryReceivesFilePath(&processingAudioForSaving);
 	}
@@ -1217,8 +1376,22 @@ namespace {
 		assertScalarsMatchCalibrationWhenUsingOnlyHearingAidSimulation(&processingAudioForSaving);
 	}
 
-	TEST_F(SpatialHearingAidModelTests, playTrialComputesCalibrationScalarsForSpatialization) {
-		assertScalarsMatchCalibrationWhenUsingOnlySpatialization(&playingFirstTrialOfNewTest);
+	TEST_F(SpatialHearingAidModelTests, playTrialRendersSpatializationAtUnitGain) {
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		audioFrameReader->setChannels(2);
+		calibrationComputer->addSignalScale(0, 3.3);
+		calibrationComputer->addSignalScale(1, 4.4);
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(1.0f, simulationFactory.spatializationScale().at(0));
+		assertEqual(1.0f, simulationFactory.spatializationScale().at(1));
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialComputesCalibrationScalarsForRenderedSpatialization) {
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		assertScalarsMatchCalibration(
+			&playingFirstTrialOfNewTest,
+			simulationFactory.withoutSimulationScale()
+		);
 	}
 
 	TEST_F(SpatialHearingAidModelTests, playCalibrationComputesCalibrationScalarsForSpatialization) {
@@ -1467,8 +1640,638 @@ namespace {
 		assertAudioLoaderAppliesSimulationWhenPlayerPlaysWhenUsingOnlyHearingAidSimulation(&playingCalibration);
 	}
 
-	TEST_F(SpatialHearingAidModelTests, playTrialAssignsSpatializationProcessorsToAudioLoader) {
-		assertAudioLoaderAppliesSimulationWhenPlayerPlaysWhenUsingOnlySpatialization(&playingFirstTrialOfNewTest);
+	TEST_F(SpatialHearingAidModelTests, playTrialMakesOneHearingAidSimulationForIdenticalEars) {
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		calibrationComputer->setChannelsEqual();
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(std::size_t{ 1 }, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialFansOutHearingAidSimulationForIdenticalEars) {
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		calibrationComputer->setChannelsEqual();
+		simulationFactory.setHearingAidSimulationProcessors({
+			std::make_shared<MultipliesSamplesBy>(2.0f)
+		});
+		buffer_type left = { 5 };
+		buffer_type right = { 5 };
+		std::vector<channel_type> channels = { left, right };
+		processWhenPlayerPlays(channels);
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual({ 5 * 2 }, left);
+		assertEqual({ 5 * 2 }, right);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialMakesHearingAidSimulationPerEarForDifferentChannels) {
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(std::size_t{ 2 }, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialMakesHearingAidSimulationPerEarForDifferentPrescriptions) {
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		calibrationComputer->setChannelsEqual();
+		PrescriptionReader::Dsl right{};
+		right.channels = 1;
+		prescriptionReader.addPrescription("b", right);
+		playingFirstTrialOfNewTest.setRightDslPrescriptionFilePath("b");
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(std::size_t{ 2 }, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialMakesHearingAidSimulationPerEarForDifferentScales) {
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		calibrationComputer->setChannelsEqual();
+		calibrationComputer->addSignalScale(0, 1);
+		calibrationComputer->addSignalScale(1, 2);
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(std::size_t{ 2 }, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestBeginsArenaForChannels) {
+		prepareNewTest();
+		assertEqual(1, simulationFactory.arenasBegun());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialDoesNotBeginArena) {
+		stimulusList.setContents({ "a", "b" });
+		runUseCase(&playingFirstTrialOfNewTest);
+		playNextTrial();
+		assertEqual(1, simulationFactory.arenasBegun());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationBeginsArenaForChannels) {
+		runUseCase(&playingCalibration);
+		assertEqual(1, simulationFactory.arenasBegun());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingBeginsArenaForChannels) {
+		processAudioForSaving();
+		assertEqual(1, simulationFactory.arenasBegun());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialMakesHearingAidSimulationOncePerTest) {
+		stimulusList.setContents({ "a", "b", "c" });
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		playNextTrial();
+		playNextTrial();
+		assertEqual(std::size_t{ 2 }, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialMakesFullSimulationOncePerTest) {
+		stimulusList.setContents({ "a", "b", "c" });
+		setFullSimulation(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		playNextTrial();
+		playNextTrial();
+		assertEqual(std::size_t{ 2 }, simulationFactory.fullSimulationHearingAid().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialMakesProcessingGraphHearingAidOncePerTest) {
+		using NodeType = ProcessingGraphReader::NodeType;
+		stimulusList.setContents({ "a", "b", "c" });
+		graphReader.setNodes({
+			graphNode(NodeType::input),
+			graphNode(NodeType::hearingAid, { 0 }, "a"),
+			graphNode(NodeType::output, { 1 })
+		});
+		playingFirstTrialOfNewTest.setProcessingGraphOn();
+		runUseCase(&playingFirstTrialOfNewTest);
+		playNextTrial();
+		playNextTrial();
+		assertEqual(std::size_t{ 1 }, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialResetsAndRescalesReusedProcessingGraph) {
+		using NodeType = ProcessingGraphReader::NodeType;
+		stimulusList.setContents({ "a", "b" });
+		graphReader.setNodes({
+			graphNode(NodeType::input),
+			graphNode(NodeType::scale, { 0 }),
+			graphNode(NodeType::hearingAid, { 1 }, "a"),
+			graphNode(NodeType::output, { 2 })
+		});
+		auto scale = std::make_shared<SignalProcessorStub>();
+		auto hearingAid = std::make_shared<SignalProcessorStub>();
+		simulationFactory.setWithoutSimulationProcessors({ scale });
+		simulationFactory.setHearingAidSimulationProcessors({ hearingAid });
+		playingFirstTrialOfNewTest.setProcessingGraphOn();
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(0, hearingAid->resets());
+		calibrationComputer->addSignalScale(0, 3);
+		playNextTrial();
+		assertEqual(1, hearingAid->resets());
+		assertEqual(3.0f, scale->scale());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestMakesHearingAidSimulationAgain) {
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(std::size_t{ 4 }, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialMakesHearingAidSimulationAgainForAnotherSampleRate) {
+		stimulusList.setContents({ "a", "b" });
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		audioFrameReader->setSampleRate(1);
+		playNextTrial();
+		assertEqual(std::size_t{ 4 }, simulationFactory.hearingAidSimulation().size());
+		assertEqual(1, simulationFactory.hearingAidSimulation().at(2).sampleRate);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialResetsReusedHearingAidSimulation) {
+		stimulusList.setContents({ "a", "b" });
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		auto left = std::make_shared<SignalProcessorStub>();
+		auto right = std::make_shared<SignalProcessorStub>();
+		simulationFactory.setHearingAidSimulationProcessors({ left, right });
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(0, left->resets());
+		playNextTrial();
+		assertEqual(1, left->resets());
+		assertEqual(1, right->resets());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialRescalesReusedHearingAidSimulation) {
+		stimulusList.setContents({ "a", "b" });
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		auto left = std::make_shared<SignalProcessorStub>();
+		auto right = std::make_shared<SignalProcessorStub>();
+		simulationFactory.setHearingAidSimulationProcessors({ left, right });
+		runUseCase(&playingFirstTrialOfNewTest);
+		calibrationComputer->addSignalScale(0, 3);
+		calibrationComputer->addSignalScale(1, 4);
+		playNextTrial();
+		assertEqual(3.0f, left->scale());
+		assertEqual(4.0f, right->scale());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialPassesReusedHearingAidSimulationToAudioLoader) {
+		stimulusList.setContents({ "a", "b" });
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		auto first = audioLoaderFactory.audioFrameProcessor();
+		playNextTrial();
+		assertTrue(first == audioLoaderFactory.audioFrameProcessor());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialAssignsGainForRenderedSpatializationToAudioLoader) {
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		assertAudioLoaderAppliesSimulationWhenPlayerPlays(
+			&playingFirstTrialOfNewTest,
+			simulationFactory.withoutSimulationProcessors
+		);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialPassesRenderedSpatializationToAudioLoader) {
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		audioFrameReader->setChannels(2);
+		const auto frames = SpatialHearingAidModel::defaultFramesPerBuffer;
+		buffer_type rendered(2 * frames);
+		std::iota(rendered.begin(), rendered.end(), 0.0f);
+		auto fakeLoader = std::make_shared<FakeAudioLoader>();
+		fakeLoader->setAudioToLoad(rendered);
+		audioLoaderFactory.setLoader(fakeLoader);
+		runUseCase(&playingFirstTrialOfNewTest);
+		auto reader = audioLoaderFactory.audioFrameReader();
+		EXPECT_NE(audioFrameReader, reader);
+		buffer_type left(frames);
+		buffer_type right(frames);
+		std::vector<channel_type> channels{ left, right };
+		reader->read(channels);
+		assertEqual(0.0f, left.front());
+		assertEqual(frames - 1.0f, left.back());
+		assertEqual(frames + 0.0f, right.front());
+		assertEqual(2 * frames - 1.0f, right.back());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialRendersRepeatedStimulusOnce) {
+		stimulusList.setContents({ "a", "a", "a" });
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		playNextTrial();
+		assertEqual(std::size_t{ 2 }, simulationFactory.spatialization().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialRendersStimulusAgainForAnotherBrir) {
+		stimulusList.setContents({ "a", "a", "a" });
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		playingFirstTrialOfNewTest.setBrirFilePath("b");
+		runUseCase(&playingFirstTrialOfNewTest);
+		playingFirstTrialOfNewTest.setBrirFilePath("c");
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(std::size_t{ 4 }, simulationFactory.spatialization().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialRendersStimulusAgainForReplacedBrir) {
+		stimulusList.setContents({ "a", "a", "a" });
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		playingFirstTrialOfNewTest.setBrirFilePath("b");
+		fileVersions.setVersion("b", "1");
+		runUseCase(&playingFirstTrialOfNewTest);
+		fileVersions.setVersion("b", "2");
+		runUseCase(&playingFirstTrialOfNewTest);
+		assertEqual(std::size_t{ 4 }, simulationFactory.spatialization().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialRendersReplacedStimulusAgain) {
+		stimulusList.setContents({ "a", "b", "a" });
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		auto left = std::make_shared<SignalProcessorStub>();
+		auto right = std::make_shared<SignalProcessorStub>();
+		simulationFactory.setSpatializationProcessors({ left, right });
+		fileVersions.setVersion("a", "1");
+		runUseCase(&playingFirstTrialOfNewTest);
+		fileVersions.setVersion("a", "2");
+		playNextTrial();
+		const auto resets = left->resets();
+		playNextTrial();
+		EXPECT_LT(resets, left->resets());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationDoesNotRenderAhead) {
+		setSpatializationOnly(&playingCalibration);
+		runUseCase(&playingCalibration);
+		EXPECT_EQ(audioFrameReader, audioLoaderFactory.audioFrameReader());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialPreRendersNextStimulusInBackground) {
+		stimulusList.setContents({ "a", "b", "c" });
+		runUseCase(&playingFirstTrialOfNewTest);
+		backgroundTasks.runPendingTasks();
+		assertEqual("b", audioFrameReaderFactory.filePath());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialAwaitsPreRendering) {
+		runUseCase(&playingFirstTrialOfNewTest);
+		backgroundTasks.runPendingTasks();
+		const auto awaited = backgroundTasks.awaited();
+		playNextTrial();
+		assertEqual(awaited + 1, backgroundTasks.awaited());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestPreloadsWholeStimulusList) {
+		stimulusList.setContents({ "a", "b", "c" });
+		prepareNewTest();
+		preloading.runPendingTasks();
+		assertEqual<std::string>({ "a", "b", "c" }, stimulusCache.filePaths());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestPreloadsInBackground) {
+		prepareNewTest();
+		assertEqual(0, stimulusCache.preloads());
+		preloading.runPendingTasks();
+		assertEqual(1, stimulusCache.preloads());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestPreloadsApartFromPreRendering) {
+		prepareNewTest();
+		backgroundTasks.runPendingTasks();
+		assertEqual(0, stimulusCache.preloads());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationAndTrialsDoNotAwaitPreloading) {
+		prepareNewTest();
+		runUseCase(&playingCalibration);
+		playNextTrial();
+		assertEqual(0, preloading.awaited());
+		assertEqual(1, preloading.pendingTasks());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestReportsStimuliLoaded) {
+		stimulusList.setContents({ "a", "b" });
+		std::vector<int> loaded{};
+		testing.stimuliLoaded = [&](int n, int total) { 
+			loaded.push_back(n);
+			loaded.push_back(total);
+		};
+		prepareNewTest();
+		assertEqual({ 0, 2 }, loaded);
+		preloading.runPendingTasks();
+		assertEqual({ 0, 2, 1, 2, 2, 2 }, loaded);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, prepareNewTestAwaitsPreRendering) {
+		prepareNewTest();
+		assertEqual(1, backgroundTasks.awaited());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationAwaitsPreRendering) {
+		runUseCase(&playingCalibration);
+		assertEqual(1, backgroundTasks.awaited());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingAwaitsPreRendering) {
+		runUseCase(&processingAudioForSaving);
+		assertEqual(1, backgroundTasks.awaited());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, sweepParametersWritesEachPointBesideItsParameters) {
+		SpatialHearingAidModel::ParameterSweeping sweeping{};
+		sweeping.processing.usingHearingAidSimulation = true;
+		sweeping.inputAudioFilePath = "a/b.wav";
+		sweeping.outputDirectory = "c";
+		sweeping.attack_ms = { 1 };
+		sweeping.release_ms = { 2.5 };
+		model.sweepParameters(sweeping);
+		assertEqual("c/b_attack_1_release_2.5.wav", audioFrameWriterFactory.filePath());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, sweepParametersBuildsHearingAidForEveryPairing) {
+		SpatialHearingAidModel::ParameterSweeping sweeping{};
+		sweeping.processing.usingHearingAidSimulation = true;
+		sweeping.attack_ms = { 1, 2 };
+		sweeping.release_ms = { 3 };
+		audioFrameReader->setChannels(2);
+		model.sweepParameters(sweeping);
+		assertEqual(std::size_t{ 4 }, simulationFactory.hearingAidSimulation().size());
+		assertEqual(1.0, simulationFactory.hearingAidSimulation().at(0).attack_ms);
+		assertEqual(2.0, simulationFactory.hearingAidSimulation().at(2).attack_ms);
+		assertEqual(3.0, simulationFactory.hearingAidSimulation().at(2).release_ms);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, sweepParametersAwaitsPreRendering) {
+		SpatialHearingAidModel::ParameterSweeping sweeping{};
+		sweeping.processing.usingHearingAidSimulation = true;
+		model.sweepParameters(sweeping);
+		assertEqual(1, backgroundTasks.awaited());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, sweepParametersWithoutHearingAidSimulationThrowsRequestFailure) {
+		SpatialHearingAidModel::ParameterSweeping sweeping{};
+		sweeping.processing.usingSpatialization = true;
+		try {
+			model.sweepParameters(sweeping);
+			FAIL() << "Expected SpatialHearingAidModel::RequestFailure.";
+		}
+		catch (const SpatialHearingAidModel::RequestFailure &e) {
+			assertEqual(std::string{ "Sweeping parameters needs the hearing aid simulation." }, e.what());
+		}
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialDoesNotRenderStimulusPreRenderedForSpatialization) {
+		stimulusList.setContents({ "a", "b", "c" });
+		setSpatializationOnly(&playingFirstTrialOfNewTest);
+		runUseCase(&playingFirstTrialOfNewTest);
+		backgroundTasks.runPendingTasks();
+		const auto rendered = simulationFactory.spatialization().size();
+		playNextTrial();
+		assertEqual(rendered, simulationFactory.spatialization().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialPlaysHearingAidSimulationPreRenderedAtSameLevel) {
+		stimulusList.setContents({ "a", "b", "c" });
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		playingFirstTrialOfNewTest.setLevel_dB_Spl(65);
+		runUseCase(&playingFirstTrialOfNewTest);
+		backgroundTasks.runPendingTasks();
+		trial.level_dB_Spl = 65;
+		playNextTrial();
+		EXPECT_NE(audioFrameReader, audioLoaderFactory.audioFrameReader());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialProcessesHearingAidSimulationLiveAtAnotherLevel) {
+		stimulusList.setContents({ "a", "b", "c" });
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		playingFirstTrialOfNewTest.setLevel_dB_Spl(65);
+		runUseCase(&playingFirstTrialOfNewTest);
+		backgroundTasks.runPendingTasks();
+		trial.level_dB_Spl = 70;
+		playNextTrial();
+		EXPECT_EQ(audioFrameReader, audioLoaderFactory.audioFrameReader());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialPlaysStimulusReadAhead) {
+		stimulusList.setContents({ "a", "b", "c" });
+		runUseCase(&playingFirstTrialOfNewTest);
+		auto readAhead = std::make_shared<AudioFrameReaderStub>();
+		audioFrameReaderFactory.setReader(readAhead);
+		backgroundTasks.runPendingTasks();
+		audioFrameReaderFactory.setReader(audioFrameReader);
+		playNextTrial();
+		EXPECT_EQ(readAhead, audioLoaderFactory.audioFrameReader());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialProcessesLiveWhenPreRenderingUnfinished) {
+		stimulusList.setContents({ "a", "b", "c" });
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		playingFirstTrialOfNewTest.setLevel_dB_Spl(65);
+		runUseCase(&playingFirstTrialOfNewTest);
+		trial.level_dB_Spl = 65;
+		playNextTrial();
+		EXPECT_EQ(audioFrameReader, audioLoaderFactory.audioFrameReader());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationSetsUpProcessingGroupForRealTime) {
+		setSpatializationOnly(&playingCalibration);
+		runUseCase(&playingCalibration);
+		assertFalse(groupFactory.realTimes().empty());
+		for (auto setup : groupFactory.realTimes())
+			assertTrue(setup == &realTime);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWithoutSimulationDoesNotUseProcessingGroupFactory) {
+		setNoSimulation(&playingCalibration);
+		runUseCase(&playingCalibration);
+		assertTrue(groupFactory.realTimes().empty());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingDoesNotSetUpProcessingGroupForRealTime) {
+		setSpatializationOnly(&processingAudioForSaving);
+		runUseCase(&processingAudioForSaving);
+		assertFalse(groupFactory.realTimes().empty());
+		for (auto setup : groupFactory.realTimes())
+			assertTrue(setup == nullptr);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, preRenderingDoesNotSetUpProcessingGroupForRealTime) {
+		stimulusList.setContents({ "a", "b" });
+		setSpatializationOnly(&preparingNewTest);
+		runUseCase(&preparingNewTest);
+		backgroundTasks.runPendingTasks();
+		assertFalse(groupFactory.realTimes().empty());
+		for (auto setup : groupFactory.realTimes())
+			assertTrue(setup == nullptr);
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingRepeatedHearingAidSimulationProcessesOnce) {
+		setHearingAidSimulationOnly(&processingAudioForSaving);
+		runUseCase(&processingAudioForSaving);
+		const auto made = simulationFactory.hearingAidSimulation().size();
+		runUseCase(&processingAudioForSaving);
+		assertEqual(made, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingHearingAidSimulationAtAnotherLevelProcessesAgain) {
+		setHearingAidSimulationOnly(&processingAudioForSaving);
+		processingAudioForSaving.setLevel_dB_Spl(65);
+		runUseCase(&processingAudioForSaving);
+		const auto made = simulationFactory.hearingAidSimulation().size();
+		processingAudioForSaving.setLevel_dB_Spl(70);
+		runUseCase(&processingAudioForSaving);
+		EXPECT_LT(made, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingHearingAidSimulationWithReplacedPrescriptionProcessesAgain) {
+		setHearingAidSimulationOnly(&processingAudioForSaving);
+		processingAudioForSaving.setLeftDslPrescriptionFilePath("a");
+		fileVersions.setVersion("a", "1");
+		runUseCase(&processingAudioForSaving);
+		const auto made = simulationFactory.hearingAidSimulation().size();
+		fileVersions.setVersion("a", "2");
+		runUseCase(&processingAudioForSaving);
+		EXPECT_LT(made, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingProcessingGraphWithReplacedGraphProcessesAgain) {
+		using NodeType = ProcessingGraphReader::NodeType;
+		graphReader.setNodes({
+			graphNode(NodeType::input),
+			graphNode(NodeType::hearingAid, { 0 }, "b"),
+			graphNode(NodeType::output, { 1 })
+		});
+		processingAudioForSaving.setProcessingGraphOn();
+		processingAudioForSaving.setProcessingGraphFilePath("g");
+		fileVersions.setVersion("g", "1");
+		runUseCase(&processingAudioForSaving);
+		const auto made = simulationFactory.hearingAidSimulation().size();
+		fileVersions.setVersion("g", "2");
+		runUseCase(&processingAudioForSaving);
+		EXPECT_LT(made, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingHearingAidSimulationOfReplacedStimulusProcessesAgain) {
+		setHearingAidSimulationOnly(&processingAudioForSaving);
+		processingAudioForSaving.setAudioFilePath("a");
+		fileVersions.setVersion("a", "1");
+		runUseCase(&processingAudioForSaving);
+		const auto made = simulationFactory.hearingAidSimulation().size();
+		fileVersions.setVersion("a", "2");
+		runUseCase(&processingAudioForSaving);
+		EXPECT_LT(made, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingHearingAidSimulationWithAnotherPrescriptionProcessesAgain) {
+		setHearingAidSimulationOnly(&processingAudioForSaving);
+		processingAudioForSaving.setLeftDslPrescriptionFilePath("a");
+		runUseCase(&processingAudioForSaving);
+		const auto made = simulationFactory.hearingAidSimulation().size();
+		processingAudioForSaving.setLeftDslPrescriptionFilePath("b");
+		runUseCase(&processingAudioForSaving);
+		EXPECT_LT(made, simulationFactory.hearingAidSimulation().size());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playTrialStreamsHearingAidSimulationProcessedForSaving) {
+		stimulusList.setContents({ "a", "b", "c" });
+		setHearingAidSimulationOnly(&processingAudioForSaving);
+		processingAudioForSaving.setAudioFilePath("a");
+		processingAudioForSaving.setLevel_dB_Spl(65);
+		runUseCase(&processingAudioForSaving);
+		setHearingAidSimulationOnly(&playingFirstTrialOfNewTest);
+		playingFirstTrialOfNewTest.setLevel_dB_Spl(65);
+		runUseCase(&playingFirstTrialOfNewTest);
+		EXPECT_NE(audioFrameReader, audioLoaderFactory.audioFrameReader());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWhileCalibrationPlaysKeepsStreamAndLoader) {
+		runUseCase(&playingCalibration);
+		audioPlayer.setPlaying();
+		auto processor = audioLoaderFactory.audioFrameProcessor();
+		playingCalibration.setLevel_dB_Spl(71);
+		runUseCase(&playingCalibration);
+		assertFalse(audioPlayer.stopped());
+		assertTrue(processor == audioLoaderFactory.audioFrameProcessor());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWhileCalibrationPlaysRampsToNewLevel) {
+		setNoSimulation(&playingCalibration);
+		audioFrameReader->setChannels(1);
+		playingCalibration.setLevel_dB_Spl(65);
+		runUseCase(&playingCalibration);
+		audioPlayer.setPlaying();
+		playingCalibration.setLevel_dB_Spl(65 + 20);
+		runUseCase(&playingCalibration);
+		buffer_type x(1000, 1);
+		std::vector<channel_type> mono{ x };
+		processAudioLoaderProcessor(mono);
+		EXPECT_NEAR(10.0f, x.back(), 1e-4f);
+		assertTrue(x.front() < x.back());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWhileCalibrationPlaysWithAnotherProcessingMakesNewChainLive) {
+		setNoSimulation(&playingCalibration);
+		runUseCase(&playingCalibration);
+		audioPlayer.setPlaying();
+		setHearingAidSimulationOnly(&playingCalibration);
+		runUseCase(&playingCalibration);
+		assertFalse(simulationFactory.hearingAidSimulation().empty());
+		assertFalse(audioPlayer.stopped());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWhileCalibrationPlaysPrimesNewChainBeforeSwappingItIn) {
+		setNoSimulation(&playingCalibration);
+		audioFrameReader->setChannels(2);
+		runUseCase(&playingCalibration);
+		audioPlayer.setPlaying();
+		auto left = std::make_shared<SignalProcessorStub>();
+		auto right = std::make_shared<SignalProcessorStub>();
+		simulationFactory.setHearingAidSimulationProcessors({ left, right });
+		setHearingAidSimulationOnly(&playingCalibration);
+		runUseCase(&playingCalibration);
+		assertFalse(audioPlayer.stopped());
+		assertEqual(
+			std::vector<float>(SpatialHearingAidModel::defaultFramesPerBuffer), 
+			left->processed()
+		);
+		assertEqual(1, left->resets());
+		assertEqual(1, right->resets());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWhileCalibrationPlaysWithChainOfAnotherDelayRestartsStream) {
+		setNoSimulation(&playingCalibration);
+		audioFrameReader->setChannels(2);
+		runUseCase(&playingCalibration);
+		audioPlayer.setPlaying();
+		auto left = std::make_shared<SignalProcessorStub>();
+		auto right = std::make_shared<SignalProcessorStub>();
+		left->setGroupDelay(5);
+		right->setGroupDelay(5);
+		simulationFactory.setHearingAidSimulationProcessors({ left, right });
+		setHearingAidSimulationOnly(&playingCalibration);
+		runUseCase(&playingCalibration);
+		assertTrue(audioPlayer.stopped());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWhileCalibrationPlaysAwaitsPreRenderingBeforeRebuilding) {
+		setNoSimulation(&playingCalibration);
+		runUseCase(&playingCalibration);
+		audioPlayer.setPlaying();
+		setHearingAidSimulationOnly(&playingCalibration);
+		runUseCase(&playingCalibration);
+		assertEqual(2, backgroundTasks.awaited());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWhileCalibrationPlaysAnotherFileRestartsStream) {
+		playingCalibration.setAudioFilePath("a");
+		runUseCase(&playingCalibration);
+		audioPlayer.setPlaying();
+		playingCalibration.setAudioFilePath("b");
+		runUseCase(&playingCalibration);
+		assertTrue(audioPlayer.stopped());
+		assertEqual("b", audioFrameReaderFactory.filePath());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, playCalibrationWhileTrialPlaysDoesNothing) {
+		stimulusList.setContents({ "a", "b", "c" });
+		runUseCase(&playingFirstTrialOfNewTest);
+		audioPlayer.setPlaying();
+		playingCalibration.setAudioFilePath("d");
+		runUseCase(&playingCalibration);
+		assertFalse(audioPlayer.stopped());
+		assertEqual("a", audioFrameReaderFactory.filePath());
 	}
 
 	TEST_F(SpatialHearingAidModelTests, playCalibrationAssignsSpatializationProcessorsToAudioLoader) {
@@ -1548,16 +2351,30 @@ namespace {
 		assertTrue(audioPlayer.stopped());
 	}
 
-	TEST_F(SpatialHearingAidModelTests, saveAudioPassesFileToAudioWriterFactory) {
-		model.saveAudio("a");
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingWritesToTemporaryFile) {
+		temporaryFiles.setFilePath("a");
+		processAudioForSaving();
 		assertEqual("a", audioFrameWriterFactory.filePath());
 	}
 
-    TEST_F(SpatialHearingAidModelTests, saveAudioPassesChannelsAndSampleRateToAudioWriterFactory) {
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingReusesTemporaryFile) {
+		processAudioForSaving();
+		processAudioForSaving();
+		assertEqual(1, temporaryFiles.made());
+	}
+
+	TEST_F(SpatialHearingAidModelTests, saveAudioCopiesProcessedAudioToFile) {
+		temporaryFiles.setFilePath("a");
+		processAudioForSaving();
+		model.saveAudio("b");
+		assertEqual("a", temporaryFiles.copiedFrom());
+		assertEqual("b", temporaryFiles.copiedTo());
+	}
+
+    TEST_F(SpatialHearingAidModelTests, processAudioForSavingPassesChannelsAndSampleRateToAudioWriterFactory) {
         audioFrameReader->setChannels(1);
         audioFrameReader->setSampleRate(2);
         processAudioForSaving();
-        model.saveAudio({});
         assertEqual(1, audioFrameWriterFactory.format().channels);
         assertEqual(2, audioFrameWriterFactory.format().sampleRate);
     }
@@ -1638,6 +2455,20 @@ namespace {
 		assertEqual({ 1, 2, 3, 4, 5, 6, 7, 8 }, audioFrameWriter->written());
 	}
 
+	TEST_F(SpatialHearingAidModelTests, processAudioForSavingHearingAidSimulationTooLargeToCacheProcessesAgain) {
+		std::shared_ptr<FakeAudioLoader> fakeLoader = 
+			std::make_shared<FakeAudioLoader>();
+		fakeLoader->setAudioToLoad(std::vector<float>((1 << 20) / sizeof(float) + 2 * 1024));
+		audioFrameReader->setChannels(2);
+		savingAudio.processing.chunkSize = 1024;
+		savingAudio.processing.usingHearingAidSimulation = true;
+		audioLoaderFactory.setLoader(fakeLoader);
+		processAudioForSaving();
+		const auto made = simulationFactory.hearingAidSimulation().size();
+		processAudioForSaving();
+		EXPECT_LT(made, simulationFactory.hearingAidSimulation().size());
+	}
+
 	class RefactoredModelFailureTests : public ::testing::Test {
 	protected:
 		PreparingNewTest preparingNewTest{};
@@ -1650,6 +2481,8 @@ namespace {
 		PrescriptionReader *prescriptionReader{ &defaultPrescriptionReader };
 		BrirReaderStub defaultBrirReader{};
 		BrirReader *brirReader{ &defaultBrirReader };
+		ProcessingGraphReaderStub defaultGraphReader{};
+		ProcessingGraphReader *graphReader{ &defaultGraphReader };
 		FakeStimulusList defaultStimulusList{};
 		StimulusList *stimulusList{ &defaultStimulusList };
 		DocumenterStub defaultDocumenter{};
@@ -1666,6 +2499,15 @@ namespace {
 		SimulationChannelFactory *simulationFactory{&defaultSimulationFactory};
 		CalibrationComputerStubFactory defaultCalibrationFactory{};
 		CalibrationComputerFactory *calibrationComputerFactory{ &defaultCalibrationFactory };
+		ChannelProcessingGroupFactory defaultGroupFactory{};
+		ProcessingGroupFactory *groupFactory{ &defaultGroupFactory };
+		SignalStoreStub defaultSpillStore{};
+		SignalStore *spillStore{ &defaultSpillStore };
+		std::size_t renderedStimulusBudget{ 1 << 20 };
+		std::unique_ptr<SignalCache> renderedStimuli{};
+		TaskRunnerStub backgroundTasks{};
+		TemporaryFilesStub defaultTemporaryFiles{};
+		TemporaryFiles *temporaryFiles{ &defaultTemporaryFiles };
 
 		void assertThrowsRequestFailure(UseCase *useCase, std::string what) {
 			try {
@@ -1691,18 +2533,25 @@ namespace {
 		}
 
 		SpatialHearingAidModel constructModel() {
+			renderedStimuli = std::make_unique<SignalCache>(spillStore, renderedStimulusBudget);
 			return 
 			{
 				stimulusList,
 				documenter,
 				audioPlayer,
 				audioLoaderFactory,
+				audioLoaderFactory,
 				audioReaderFactory,
 				audioWriterFactory,
 				prescriptionReader,
 				brirReader,
+				graphReader,
 				simulationFactory,
-				calibrationComputerFactory
+				calibrationComputerFactory,
+				groupFactory,
+				renderedStimuli.get(),
+				&backgroundTasks,
+				temporaryFiles
 			};
 		}
 
@@ -1725,6 +2574,32 @@ namespace {
 			assertThrowsRequestFailure(useCase, "BRIR 'a' cannot be read.");
 		}
 
+		void assertThrowsRequestFailureWhenProcessingGraphReaderFails(
+			SignalProcessingUseCase *useCase
+		) {
+			FailingProcessingGraphReader failing;
+			graphReader = &failing;
+			useCase->setProcessingGraphOn();
+			useCase->setProcessingGraphFilePath("a");
+			assertThrowsRequestFailure(useCase, "Processing graph 'a' cannot be read.");
+		}
+
+		void assertThrowsRequestFailureWhenProcessingGraphHasCycle(
+			SignalProcessingUseCase *useCase
+		) {
+			using NodeType = ProcessingGraphReader::NodeType;
+			defaultGraphReader.setNodes({
+				graphNode(NodeType::mix, { 1 }),
+				graphNode(NodeType::mix, { 0 })
+			});
+			useCase->setProcessingGraphOn();
+			useCase->setProcessingGraphFilePath("a");
+			assertThrowsRequestFailure(
+				useCase, 
+				"Processing graph 'a' is invalid: The graph contains a cycle."
+			);
+		}
+
 		void assertThrowsRequestFailureWhenProcessingSizesNotPowersOfTwo(SignalProcessingUseCase *useCase) {
 			useCase->setHearingAidSimulationOn();
 			useCase->setChunkSize(0);
@@ -1767,6 +2642,13 @@ namespace {
 			assertThrowsRequestFailure(useCase, "Audio file 'a' cannot be read.");
 		}
 
+		void assertThrowsRequestFailureWhenStimulusCannotBeReadForPlayback(AudioFileUseCase *useCase) {
+			ReadFailingAudioPlayer failing;
+			audioPlayer = &failing;
+			useCase->setAudioFilePath("a");
+			assertThrowsRequestFailure(useCase, "Audio file 'a' cannot be read.");
+		}
+
 		void assertThrowsRequestFailureWhenAudioPlayerFailsToPrepare(AudioDeviceUseCase *useCase) {
 			PreparationFailingAudioPlayer failing;
 			audioPlayer = &failing;
@@ -1862,6 +2744,34 @@ namespace {
 		assertThrowsRequestFailureWhenBrirReaderFails(&processingAudioForSaving);
 	}
 
+	TEST_F(
+		RefactoredModelFailureTests,
+		prepareNewTestThrowsRequestFailureWhenProcessingGraphReaderFails
+	) {
+		assertThrowsRequestFailureWhenProcessingGraphReaderFails(&preparingNewTest);
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		playCalibrationThrowsRequestFailureWhenProcessingGraphReaderFails
+	) {
+		assertThrowsRequestFailureWhenProcessingGraphReaderFails(&playingCalibration);
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		processAudioForSavingThrowsRequestFailureWhenProcessingGraphReaderFails
+	) {
+		assertThrowsRequestFailureWhenProcessingGraphReaderFails(&processingAudioForSaving);
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		prepareNewTestThrowsRequestFailureWhenProcessingGraphHasCycle
+	) {
+		assertThrowsRequestFailureWhenProcessingGraphHasCycle(&preparingNewTest);
+	}
+
 	TEST_F(
 		RefactoredModelFailureTests,
 		prepareNewTestThrowsRequestFailureWhenCoefficientsAreEmpty
@@ -1904,6 +2814,46 @@ namespace {
 		assertThrowsRequestFailureWhenProcessingSizesNotPowersOfTwo(&processingAudioForSaving);
 	}
 
+	class FileFailingAudioFrameReaderFactory : public AudioFrameReaderFactory {
+		std::string failingFilePath;
+		int failures_{};
+	public:
+		explicit FileFailingAudioFrameReaderFactory(std::string failingFilePath) :
+			failingFilePath{ std::move(failingFilePath) } {}
+
+		std::shared_ptr<AudioFrameReader> make(std::string filePath) override {
+			if (filePath == failingFilePath) {
+				++failures_;
+				throw CreateError{ {} };
+			}
+			return std::make_shared<AudioFrameReaderStub>();
+		}
+
+		int failures() const noexcept {
+			return failures_;
+		}
+	};
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		playTrialThrowsRequestFailureWhenNextStimulusCouldNotBeReadAhead
+	) {
+		FileFailingAudioFrameReaderFactory failing{ "b" };
+		audioReaderFactory = &failing;
+		defaultStimulusList.setContents({ "a", "b", "c" });
+		auto model = constructModel();
+		playingFirstTrialOfNewTest.run(&model);
+		backgroundTasks.runPendingTasks();
+		try {
+			model.playNextTrial({});
+			FAIL() << "Expected SpatialHearingAidModel::RequestFailure.";
+		}
+		catch (const SpatialHearingAidModel::RequestFailure &e) {
+			assertEqual(std::string{ "Audio file 'b' cannot be read." }, e.what());
+		}
+		assertEqual(1, failing.failures());
+	}
+
 	TEST_F(
 		RefactoredModelFailureTests,
 		playTrialThrowsRequestFailureWhenAudioFrameReaderCannotBeCreated
@@ -1921,6 +2871,23 @@ namespace {
 		assertThrowsRequestFailureWhenAudioReaderFactoryFails(&playingCalibration);
 	}
 
+	TEST_F(
+		RefactoredModelFailureTests,
+		playCalibrationThrowsRequestFailureWhenStimulusCannotBeReadForPlayback
+	) {
+		assertThrowsRequestFailureWhenStimulusCannotBeReadForPlayback(&playingCalibration);
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		playTrialThrowsRequestFailureWhenStimulusCannotBeReadForPlayback
+	) {
+		ReadFailingAudioPlayer failing;
+		audioPlayer = &failing;
+		defaultStimulusList.setContents({ "a" });
+		assertThrowsRequestFailure(&playingFirstTrialOfNewTest, "Audio file 'a' cannot be read.");
+	}
+
 	TEST_F(
 		RefactoredModelFailureTests,
 		processAudioForSavingThrowsRequestFailureWhenAudioFrameReaderCannotBeCreated
@@ -1952,11 +2919,99 @@ namespace {
 
 	TEST_F(
 		RefactoredModelFailureTests,
-		saveAudioThrowsRequestFailureWhenAudioFrameWriterCannotBeCreated
+		processAudioForSavingThrowsRequestFailureWhenAudioFrameWriterCannotBeCreated
 	) {
 		ErrorAudioFrameWriterFactory failing{};
 		audioWriterFactory = &failing;
-		savingAudio.setAudioFilePath("a");
-		assertThrowsRequestFailure(&savingAudio, "Audio file 'a' cannot be written.");
+		defaultTemporaryFiles.setFilePath("a");
+		assertThrowsRequestFailure(&processingAudioForSaving, "Audio file 'a' cannot be written.");
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		saveAudioThrowsRequestFailureWhenNoAudioProcessed
+	) {
+		assertThrowsRequestFailure(&savingAudio, "No audio has been processed for saving.");
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		saveAudioThrowsRequestFailureWhenProcessedAudioCannotBeCopied
+	) {
+		auto loader = std::make_shared<AudioLoaderStub>();
+		loader->setComplete();
+		defaultAudioLoaderFactory.setLoader(loader);
+		CopyFailingTemporaryFiles failing{};
+		temporaryFiles = &failing;
+		auto model = constructModel();
+		model.processAudioForSaving({});
+		try {
+			model.saveAudio("a");
+			FAIL() << "Expected SpatialHearingAidModel::RequestFailure.";
+		}
+		catch (const SpatialHearingAidModel::RequestFailure &e) {
+			assertEqual(std::string{ "Audio file 'a' cannot be written." }, e.what());
+		}
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		destroyingModelRemovesTemporaryFile
+	) {
+		auto loader = std::make_shared<AudioLoaderStub>();
+		loader->setComplete();
+		defaultAudioLoaderFactory.setLoader(loader);
+		defaultTemporaryFiles.setFilePath("a");
+		runUseCase(&processingAudioForSaving);
+		assertTrue(defaultTemporaryFiles.removed().contains("a"));
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		playTrialThrowsRequestFailureWhenRenderedStimulusCannotBeSpilled
+	) {
+		FailingSignalStore failing{};
+		failing.setErrorMessage("error.");
+		spillStore = &failing;
+		renderedStimulusBudget = 0;
+		auto reader = std::make_shared<AudioFrameReaderStub>();
+		reader->setChannels(1);
+		defaultAudioReaderFactory.setReader(reader);
+		auto loader = std::make_shared<FakeAudioLoader>();
+		loader->setAudioToLoad(std::vector<float>(SpatialHearingAidModel::defaultFramesPerBuffer));
+		defaultAudioLoaderFactory.setLoader(loader);
+		BrirReader::BinauralRoomImpulseResponse brir{};
+		brir.left = { 0 };
+		brir.right = { 0 };
+		defaultBrirReader.setBrir(brir);
+		PlayingFirstTrialOfNewTest playing{};
+		playing.setSpatializationOn();
+		assertThrowsRequestFailure(&playing, "error.");
+	}
+
+	TEST_F(
+		RefactoredModelFailureTests,
+		playTrialReportsPreRenderingFailureBeforePreparingPlayer
+	) {
+		FailingSignalStore failing{};
+		failing.setErrorMessage("error.");
+		spillStore = &failing;
+		renderedStimulusBudget = 0;
+		defaultStimulusList.setContents({ "a", "b" });
+		backgroundTasks.runTasksWhenAwaited();
+		auto reader = std::make_shared<AudioFrameReaderStub>();
+		reader->setChannels(1);
+		defaultAudioReaderFactory.setReader(reader);
+		auto loader = std::make_shared<FakeAudioLoader>();
+		loader->setAudioToLoad(std::vector<float>(SpatialHearingAidModel::defaultFramesPerBuffer));
+		defaultAudioLoaderFactory.setLoader(loader);
+		BrirReader::BinauralRoomImpulseResponse brir{};
+		brir.left = { 0 };
+		brir.right = { 0 };
+		defaultBrirReader.setBrir(brir);
+		PlayingFirstTrialOfNewTest playing{};
+		playing.setSpatializationOn();
+		assertThrowsRequestFailure(&playing, "error.");
+		assertEqual("", defaultPlayer.log());
 	}
 }
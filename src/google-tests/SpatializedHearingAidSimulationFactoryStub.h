@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ArgumentCollection.h"
+#include "SignalProcessorStub.h"
 #include <spatialized-hearing-aid-simulation/SimulationChannelFactory.h>
 #include <vector>
 
@@ -33,6 +34,7 @@ class SpatializedHearingAidSimulationFactoryStub :
 	ArgumentCollection<float> hearingAidSimulationScale_{};
 	ArgumentCollection<float> spatializationScale_{};
 	ArgumentCollection<float> withoutSimulationScale_{};
+	int arenasBegun_{};
 public:
 	PoppableVector<std::shared_ptr<SignalProcessor>> fullSimulationProcessors;
 	PoppableVector<std::shared_ptr<SignalProcessor>> hearingAidSimulationProcessors;
@@ -67,7 +69,7 @@ public:
 		fullSimulationHearingAid_.push_back(std::move(s.hearingAid));
 		fullSimulationSpatialization_.push_back(std::move(s.spatialization));
 		fullSimulationScale_.push_back(x);
-		return fullSimulationProcessors.pop_front();
+		return orStub(fullSimulationProcessors.pop_front());
 	}
 
 	std::shared_ptr<SignalProcessor> makeHearingAidSimulation(
@@ -75,7 +77,7 @@ public:
 	) override {
 		hearingAidSimulation_.push_back(std::move(s));
 		hearingAidSimulationScale_.push_back(x);
-		return hearingAidSimulationProcessors.pop_front();
+		return orStub(hearingAidSimulationProcessors.pop_front());
 	}
 
 	std::shared_ptr<SignalProcessor> makeSpatialization(
@@ -83,14 +85,14 @@ public:
 	) override {
 		spatialization_.push_back(std::move(s));
 		spatializationScale_.push_back(x);
-		return spatializationProcessors.pop_front();
+		return orStub(spatializationProcessors.pop_front());
 	}
 
 	std::shared_ptr<SignalProcessor> makeWithoutSimulation(
 		float x
 	) override {
 		withoutSimulationScale_.push_back(x);
-		return withoutSimulationProcessors.pop_front();
+		return orStub(withoutSimulationProcessors.pop_front());
 	}
 
 	auto &fullSimulationSpatialization() const noexcept {
@@ -123,4 +125,18 @@ public:
 	auto &withoutSimulationScale() const noexcept {
 		return withoutSimulationScale_;
 	}
+
+	void beginArena() override {
+		++arenasBegun_;
+	}
+
+	auto arenasBegun() const noexcept {
+		return arenasBegun_;
+	}
+
+private:
+	// Callers may reset and rescale what they are given, so never hand out null.
+	static std::shared_ptr<SignalProcessor> orStub(std::shared_ptr<SignalProcessor> p) {
+		return p ? p : std::make_shared<SignalProcessorStub>();
+	}
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/SpscQueue.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace {
+	class SpscQueueTests : public ::testing::Test {
+	protected:
+		SpscQueue<int> queue{ 2 };
+	};
+
+	TEST_F(SpscQueueTests, emptyInitially) {
+		int x{};
+		assertTrue(queue.empty());
+		assertFalse(queue.pop(x));
+	}
+
+	TEST_F(SpscQueueTests, popsInPushedOrder) {
+		queue.push(1);
+		queue.push(2);
+		int x{};
+		queue.pop(x);
+		assertEqual(1, x);
+		queue.pop(x);
+		assertEqual(2, x);
+		assertTrue(queue.empty());
+	}
+
+	TEST_F(SpscQueueTests, pushFailsWhenFull) {
+		assertTrue(queue.push(1));
+		assertTrue(queue.push(2));
+		assertFalse(queue.push(3));
+	}
+
+	TEST_F(SpscQueueTests, wrapsAround) {
+		int x{};
+		for (int i = 0; i < 5; ++i) {
+			queue.push(i);
+			queue.pop(x);
+			assertEqual(i, x);
+		}
+	}
+
+	TEST_F(SpscQueueTests, transfersEveryItemBetweenThreads) {
+		std::thread producer{ [&]() {
+			for (int i = 0; i < 10000; ++i)
+				while (!queue.push(i))
+					std::this_thread::yield();
+		} };
+		int expected = 0;
+		while (expected < 10000) {
+			int x{};
+			if (queue.pop(x)) {
+				if (x != expected)
+					break;
+				++expected;
+			}
+			else
+				std::this_thread::yield();
+		}
+		producer.join();
+		assertEqual(10000, expected);
+	}
+}
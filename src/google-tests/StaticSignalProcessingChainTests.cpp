@@ -0,0 +1,129 @@
+#include "assert-utility.h"
+#include <spatialized-hearing-aid-simulation/StaticSignalProcessingChain.h>
+#include <gtest/gtest.h>
+#include <memory_resource>
+
+namespace {
+	class AddsSamples {
+		float x;
+		SignalProcessor::index_type groupDelay_;
+	public:
+		explicit AddsSamples(float x, SignalProcessor::index_type groupDelay_ = 0) :
+			x{ x },
+			groupDelay_{ groupDelay_ } {}
+
+		void process(SignalProcessor::signal_type signal) {
+			for (auto &y : signal)
+				y += x;
+		}
+
+		auto groupDelay() const noexcept {
+			return groupDelay_;
+		}
+
+		void reset() noexcept {
+			x = 0;
+		}
+	};
+
+	class MultipliesSamples {
+		float x;
+		SignalProcessor::index_type groupDelay_;
+	public:
+		explicit MultipliesSamples(float x, SignalProcessor::index_type groupDelay_ = 0) :
+			x{ x },
+			groupDelay_{ groupDelay_ } {}
+
+		void process(SignalProcessor::signal_type signal) {
+			for (auto &y : signal)
+				y *= x;
+		}
+
+		auto groupDelay() const noexcept {
+			return groupDelay_;
+		}
+
+		void reset() noexcept {}
+
+		void setScale(float s) noexcept {
+			x = s;
+		}
+	};
+
+	class RecordsAllocator {
+	public:
+		using allocator_type = std::pmr::polymorphic_allocator<float>;
+
+		explicit RecordsAllocator(std::pmr::memory_resource **resource) noexcept {
+			*resource = nullptr;
+		}
+
+		RecordsAllocator(
+			std::pmr::memory_resource **resource, 
+			const allocator_type &allocator
+		) noexcept {
+			*resource = allocator.resource();
+		}
+
+		void process(SignalProcessor::signal_type) {}
+		SignalProcessor::index_type groupDelay() const noexcept { return 0; }
+		void reset() noexcept {}
+	};
+
+	class StaticSignalProcessingChainTests : public ::testing::Test {
+	protected:
+		using buffer_type = std::vector<SignalProcessor::signal_type::element_type>;
+	};
+
+	TEST_F(StaticSignalProcessingChainTests, chainCallsProcessorsInOrder) {
+		StaticSignalProcessingChain<AddsSamples, MultipliesSamples, AddsSamples> chain{
+			1.0f, 
+			2.0f, 
+			3.0f
+		};
+		buffer_type x = { 1, 2, 3 };
+		chain.process(x);
+		assertEqual({ 7, 9, 11 }, x);
+	}
+
+	TEST_F(StaticSignalProcessingChainTests, groupDelayReturnsSumOfComponents) {
+		StaticSignalProcessingChain<AddsSamples, MultipliesSamples, AddsSamples> chain{
+			AddsSamples{ 0, 1 },
+			MultipliesSamples{ 0, 2 },
+			AddsSamples{ 0, 3 }
+		};
+		using index_type = SignalProcessor::index_type;
+		assertEqual(index_type{ 1 + 2 + 3 }, chain.groupDelay());
+	}
+
+	TEST_F(StaticSignalProcessingChainTests, resetResetsEachStage) {
+		StaticSignalProcessingChain<AddsSamples, MultipliesSamples> chain{ 1.0f, 2.0f };
+		chain.reset();
+		buffer_type x = { 1, 2, 3 };
+		chain.process(x);
+		assertEqual({ 2, 4, 6 }, x);
+	}
+
+	TEST_F(StaticSignalProcessingChainTests, setScaleOnlySetsScalableStages) {
+		StaticSignalProcessingChain<AddsSamples, MultipliesSamples> chain{ 1.0f, 2.0f };
+		chain.setScale(3);
+		buffer_type x = { 1, 2, 3 };
+		chain.process(x);
+		assertEqual({ 6, 9, 12 }, x);
+	}
+
+	TEST_F(StaticSignalProcessingChainTests, allocatorPassedToStagesThatTakeOne) {
+		std::pmr::monotonic_buffer_resource resource{};
+		std::pmr::memory_resource *received{};
+		StaticSignalProcessingChain<AddsSamples, RecordsAllocator> chain{
+			std::allocator_arg,
+			std::pmr::polymorphic_allocator<std::byte>{ &resource },
+			1.0f,
+			&received
+		};
+		buffer_type x = { 1 };
+		chain.process(x);
+		assertEqual({ 2 }, x);
+		assertTrue(received == &resource);
+	}
+}
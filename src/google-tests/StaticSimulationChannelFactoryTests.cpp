@@ -0,0 +1,160 @@
+#include "assert-utility.h"
+#include "FilterbankCompressorSpy.h"
+#include <spatialized-hearing-aid-simulation/StaticSimulationChannelFactory.h>
+#include <gtest/gtest.h>
+
+namespace {
+	class ScalingFake {
+		float scale;
+	public:
+		explicit ScalingFake(float scale) : scale{ scale } {}
+
+		void process(SignalProcessor::signal_type signal) {
+			for (auto &x : signal)
+				x += scale;
+		}
+
+		SignalProcessor::index_type groupDelay() const noexcept {
+			return 1;
+		}
+
+		void reset() noexcept {}
+	};
+
+	class FirFake {
+		float coefficient;
+	public:
+		explicit FirFake(BrirReader::impulse_response_type b) : 
+			coefficient{ b.empty() ? 0 : b.front() } {}
+
+		void process(SignalProcessor::signal_type signal) {
+			for (auto &x : signal)
+				x *= coefficient;
+		}
+
+		SignalProcessor::index_type groupDelay() const noexcept {
+			return 2;
+		}
+
+		void reset() noexcept {}
+	};
+
+	class HearingAidFake {
+		std::shared_ptr<FilterbankCompressor> compressor;
+	public:
+		explicit HearingAidFake(std::shared_ptr<FilterbankCompressor> compressor) :
+			compressor{ std::move(compressor) } {}
+
+		void process(SignalProcessor::signal_type signal) {
+			for (auto &x : signal)
+				x += compressor->chunkSize();
+		}
+
+		SignalProcessor::index_type groupDelay() const noexcept {
+			return 3;
+		}
+
+		void reset() noexcept {}
+	};
+
+	class StaticSimulationChannelFactoryTests : public ::testing::Test {
+	protected:
+		using buffer_type = std::vector<SignalProcessor::signal_type::element_type>;
+		using index_type = SignalProcessor::index_type;
+
+		SimulationChannelFactory::Spatialization spatialization;
+		SimulationChannelFactory::HearingAidSimulation hearingAidSimulation;
+		SimulationChannelFactory::FullSimulation fullSimulation;
+		std::shared_ptr<FilterbankCompressorSpy> compressor =
+			std::make_shared<FilterbankCompressorSpy>();
+		FilterbankCompressorSpyFactory compressorFactory{ compressor };
+		StaticSimulationChannelFactory<ScalingFake, FirFake, HearingAidFake>
+			simulationFactory{ &compressorFactory };
+
+		StaticSimulationChannelFactoryTests() {
+			compressor->setChunkSize(3);
+		}
+
+		void assertProcessesInto(
+			const std::shared_ptr<SignalProcessor> &processor, 
+			float input, 
+			float expected
+		) {
+			buffer_type x{ input };
+			processor->process(x);
+			assertEqual({ expected }, x);
+		}
+	};
+
+	TEST_F(
+		StaticSimulationChannelFactoryTests,
+		makeWithoutSimulationOnlyScales
+	) {
+		auto processor = simulationFactory.makeWithoutSimulation(1);
+		assertProcessesInto(processor, 4, 4 + 1);
+		assertEqual(index_type{ 1 }, processor->groupDelay());
+	}
+
+	TEST_F(
+		StaticSimulationChannelFactoryTests,
+		makeSpatializationScalesThenFilters
+	) {
+		spatialization.filterCoefficients = { 2 };
+		auto processor = simulationFactory.makeSpatialization(spatialization, 1);
+		assertProcessesInto(processor, 4, (4 + 1) * 2);
+		assertEqual(index_type{ 1 + 2 }, processor->groupDelay());
+	}
+
+	TEST_F(
+		StaticSimulationChannelFactoryTests,
+		makeHearingAidSimulationScalesThenCompresses
+	) {
+		auto processor = simulationFactory.makeHearingAidSimulation({}, 1);
+		assertProcessesInto(processor, 4, 4 + 1 + 3);
+		assertEqual(index_type{ 1 + 3 }, processor->groupDelay());
+	}
+
+	TEST_F(
+		StaticSimulationChannelFactoryTests,
+		makeFullSimulationCombinesProcessorsInOrder
+	) {
+		fullSimulation.spatialization.filterCoefficients = { 2 };
+		auto processor = simulationFactory.makeFullSimulation(fullSimulation, 1);
+		assertProcessesInto(processor, 4, (4 + 1) * 2 + 3.0f);
+		assertEqual(index_type{ 1 + 2 + 3 }, processor->groupDelay());
+	}
+
+	TEST_F(
+		StaticSimulationChannelFactoryTests,
+		makeHearingAidSimulationPassesCompressionParametersToFactory
+	) {
+		hearingAidSimulation.prescription.channels = 1;
+		hearingAidSimulation.attack_ms = 2;
+		hearingAidSimulation.release_ms = 3;
+		hearingAidSimulation.chunkSize = 4;
+		hearingAidSimulation.windowSize = 5;
+		hearingAidSimulation.sampleRate = 6;
+		hearingAidSimulation.fullScaleLevel_dB_Spl = 7;
+		simulationFactory.makeHearingAidSimulation(hearingAidSimulation, {});
+		auto parameters = compressorFactory.parameters().at(0);
+		assertEqual(1, parameters.channels);
+		assertEqual(2.0, parameters.attack_ms);
+		assertEqual(3.0, parameters.release_ms);
+		assertEqual(4, parameters.chunkSize);
+		assertEqual(5, parameters.windowSize);
+		assertEqual(6.0, parameters.sampleRate);
+		assertEqual(7.0, parameters.max_dB_Spl);
+	}
+
+	TEST_F(
+		StaticSimulationChannelFactoryTests,
+		makeFullSimulationPassesCompressionParametersToFactory
+	) {
+		fullSimulation.hearingAid.prescription.compressionRatios = { 1 };
+		fullSimulation.hearingAid.chunkSize = 2;
+		simulationFactory.makeFullSimulation(fullSimulation, {});
+		auto parameters = compressorFactory.parameters().at(0);
+		assertEqual({ 1 }, parameters.compressionRatios);
+		assertEqual(2, parameters.chunkSize);
+	}
+}
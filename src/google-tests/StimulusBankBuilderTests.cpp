@@ -0,0 +1,87 @@
+#include "FakeAudioFile.h"
+#include "FileMappingStub.h"
+#include "assert-utility.h"
+#include <audio-file-reading-writing/StimulusBankBuilder.h>
+#include <audio-file-reading-writing/StimulusBank.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+namespace {
+	class StimulusBankBuilderTests : public ::testing::Test {
+	protected:
+		AudioFilesFake files{};
+		StimulusBankBuilder builder{ &files };
+
+		StimulusBank build() {
+			std::stringstream stream;
+			builder.write(stream);
+			const auto written = stream.str();
+			return StimulusBank{
+				std::make_shared<FileMappingStub>(
+					std::vector<unsigned char>{ written.begin(), written.end() }
+				)
+			};
+		}
+
+		void assertWriteThrowsFileError(std::string what) {
+			try {
+				std::stringstream stream;
+				builder.write(stream);
+				FAIL() << "Expected StimulusBankBuilder::FileError";
+			}
+			catch (const StimulusBankBuilder::FileError &e) {
+				assertEqual(std::move(what), e.what());
+			}
+		}
+	};
+
+	TEST_F(StimulusBankBuilderTests, keepsStimuliInOrderAdded) {
+		files.add("b.wav", { 1 });
+		files.add("a.wav", { 2 });
+		builder.add("b", "b.wav");
+		builder.add("a", "a.wav");
+		assertEqual<std::string>({ "b", "a" }, build().names());
+	}
+
+	TEST_F(StimulusBankBuilderTests, keepsFormatOfEachStimulus) {
+		files.add("a.wav", { 1, 2, 3, 4, 5, 6 }, 2, 3);
+		builder.add("a", "a.wav");
+		auto bank = build();
+		const auto entry = bank.find("a");
+		assertEqual(2, entry->channels);
+		assertEqual(3, entry->sampleRate);
+		assertEqual(3LL, entry->frames);
+	}
+
+	TEST_F(StimulusBankBuilderTests, measuresRmsOfEachChannel) {
+		files.add("a.wav", { 0.5, 1, -0.5, 1 }, 2);
+		builder.add("a", "a.wav");
+		auto bank = build();
+		assertEqual({ 0.5, 1 }, bank.find("a")->rms);
+	}
+
+	TEST_F(StimulusBankBuilderTests, keeps16BitStimuliAt16Bits) {
+		files.add("a.wav", { 0.5, -0.25 });
+		files.add("b.wav", { 0.5, 0.1f });
+		builder.add("a", "a.wav");
+		builder.add("b", "b.wav");
+		auto bank = build();
+		EXPECT_TRUE(bank.find("a")->encoding == StimulusBank::Encoding::pcm16);
+		EXPECT_TRUE(bank.find("b")->encoding == StimulusBank::Encoding::float32);
+	}
+
+	TEST_F(StimulusBankBuilderTests, samplesStartOnAlignedBoundaries) {
+		files.add("a.wav", { 0.1f });
+		files.add("b.wav", { 0.1f, 0.2f, 0.3f });
+		builder.add("a", "a.wav");
+		builder.add("b", "b.wav");
+		auto bank = build();
+		for (const auto &name : bank.names())
+			assertEqual(0LL, bank.find(name)->offset % StimulusBank::alignment);
+	}
+
+	TEST_F(StimulusBankBuilderTests, writeThrowsFileErrorWhenStimulusCannotBeRead) {
+		builder.add("a", "a.wav");
+		assertWriteThrowsFileError("error.");
+	}
+}
@@ -0,0 +1,257 @@
+#include "DirectoryReaderStub.h"
+#include "FakeAudioFile.h"
+#include "FileMappingStub.h"
+#include "StimulusCacheStub.h"
+#include "assert-utility.h"
+#include <audio-file-reading-writing/StimulusBank.h>
+#include <audio-file-reading-writing/StimulusBankBuilder.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+namespace {
+	class AudioFrameReaderFactoryStub : public AudioFrameReaderFactory {
+		std::string filePath_{};
+	public:
+		std::shared_ptr<AudioFrameReader> make(std::string filePath) override {
+			filePath_ = std::move(filePath);
+			return {};
+		}
+
+		auto filePath() const {
+			return filePath_;
+		}
+	};
+
+	using bytes_type = std::vector<unsigned char>;
+
+	class BankBuilder {
+		AudioFilesFake files{};
+		StimulusBankBuilder builder{ &files };
+	public:
+		void add(std::string name, std::vector<float> x, int channels = 1) {
+			files.add(name, std::move(x), channels);
+			builder.add(name, name);
+		}
+
+		bytes_type bytes() {
+			std::stringstream stream;
+			builder.write(stream);
+			const auto written = stream.str();
+			return { written.begin(), written.end() };
+		}
+	};
+
+	class StimulusBankTests : public ::testing::Test {
+	protected:
+		using channel_type = AudioFrameReader::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+		BankBuilder bankBuilder{};
+
+		std::shared_ptr<StimulusBank> bank(bytes_type bytes) {
+			return std::make_shared<StimulusBank>(
+				std::make_shared<FileMappingStub>(std::move(bytes))
+			);
+		}
+
+		StimulusBankReader reader(std::string name) {
+			auto bank_ = bank(bankBuilder.bytes());
+			const auto entry = bank_->find(name);
+			return { std::move(bank_), entry };
+		}
+
+		void assertFormatError(bytes_type bytes, std::string what) {
+			try {
+				bank(std::move(bytes));
+				FAIL() << "Expected StimulusBank::FormatError";
+			}
+			catch (const StimulusBank::FormatError &e) {
+				assertEqual(std::move(what), e.what());
+			}
+		}
+	};
+
+	TEST_F(StimulusBankTests, readsEachChannel) {
+		bankBuilder.add("a", { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f }, 2);
+		auto reader_ = reader("a");
+		buffer_type left(3);
+		buffer_type right(3);
+		std::vector<channel_type> audio{ left, right };
+		reader_.read(audio);
+		assertEqual({ 0.1f, 0.3f, 0.5f }, left);
+		assertEqual({ 0.2f, 0.4f, 0.6f }, right);
+	}
+
+	TEST_F(StimulusBankTests, reads16BitStimuli) {
+		bankBuilder.add("a", { 0.5, -0.25, 0.75 });
+		auto reader_ = reader("a");
+		buffer_type x(3);
+		std::vector<channel_type> audio{ x };
+		reader_.read(audio);
+		assertEqual({ 0.5, -0.25, 0.75 }, x);
+	}
+
+	TEST_F(StimulusBankTests, readContinuesWhereLastLeftOff) {
+		bankBuilder.add("a", { 0.1f, 0.2f, 0.3f });
+		auto reader_ = reader("a");
+		buffer_type x(2);
+		std::vector<channel_type> audio{ x };
+		reader_.read(audio);
+		reader_.read(audio);
+		assertEqual({ 0.3f, 0.2f }, x);
+		assertTrue(reader_.complete());
+	}
+
+	TEST_F(StimulusBankTests, resetReadsFromBeginning) {
+		bankBuilder.add("a", { 0.1f, 0.2f, 0.3f });
+		auto reader_ = reader("a");
+		buffer_type x(2);
+		std::vector<channel_type> audio{ x };
+		reader_.read(audio);
+		reader_.reset();
+		assertEqual(3LL, reader_.remainingFrames());
+	}
+
+	TEST_F(StimulusBankTests, prepareForPlaybackPrefaultsRemainingFramesOfEachChannel) {
+		bankBuilder.add("a", { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f }, 2);
+		auto mapping = std::make_shared<FileMappingStub>(bankBuilder.bytes());
+		auto bank_ = std::make_shared<StimulusBank>(mapping);
+		const auto entry = bank_->find("a");
+		StimulusBankReader reader_{ bank_, entry };
+		buffer_type left(1);
+		buffer_type right(1);
+		std::vector<channel_type> audio{ left, right };
+		reader_.read(audio);
+		reader_.prepareForPlayback();
+		const auto offset = entry->offset;
+		EXPECT_EQ(
+			(std::vector<std::pair<long long, long long>>{ 
+				{ offset + 4, 8 }, 
+				{ offset + 12 + 4, 8 } 
+			}),
+			mapping->prefaulted()
+		);
+	}
+
+	TEST_F(StimulusBankTests, findReturnsNullForUnknownStimulus) {
+		bankBuilder.add("a", { 1 });
+		assertTrue(bank(bankBuilder.bytes())->find("b") == nullptr);
+	}
+
+	TEST_F(StimulusBankTests, throwsFormatErrorWhenNotABank) {
+		assertFormatError({ 'R', 'I', 'F', 'F' }, "Not a stimulus bank.");
+	}
+
+	TEST_F(StimulusBankTests, throwsFormatErrorWhenIndexIsIncomplete) {
+		bankBuilder.add("a", { 1 });
+		auto bytes = bankBuilder.bytes();
+		bytes.resize(20);
+		assertFormatError(bytes, "Stimulus bank index is incomplete.");
+	}
+
+	TEST_F(StimulusBankTests, throwsFormatErrorWhenSamplesLieOutsideBank) {
+		bankBuilder.add("a", { 0.1f, 0.2f });
+		auto bytes = bankBuilder.bytes();
+		bytes.pop_back();
+		assertFormatError(bytes, "Stimulus 'a' lies outside its bank.");
+	}
+
+	class StimulusBankFactoryTests : public ::testing::Test {
+	protected:
+		BankBuilder bankBuilder{};
+		FileMapperStub mapper{};
+		AudioFrameReaderFactoryStub otherFiles{};
+		StimulusCacheStub otherStimuli{};
+		StimulusBankFactory factory{ &mapper, &otherFiles, &otherStimuli };
+
+		StimulusBankFactoryTests() {
+			mapper.fail();
+		}
+
+		void addBank(std::string directory) {
+			mapper.add(directory + "/" + StimulusBank::fileName, bankBuilder.bytes());
+		}
+	};
+
+	TEST_F(StimulusBankFactoryTests, makeReadsStimulusFromBankInItsDirectory) {
+		bankBuilder.add("a", { 0.1f, 0.2f, 0.3f });
+		addBank("d");
+		assertEqual(3LL, factory.make("d/a")->frames());
+	}
+
+	TEST_F(StimulusBankFactoryTests, makePassesStimuliNotInBankToOtherFactory) {
+		bankBuilder.add("a", { 1 });
+		addBank("d");
+		factory.make("d/b");
+		assertEqual("d/b", otherFiles.filePath());
+	}
+
+	TEST_F(StimulusBankFactoryTests, makePassesFilesInDirectoriesWithoutBankToOtherFactory) {
+		factory.make("e/a");
+		assertEqual("e/a", otherFiles.filePath());
+	}
+
+	TEST_F(StimulusBankFactoryTests, makeMapsEachDirectoryOnce) {
+		bankBuilder.add("a", { 1 });
+		addBank("d");
+		factory.make("d/a");
+		factory.make("d/a");
+		factory.make("e/a");
+		factory.make("e/a");
+		assertEqual(2, mapper.mapped());
+	}
+
+	TEST_F(StimulusBankFactoryTests, preloadPassesOnlyStimuliNotInBankToOtherCache) {
+		bankBuilder.add("a", { 1 });
+		addBank("d");
+		factory.preload({ "d/a", "d/b", "e/a" }, {});
+		assertEqual<std::string>({ "d/b", "e/a" }, otherStimuli.filePaths());
+	}
+
+	TEST_F(StimulusBankFactoryTests, preloadCountsBankedStimuliAsLoaded) {
+		bankBuilder.add("a", { 1 });
+		addBank("d");
+		std::vector<int> loaded;
+		factory.preload({ "d/a", "e/a" }, [&](int n, int total) {
+			assertEqual(2, total);
+			loaded.push_back(n);
+		});
+		assertEqual({ 1, 2 }, loaded);
+	}
+
+	TEST_F(StimulusBankFactoryTests, preloadDoesNotPassOnWhenEveryStimulusIsBanked) {
+		bankBuilder.add("a", { 1 });
+		addBank("d");
+		factory.preload({ "d/a" }, {});
+		assertEqual(0, otherStimuli.preloads());
+	}
+
+	class StimulusBankDirectoryReaderFactoryTests : public StimulusBankFactoryTests {
+	protected:
+		std::shared_ptr<DirectoryReaderStub> otherReader =
+			std::make_shared<DirectoryReaderStub>();
+		DirectoryReaderStubFactory otherDirectories{ otherReader };
+		StimulusBankDirectoryReaderFactory directories{ &factory, &otherDirectories };
+	};
+
+	TEST_F(StimulusBankDirectoryReaderFactoryTests, listsBankedStimuli) {
+		bankBuilder.add("a", { 1 });
+		bankBuilder.add("b", { 1 });
+		addBank("d");
+		assertEqual<std::string>({ "a", "b" }, directories.make("d")->files());
+	}
+
+	TEST_F(StimulusBankDirectoryReaderFactoryTests, passesDirectoriesWithoutBankToOtherFactory) {
+		otherReader->setFileNames({ "c" });
+		assertEqual<std::string>({ "c" }, directories.make("e")->files());
+		assertEqual("e", otherDirectories.directory());
+	}
+
+	TEST_F(StimulusBankDirectoryReaderFactoryTests, listingMapsBankAgain) {
+		bankBuilder.add("a", { 1 });
+		addBank("d");
+		factory.make("d/a");
+		directories.make("d");
+		factory.make("d/a");
+		assertEqual(2, mapper.mapped());
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/StimulusCache.h>
+
+class StimulusCacheStub : public StimulusCache {
+	std::vector<std::string> filePaths_{};
+	int preloads_{};
+public:
+	void preload(
+		std::vector<std::string> filePaths,
+		std::function<void(int loaded, int total)> progress
+	) override {
+		filePaths_ = std::move(filePaths);
+		++preloads_;
+		const auto total = static_cast<int>(filePaths_.size());
+		for (int i = 1; i <= total; ++i)
+			if (progress)
+				progress(i, total);
+	}
+
+	auto filePaths() const {
+		return filePaths_;
+	}
+
+	int preloads() const noexcept {
+		return preloads_;
+	}
+};
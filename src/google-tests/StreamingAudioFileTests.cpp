@@ -0,0 +1,221 @@
+#include "assert-utility.h"
+#include "FakeAudioFile.h"
+#include <audio-file-reading-writing/StreamingAudioFile.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+	// Decodes its first block, then waits to be released before decoding 
+	// the rest or, when told to, failing.
+	class StallingAudioFileReader : public FakeAudioFileReader {
+		std::atomic<bool> released{ false };
+		int reads{};
+		bool failing{};
+	public:
+		using FakeAudioFileReader::FakeAudioFileReader;
+
+		void failAfterFirstBlock() noexcept {
+			failing = true;
+		}
+
+		void release() noexcept {
+			released = true;
+		}
+
+		void readFrames(float *x, long long n) override {
+			if (reads++ > 0)
+				while (!released)
+					std::this_thread::yield();
+			if (failing && reads > 1)
+				throw std::runtime_error{ "error." };
+			FakeAudioFileReader::readFrames(x, n);
+		}
+	};
+
+	class StreamingAudioFileTests : public ::testing::Test {
+	protected:
+		using channel_type = AudioFrameReader::channel_type;
+		using buffer_type = std::vector<channel_type::element_type>;
+		std::shared_ptr<FakeAudioFileReader> file = 
+			std::make_shared<FakeAudioFileReader>();
+
+		std::shared_ptr<StreamingAudioFile> construct() {
+			return std::make_shared<StreamingAudioFile>(file, 2, 2);
+		}
+
+		buffer_type readMono(AudioFrameReader &reader, int frames) {
+			buffer_type x(frames);
+			std::vector<channel_type> mono{ x };
+			reader.read(mono);
+			return x;
+		}
+	};
+
+	TEST_F(StreamingAudioFileTests, readsMonoAcrossBlocks) {
+		file->setContents({ 1, 2, 3, 4, 5, 6, 7 });
+		auto reader = construct();
+		assertEqual({ 1, 2, 3 }, readMono(*reader, 3));
+		assertEqual({ 4, 5, 6, 7 }, readMono(*reader, 4));
+	}
+
+	TEST_F(StreamingAudioFileTests, readsStereoIntoSeparateChannels) {
+		file->setContents({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+		file->setChannels(2);
+		auto reader = construct();
+		buffer_type left(5);
+		buffer_type right(5);
+		std::vector<channel_type> stereo{ left, right };
+		reader->read(stereo);
+		assertEqual({ 1, 3, 5, 7, 9 }, left);
+		assertEqual({ 2, 4, 6, 8, 10 }, right);
+	}
+
+	TEST_F(StreamingAudioFileTests, readsNoMoreThanRemains) {
+		file->setContents({ 1, 2, 3 });
+		auto reader = construct();
+		assertEqual({ 1, 2, 3, 0 }, readMono(*reader, 4));
+		assertTrue(reader->complete());
+	}
+
+	TEST_F(StreamingAudioFileTests, tracksRemainingFrames) {
+		file->setContents({ 1, 2, 3, 4, 5 });
+		auto reader = construct();
+		assertEqual(5LL, reader->remainingFrames());
+		readMono(*reader, 3);
+		assertEqual(2LL, reader->remainingFrames());
+		assertFalse(reader->complete());
+	}
+
+	TEST_F(StreamingAudioFileTests, resetSeeksAndReadsFromBeginning) {
+		file->setContents({ 1, 2, 3, 4, 5, 6, 7 });
+		auto reader = construct();
+		readMono(*reader, 5);
+		reader->reset();
+		assertEqual(1, file->seeks());
+		assertEqual(7LL, reader->remainingFrames());
+		assertEqual({ 1, 2, 3, 4, 5, 6, 7 }, readMono(*reader, 7));
+	}
+
+	TEST_F(StreamingAudioFileTests, resetBeforeReadingDoesNotSeek) {
+		file->setContents({ 1, 2, 3 });
+		auto reader = construct();
+		reader->reset();
+		assertEqual(0, file->seeks());
+		assertEqual({ 1, 2, 3 }, readMono(*reader, 3));
+	}
+
+	TEST_F(StreamingAudioFileTests, readsNothingWhenChannelsDiffer) {
+		file->setContents({ 1, 2, 3, 4 });
+		file->setChannels(2);
+		auto reader = construct();
+		readMono(*reader, 2);
+		assertEqual(2LL, reader->remainingFrames());
+	}
+
+	TEST_F(StreamingAudioFileTests, passesFileFormat) {
+		file->setContents({ 1, 2, 3, 4, 5, 6 });
+		file->setChannels(2);
+		file->setSampleRate(3);
+		auto reader = construct();
+		assertEqual(2, reader->channels());
+		assertEqual(3, reader->sampleRate());
+		assertEqual(3LL, reader->frames());
+	}
+
+	TEST_F(StreamingAudioFileTests, failedFileThrowsFileError) {
+		file->fail();
+		file->setErrorMessage("error.");
+		try {
+			construct();
+			FAIL() << "Expected StreamingAudioFile::FileError.";
+		}
+		catch (const StreamingAudioFile::FileError &e) {
+			assertEqual(std::string{ "error." }, e.what());
+		}
+	}
+
+	TEST_F(StreamingAudioFileTests, readsSilenceRatherThanWaitOncePreparedForPlayback) {
+		auto stalling = std::make_shared<StallingAudioFileReader>(
+			std::vector<float>{ 1, 2, 3, 4, 5, 6 }
+		);
+		StreamingAudioFile reader{ stalling, 2, 2 };
+		reader.prepareForPlayback();
+		assertEqual({ 1, 2, 0 }, readMono(reader, 3));
+		assertEqual(4LL, reader.remainingFrames());
+		stalling->release();
+	}
+
+	TEST_F(StreamingAudioFileTests, prepareForPlaybackThrowsReadFailureWhenDecodingFails) {
+		auto stalling = std::make_shared<StallingAudioFileReader>(
+			std::vector<float>{ 1, 2, 3, 4, 5, 6 }
+		);
+		stalling->failAfterFirstBlock();
+		stalling->release();
+		StreamingAudioFile reader{ stalling, 2, 3 };
+		try {
+			reader.prepareForPlayback();
+			FAIL() << "Expected AudioFrameReader::ReadFailure.";
+		}
+		catch (const AudioFrameReader::ReadFailure &e) {
+			assertEqual(std::string{ "error." }, e.what());
+		}
+	}
+
+	TEST_F(StreamingAudioFileTests, decodingFailureWhilePlayingEndsFileEarly) {
+		auto stalling = std::make_shared<StallingAudioFileReader>(
+			std::vector<float>{ 1, 2, 3, 4, 5, 6 }
+		);
+		stalling->failAfterFirstBlock();
+		StreamingAudioFile reader{ stalling, 2, 2 };
+		reader.prepareForPlayback();
+		assertEqual({ 1, 2 }, readMono(reader, 2));
+		stalling->release();
+		while (!reader.complete())
+			readMono(reader, 1);
+		assertEqual(0LL, reader.remainingFrames());
+	}
+
+	TEST_F(StreamingAudioFileTests, factoryStreamsFilesAtLeastMinimumDuration) {
+		file->setContents({ 1, 2, 3, 4 });
+		file->setSampleRate(2);
+		FakeAudioFileFactory files{ file };
+		StreamingAudioFileFactory factory{ &files, 2 };
+		auto reader = factory.make({});
+		assertTrue(std::dynamic_pointer_cast<StreamingAudioFile>(reader) != nullptr);
+		assertEqual({ 1, 2, 3, 4 }, readMono(*reader, 4));
+	}
+
+	TEST_F(StreamingAudioFileTests, factoryReadsShorterFilesIntoMemory) {
+		file->setContents({ 1, 2, 3 });
+		file->setSampleRate(2);
+		FakeAudioFileFactory files{ file };
+		StreamingAudioFileFactory factory{ &files, 2 };
+		auto reader = factory.make({});
+		assertTrue(std::dynamic_pointer_cast<AudioFileInMemory>(reader) != nullptr);
+	}
+
+	TEST_F(StreamingAudioFileTests, factoryReadsShorterFilesIntoMemoryWithStorage) {
+		file->setContents({ 0.5, 0.25, 0.125 });
+		file->setSampleRate(2);
+		FakeAudioFileFactory files{ file };
+		StreamingAudioFileFactory factory{ &files, 2, AudioFileInMemory::Storage::compact };
+		auto reader = std::dynamic_pointer_cast<AudioFileInMemory>(factory.make({}));
+		assertEqual(3 * sizeof(std::int16_t), reader->bytes());
+	}
+
+	TEST_F(StreamingAudioFileTests, factoryThrowsCreateErrorWhenFileFails) {
+		file->fail();
+		file->setErrorMessage("error.");
+		FakeAudioFileFactory files{ file };
+		StreamingAudioFileFactory factory{ &files };
+		try {
+			factory.make({});
+			FAIL() << "Expected AudioFrameReaderFactory::CreateError.";
+		}
+		catch (const AudioFrameReaderFactory::CreateError &e) {
+			assertEqual(std::string{ "error." }, e.what());
+		}
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/TaskRunner.h>
+#include <deque>
+
+class TaskRunnerStub : public TaskRunner {
+	std::deque<std::function<void()>> tasks_{};
+	int awaited_{};
+	bool runningTasksWhenAwaited_{};
+public:
+	void run(std::function<void()> f) override {
+		tasks_.push_back(std::move(f));
+	}
+
+	void await() override {
+		++awaited_;
+		if (runningTasksWhenAwaited_)
+			runPendingTasks();
+	}
+
+	void runPendingTasks() {
+		while (!tasks_.empty()) {
+			auto task = std::move(tasks_.front());
+			tasks_.pop_front();
+			task();
+		}
+	}
+
+	void runTasksWhenAwaited() noexcept {
+		runningTasksWhenAwaited_ = true;
+	}
+
+	int pendingTasks() const noexcept {
+		return static_cast<int>(tasks_.size());
+	}
+
+	int awaited() const noexcept {
+		return awaited_;
+	}
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ArgumentCollection.h"
+#include <spatialized-hearing-aid-simulation/TemporaryFiles.h>
+
+class TemporaryFilesStub : public TemporaryFiles {
+	ArgumentCollection<std::string> removed_{};
+	std::string filePath_{ "temporary" };
+	std::string copiedFrom_{};
+	std::string copiedTo_{};
+	int made_{};
+public:
+	std::string make() override {
+		++made_;
+		return filePath_;
+	}
+
+	void copy(std::string from, std::string to) override {
+		copiedFrom_ = std::move(from);
+		copiedTo_ = std::move(to);
+	}
+
+	void remove(std::string filePath) override {
+		removed_.push_back(std::move(filePath));
+	}
+
+	void setFilePath(std::string s) {
+		filePath_ = std::move(s);
+	}
+
+	auto made() const {
+		return made_;
+	}
+
+	auto copiedFrom() const {
+		return copiedFrom_;
+	}
+
+	auto copiedTo() const {
+		return copiedTo_;
+	}
+
+	auto removed() const {
+		return removed_;
+	}
+};
+
+class CopyFailingTemporaryFiles : public TemporaryFiles {
+	std::string errorMessage{};
+public:
+	void setErrorMessage(std::string s) {
+		errorMessage = std::move(s);
+	}
+
+	std::string make() override {
+		return {};
+	}
+
+	void copy(std::string, std::string) override {
+		throw CopyFailure{ errorMessage };
+	}
+
+	void remove(std::string) override {}
+};
@@ -12,6 +12,7 @@ public:
 		std::string leftDslPrescriptionFilePath_{};
 		std::string rightDslPrescriptionFilePath_{};
 		std::string brirFilePath_{};
+		std::string processingGraphFilePath_{};
 		std::string audioFilePath_{};
 		std::string level_dB_Spl_{ "0" };
 		std::string attack_ms_{ "0" };
@@ -54,6 +55,10 @@ public:
 			return brirFilePath_;
 		}
 
+		std::string processingGraphFilePath() override {
+			return processingGraphFilePath_;
+		}
+
 		std::string level_dB_Spl() override {
 			return level_dB_Spl_;
 		}
@@ -102,6 +107,10 @@ public:
 			brirFilePath_ = std::move(p);
 		}
 
+		void setProcessingGraphFilePath(std::string p) override {
+			processingGraphFilePath_ = std::move(p);
+		}
+
 		void setLevel_dB_Spl(std::string level) {
 			level_dB_Spl_ = std::move(level);
 		}
@@ -165,6 +174,8 @@ public:
 	bool windowSizeDeactivated_{};
 	bool attack_msDeactivated_{};
 	bool release_msDeactivated_{};
+	int stimuliLoaded_{};
+	int stimuliToLoad_{};
 	bool playNextTrialButtonShown_{};
 	bool playNextTrialButtonHidden_{};
 	bool cancelBrowsingForSavingFile_{};
@@ -174,6 +185,10 @@ public:
 		listener_->browseForBrir();
 	}
 
+	void browseForProcessingGraph() {
+		listener_->browseForProcessingGraph();
+	}
+
 	void browseForRightDslPrescription() {
 		listener_->browseForRightDslPrescription();
 	}
@@ -194,6 +209,19 @@ public:
 		playNextTrialButtonShown_ = true;
 	}
 
+	void showStimuliLoaded(int loaded, int total) override {
+		stimuliLoaded_ = loaded;
+		stimuliToLoad_ = total;
+	}
+
+	auto stimuliLoaded() const noexcept {
+		return stimuliLoaded_;
+	}
+
+	auto stimuliToLoad() const noexcept {
+		return stimuliToLoad_;
+	}
+
 	bool everyItemInTesterViewHidden() noexcept {
 		return
 			playNextTrialButtonHidden_;
@@ -214,6 +242,10 @@ public:
 		listener_->saveAudio();
 	}
 
+	void sweepParameters() {
+		listener_->sweepParameters();
+	}
+
 	void stopCalibration() {
 		listener_->stopCalibration();
 	}
@@ -48,6 +48,10 @@ namespace {
 		auto reset() {
 			return loader.reset();
 		}
+
+		void prime(gsl::span<channel_type> silence) {
+			loader.prime(silence);
+		}
 	};
 
 	class ZeroPaddedLoaderTests : public ::testing::Test {
@@ -128,6 +132,31 @@ namespace {
 		assertFalse(loader.complete());
 	}
 
+	TEST_F(ZeroPaddedLoaderTests, primeProcessesThenResetsProcessor) {
+		auto loader = construct();
+		ZeroPaddedLoaderFacade::buffer_type x(3);
+		std::vector<ZeroPaddedLoaderFacade::channel_type> mono{ x };
+		loader.prime(mono);
+		assertEqual(x.data(), processor->audioBuffer().begin()->data());
+		assertEqual(1, processor->resets());
+	}
+
+	TEST_F(ZeroPaddedLoaderTests, primeDoesNotRead) {
+		auto loader = construct();
+		ZeroPaddedLoaderFacade::buffer_type x(3);
+		std::vector<ZeroPaddedLoaderFacade::channel_type> mono{ x };
+		loader.prime(mono);
+		assertTrue(reader->audioBuffer().empty());
+	}
+
+	TEST_F(ZeroPaddedLoaderTests, primePreparesReaderForPlayback) {
+		auto loader = construct();
+		ZeroPaddedLoaderFacade::buffer_type x(3);
+		std::vector<ZeroPaddedLoaderFacade::channel_type> mono{ x };
+		loader.prime(mono);
+		assertTrue(reader->log().contains("prepareForPlayback "));
+	}
+
 	class TimesTwo : public AudioFrameProcessor {
 		void process(gsl::span<channel_type> audio) override {
 			for (auto channel : audio)
@@ -136,6 +165,7 @@ namespace {
 		}
 
 		channel_type::index_type groupDelay() override { return {}; }
+		void reset() override {}
 	};
 
 	TEST_F(ZeroPaddedLoaderTests, loadReadsThenProcesses) {
@@ -153,6 +183,7 @@ namespace {
 		}
 
 		channel_type::index_type groupDelay() override { return {}; }
+		void reset() override {}
 	};
 
 	TEST_F(ZeroPaddedLoaderTests, loadPadsZerosBeforeProcessing) {
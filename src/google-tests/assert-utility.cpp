@@ -72,6 +72,11 @@ template void assertEqual(
 	double tolerance
 );
 
+template void assertEqual(
+	std::vector<int> expected,
+	std::vector<int> actual
+);
+
 template void assertEqual(
 	std::vector<std::string> expected,
 	std::vector<std::string> actual
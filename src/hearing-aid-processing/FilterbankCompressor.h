@@ -52,6 +52,7 @@ public:
 	virtual int channels() = 0;
 	virtual bool failed() = 0;
 	virtual int windowSize() = 0;
+	virtual void reset() = 0;
 };
 
 class FilterbankCompressorFactory {
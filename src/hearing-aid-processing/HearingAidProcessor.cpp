@@ -3,7 +3,13 @@
 HearingAidProcessor::HearingAidProcessor(
 	std::shared_ptr<FilterbankCompressor> compressor
 ) :
-	buffer(compressor->channels() * compressor->chunkSize() * 2),
+	HearingAidProcessor{ std::move(compressor), allocator_type{} } {}
+
+HearingAidProcessor::HearingAidProcessor(
+	std::shared_ptr<FilterbankCompressor> compressor,
+	const allocator_type &allocator
+) :
+	buffer(compressor->channels() * compressor->chunkSize() * 2, allocator),
 	compressor{ std::move(compressor) } 
 {
 	if (this->compressor->failed())
@@ -36,3 +42,7 @@ void HearingAidProcessor::process(signal_type signal) {
 auto HearingAidProcessor::groupDelay() -> index_type {
 	return compressor->windowSize() / 2;
 }
+
+void HearingAidProcessor::reset() {
+	compressor->reset();
+}
@@ -4,6 +4,7 @@
 #include <common-includes/RuntimeError.h>
 #include <gsl/gsl>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 #ifdef _WIN32
@@ -18,17 +19,23 @@
 
 class HearingAidProcessor {
 	// Order important for construction.
-	std::vector<FilterbankCompressor::complex_type> buffer;
+	std::pmr::vector<FilterbankCompressor::complex_type> buffer;
 	std::shared_ptr<FilterbankCompressor> compressor;
 public:
 	using signal_type = gsl::span<FilterbankCompressor::real_type>;
 	using index_type = signal_type::index_type;
+	using allocator_type = std::pmr::polymorphic_allocator<FilterbankCompressor::complex_type>;
 	HEARING_AID_PROCESSING_API explicit HearingAidProcessor(
 		std::shared_ptr<FilterbankCompressor>
 	);
+	HEARING_AID_PROCESSING_API HearingAidProcessor(
+		std::shared_ptr<FilterbankCompressor>,
+		const allocator_type &
+	);
     RUNTIME_ERROR(CompressorError)
 	HEARING_AID_PROCESSING_API void process(signal_type);
 	HEARING_AID_PROCESSING_API index_type groupDelay();
+	HEARING_AID_PROCESSING_API void reset();
 private:
 	void throwIfNotPowerOfTwo(int n, std::string name);
 };
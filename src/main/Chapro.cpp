@@ -2,12 +2,19 @@
 extern "C" {
 #include <cha_ff.h>
 }
+#include <cstring>
 
-Chapro::Chapro(Parameters parameters) :
+Chapro::Chapro(Parameters parameters_) :
+	parameters{ std::move(parameters_) },
 	channels_{ parameters.channels },
     chunkSize_{ parameters.chunkSize },
 	windowSize_{ parameters.windowSize }
 {
+	prepare();
+	keepPrepared();
+}
+
+void Chapro::prepare() {
 	CHA_DSL dsl{};
 	dsl.attack = parameters.attack_ms;
 	dsl.release = parameters.release_ms;
@@ -49,6 +56,39 @@ Chapro::Chapro(Parameters parameters) :
 	error |= cha_agc_prepare(cha_pointer, &dsl, &wdrc);
 }
 
+template<typename F>
+void Chapro::forEachBuffer(F f) {
+	const auto sizes = static_cast<int *>(cha_pointer[chaproSizesIndex]);
+	if (!sizes)
+		return;
+	for (int i = 0; i < NPTR; ++i)
+		if (i != chaproSizesIndex && cha_pointer[i] && sizes[i] > 0)
+			f(static_cast<char *>(cha_pointer[i]), static_cast<std::size_t>(sizes[i]));
+}
+
+// chapro keeps its filterbank history and compressor levels alongside the
+// coefficients, so a copy of every buffer is kept as prepared.
+void Chapro::keepPrepared() {
+	std::size_t total{};
+	forEachBuffer([&](char *, std::size_t size) { total += size; });
+	prepared.resize(total);
+	auto kept = prepared.data();
+	forEachBuffer([&](char *buffer, std::size_t size) {
+		std::memcpy(kept, buffer, size);
+		kept += size;
+	});
+}
+
+// Copying the buffers back clears the state without freeing them, so the 
+// memory warmed up before playback is the memory used during it.
+void Chapro::reset() {
+	auto kept = prepared.data();
+	forEachBuffer([&](char *buffer, std::size_t size) {
+		std::memcpy(buffer, kept, size);
+		kept += size;
+	});
+}
+
 Chapro::~Chapro() noexcept {
 	cha_cleanup(cha_pointer);
 }
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <hearing-aid-processing/FilterbankCompressor.h>
+#include <vector>
 extern "C" {
 #include <chapro.h>
 }
 
+// Where chapro records the byte size of each buffer it allocates.
+constexpr int chaproSizesIndex = _size;
+
 // These are (unfortunately) defined in chapro.h but appear in some standard headers
 #undef _size
 #undef fmin
@@ -18,9 +22,11 @@ extern "C" {
 
 class Chapro : public FilterbankCompressor {
 	void *cha_pointer[NPTR]{};
+	const Parameters parameters;
 	const int channels_;
 	const int chunkSize_;
 	const int windowSize_;
+	std::vector<char> prepared{};
 	int error = 0;
 public:
 	explicit Chapro(Parameters);
@@ -38,6 +44,12 @@ public:
 	int channels() override;
 	bool failed() override;
 	int windowSize() override;
+	void reset() override;
+private:
+	void prepare();
+	void keepPrepared();
+	template<typename F>
+		void forEachBuffer(F);
 };
 
 class ChaproFactory : public FilterbankCompressorFactory {
@@ -0,0 +1,15 @@
+#include "FileSystemFileVersions.h"
+#include <filesystem>
+
+std::string FileSystemFileVersions::version(const std::string &filePath) {
+	std::error_code error;
+	const auto size = std::filesystem::file_size(filePath, error);
+	if (error)
+		return {};
+	const auto written = std::filesystem::last_write_time(filePath, error);
+	if (error)
+		return {};
+	return 
+		std::to_string(size) + " " + 
+		std::to_string(written.time_since_epoch().count());
+}
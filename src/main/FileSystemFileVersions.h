@@ -0,0 +1,9 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/FileVersions.h>
+
+// A file's size and last write time.
+class FileSystemFileVersions : public FileVersions {
+public:
+	std::string version(const std::string &filePath) override;
+};
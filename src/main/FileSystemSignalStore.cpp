@@ -0,0 +1,70 @@
+#include "FileSystemSignalStore.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+// The time and a random number keep sessions apart; a name already taken 
+// is passed over. When no directory can be made the store stays empty and
+// every save fails, leaving signals in memory.
+static std::string makeSessionDirectory(const std::string &parent) {
+	std::random_device device;
+	for (int attempt = 0; attempt < 16; ++attempt) {
+		const auto now = std::chrono::system_clock::now().time_since_epoch().count();
+		const auto candidate =
+			std::filesystem::path{ parent } /
+			("spatialized-hearing-aid-simulation-signals-" + 
+				std::to_string(now) + "-" + std::to_string(device()));
+		std::error_code error;
+		if (std::filesystem::create_directory(candidate, error))
+			return candidate.string();
+		if (error)
+			return {};
+	}
+	return {};
+}
+
+FileSystemSignalStore::FileSystemSignalStore(std::string parentDirectory) :
+	directory{ makeSessionDirectory(parentDirectory) } {}
+
+FileSystemSignalStore::~FileSystemSignalStore() noexcept {
+	if (directory.empty())
+		return;
+	std::error_code ignored;
+	std::filesystem::remove_all(directory, ignored);
+}
+
+void FileSystemSignalStore::save(std::string name, gsl::span<const float> signal) {
+	if (directory.empty())
+		throw StoreFailure{ "Signal '" + name + "' cannot be saved; no directory could be made." };
+	std::ofstream file{ filePath(name), std::ios::binary };
+	file.write(
+		reinterpret_cast<const char *>(signal.data()), 
+		signal.size() * sizeof(float)
+	);
+	if (file.fail())
+		throw StoreFailure{ "Signal '" + name + "' cannot be saved to " + directory + "." };
+}
+
+void FileSystemSignalStore::load(std::string name, signal_type signal) {
+	if (directory.empty())
+		throw StoreFailure{ "Signal '" + name + "' cannot be loaded; no directory could be made." };
+	std::ifstream file{ filePath(name), std::ios::binary };
+	file.read(
+		reinterpret_cast<char *>(signal.data()), 
+		signal.size() * sizeof(float)
+	);
+	if (file.fail())
+		throw StoreFailure{ "Signal '" + name + "' cannot be loaded from " + directory + "." };
+}
+
+void FileSystemSignalStore::remove(std::string name) {
+	if (directory.empty())
+		return;
+	std::remove(filePath(name).c_str());
+}
+
+std::string FileSystemSignalStore::filePath(const std::string &name) const {
+	return directory + "/" + name + ".f32";
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/SignalStore.h>
+#include <string>
+
+// Signals are kept in a directory of their own, made inside the given one
+// and removed with everything in it on destruction, so neither other
+// running instances nor files left by earlier sessions are ever read.
+class FileSystemSignalStore : public SignalStore {
+	std::string directory;
+public:
+	explicit FileSystemSignalStore(std::string parentDirectory);
+	~FileSystemSignalStore() noexcept override;
+	void save(std::string name, gsl::span<const float>) override;
+	void load(std::string name, signal_type) override;
+	void remove(std::string name) override;
+private:
+	std::string filePath(const std::string &name) const;
+};
@@ -0,0 +1,31 @@
+#include "FileSystemTemporaryFiles.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+FileSystemTemporaryFiles::FileSystemTemporaryFiles(std::string directory) :
+	directory{ std::move(directory) } {}
+
+// The time keeps files made by other running instances apart.
+std::string FileSystemTemporaryFiles::make() {
+	const auto now = std::chrono::system_clock::now().time_since_epoch().count();
+	return 
+		directory + "/spatialized-hearing-aid-simulation-" + 
+		std::to_string(now) + "-" + std::to_string(made++) + ".wav";
+}
+
+void FileSystemTemporaryFiles::copy(std::string from, std::string to) {
+	std::error_code error;
+	std::filesystem::copy_file(
+		from, 
+		to, 
+		std::filesystem::copy_options::overwrite_existing, 
+		error
+	);
+	if (error)
+		throw CopyFailure{ "'" + from + "' cannot be copied to '" + to + "': " + error.message() };
+}
+
+void FileSystemTemporaryFiles::remove(std::string filePath) {
+	std::remove(filePath.c_str());
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/TemporaryFiles.h>
+#include <string>
+
+class FileSystemTemporaryFiles : public TemporaryFiles {
+	std::string directory;
+	int made{};
+public:
+	explicit FileSystemTemporaryFiles(std::string directory);
+	std::string make() override;
+	void copy(std::string from, std::string to) override;
+	void remove(std::string) override;
+};
@@ -35,6 +35,10 @@ void FltkView::onBrowseBrir(Fl_Widget *, void *self) {
 	static_cast<FltkView *>(self)->listener->browseForBrir();
 }
 
+void FltkView::onBrowseProcessingGraph(Fl_Widget *, void *self) {
+	static_cast<FltkView *>(self)->listener->browseForProcessingGraph();
+}
+
 void FltkView::onConfirmTestSetup(Fl_Widget *, void *self) {
 	static_cast<FltkView *>(self)->listener->confirmTestSetup();
 }
@@ -63,6 +67,10 @@ void FltkView::onSaveAudio(Fl_Widget *, void *self) {
 	static_cast<FltkView *>(self)->listener->saveAudio();
 }
 
+void FltkView::onSweepParameters(Fl_Widget *, void *self) {
+	static_cast<FltkView *>(self)->listener->sweepParameters();
+}
+
 static void hideAllChildren(Fl_Group *parent) {
 	auto children = parent->children();
 	for (auto i{ 0 }; i < children; ++i)
@@ -98,7 +106,8 @@ FltkCalibration::FltkCalibration(int x, int y, int w, int h, const char *) :
     browseForAudioFile{x + 310, y + 10, 80, 25, "browse..." },
 	play{ x + 25, y + 60, 60, 25, "play" },
 	stop{ x + 125, y + 60, 60, 25, "stop" },
-	save{ x + 225, y + 60, 60, 25, "save" }
+	save{ x + 225, y + 60, 60, 25, "save" },
+	sweep{ x + 325, y + 60, 60, 25, "sweep" }
 {
 	end();
 }
@@ -112,8 +121,10 @@ FltkTestSetupGroup::FltkTestSetupGroup(int x, int y, int w, int h, const char *)
 	testerId_{ 100, 35, 200, 25, "tester ID" },
 	testFilePath_{100, 85, 200, 25, "test file path" },
     stimulusList_{ 100, 60, 200, 25, "stimulus list" },
+	processingGraphFilePath_{100, 110, 200, 25, "processing graph" },
     browseTestFilePath{310, 85, 80, 25, "browse..." },
     browseForStimulusList{310, 60, 80, 25, "browse..." },
+	browseProcessingGraph{310, 110, 80, 25, "browse..." },
     confirm{850, 550, 60, 25, "confirm" },
     usingSpatialization_{ 425, 10, 18, 25, "spatialization" },
 	usingHearingAidSimulation_{ 425, 80, 18, 25, "hearing aid simulation" }
@@ -167,6 +178,7 @@ void FltkView::registerCallbacks() {
 	window.testSetup.browseForStimulusList.callback(onBrowseStimulusList, this);
 	window.testSetup.calibration.browseForAudioFile.callback(onBrowseAudio, this);
 	window.testSetup.spatialization.browseBrir.callback(onBrowseBrir, this);
+	window.testSetup.browseProcessingGraph.callback(onBrowseProcessingGraph, this);
 	window.testSetup.confirm.callback(onConfirmTestSetup, this);
 	window.testSetup.usingSpatialization_.callback(onToggleSpatialization, this);
 	window.testSetup.usingHearingAidSimulation_.callback(onToggleHearingAidSimulation, this);
@@ -174,6 +186,7 @@ void FltkView::registerCallbacks() {
 	window.testSetup.calibration.play.callback(onPlayCalibration, this);
 	window.testSetup.calibration.stop.callback(onStopCalibration, this);
 	window.testSetup.calibration.save.callback(onSaveAudio, this);
+	window.testSetup.calibration.sweep.callback(onSweepParameters, this);
 }
 
 void FltkView::turnOnHearingAidSimulation() {
@@ -195,6 +208,33 @@ void FltkView::showPlayNextTrialButton()
 	window.playNextTrial.show();
 }
 
+// Stimuli load on another thread, so the window is only touched once the
+// event loop wakes to the latest count.
+void FltkView::showStimuliLoaded(int loaded, int total) {
+	stimuliToLoad = total;
+	stimuliLoaded = loaded;
+	Fl::awake(onStimuliLoaded, this);
+}
+
+void FltkView::onStimuliLoaded(void *self) {
+	static_cast<FltkView *>(self)->redrawStimuliLoaded();
+}
+
+void FltkView::redrawStimuliLoaded() {
+	const int loaded = stimuliLoaded;
+	const int total = stimuliToLoad;
+	if (loaded == total) {
+		window.copy_label("");
+		window.playNextTrial.activate();
+	}
+	else {
+		std::stringstream stream;
+		stream << "loading stimuli: " << loaded << " of " << total;
+		window.copy_label(stream.str().c_str());
+		window.playNextTrial.deactivate();
+	}
+}
+
 void FltkView::deactivateBrowseForBrirButton() {
 	window.testSetup.spatialization.browseBrir.deactivate();
 }
@@ -291,7 +331,9 @@ std::string FltkView::audioDevice() {
 	return window.audioDevice_.text();
 }
 
+// Locking once lets other threads wake the event loop.
 void FltkView::runEventLoop() {
+	Fl::lock();
 	window.show();
 	Fl::run();
 }
@@ -408,6 +450,10 @@ void FltkView::FltkTestSetup::setBrirFilePath(std::string p) {
 	view->spatialization.brirFilePath_.value(p.c_str());
 }
 
+void FltkView::FltkTestSetup::setProcessingGraphFilePath(std::string p) {
+	view->processingGraphFilePath_.value(p.c_str());
+}
+
 void FltkView::FltkTestSetup::setAudioFilePath(std::string p)
 {
 	view->calibration.audioFilePath_.value(p.c_str());
@@ -445,6 +491,10 @@ std::string FltkView::FltkTestSetup::brirFilePath() {
 	return view->spatialization.brirFilePath_.value();
 }
 
+std::string FltkView::FltkTestSetup::processingGraphFilePath() {
+	return view->processingGraphFilePath_.value();
+}
+
 std::string FltkView::FltkTestSetup::level_dB_Spl() {
 	return view->calibration.level_dB_Spl_.value();
 }
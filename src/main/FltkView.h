@@ -12,6 +12,7 @@
 #include <FL/Fl_Check_Button.H>
 #include <FL/Fl.H>
 #pragma warning (pop)
+#include <atomic>
 
 struct Fl_ChoiceFacade : public Fl_Choice {
 	Fl_ChoiceFacade(int, int, int, int, const char * = {});
@@ -26,8 +27,9 @@ struct FltkSpatialization : public Fl_Group {
 
 struct FltkHearingAidSimulationGroup : public Fl_Group {
 	FltkHearingAidSimulationGroup(int, int, int, int, const char * = {});
-	Fl_Float_Input attack_ms_;
-	Fl_Float_Input release_ms_;
+	// Plain inputs, so a sweep's comma-separated lists can be entered.
+	Fl_Input attack_ms_;
+	Fl_Input release_ms_;
 	Fl_Input leftPrescriptionFilePath_;
 	Fl_Input rightPrescriptionFilePath_;
 	Fl_Button browseLeftPrescription;
@@ -44,6 +46,7 @@ struct FltkCalibration : public Fl_Group {
 	Fl_Button play;
 	Fl_Button stop;
 	Fl_Button save;
+	Fl_Button sweep;
 };
 
 struct FltkTestSetupGroup : Fl_Group {
@@ -55,8 +58,10 @@ struct FltkTestSetupGroup : Fl_Group {
 	Fl_Input testerId_;
 	Fl_Input testFilePath_;
 	Fl_Input stimulusList_;
+	Fl_Input processingGraphFilePath_;
 	Fl_Button browseTestFilePath;
 	Fl_Button browseForStimulusList;
+	Fl_Button browseProcessingGraph;
 	Fl_Button confirm;
 	Fl_Check_Button usingSpatialization_;
 	Fl_Check_Button usingHearingAidSimulation_;
@@ -78,6 +83,7 @@ public:
 		void setLeftDslPrescriptionFilePath(std::string) override;
 		void setRightDslPrescriptionFilePath(std::string) override;
 		void setBrirFilePath(std::string) override;
+		void setProcessingGraphFilePath(std::string) override;
 		void setTestFilePath(std::string) override;
 		void setAudioFilePath(std::string) override;
 		std::string subjectId() override;
@@ -88,6 +94,7 @@ public:
 		std::string leftDslPrescriptionFilePath() override;
 		std::string rightDslPrescriptionFilePath() override;
 		std::string brirFilePath() override;
+		std::string processingGraphFilePath() override;
 		std::string level_dB_Spl() override;
 		std::string attack_ms() override;
 		std::string release_ms() override;
@@ -136,6 +143,7 @@ public:
 	void deactivateChunkSize() override;
 	void hidePlayNextTrialButton() override;
 	void showPlayNextTrialButton() override;
+	void showStimuliLoaded(int loaded, int total) override;
 
 private:
 	void registerCallbacks();
@@ -147,6 +155,7 @@ private:
 	static void onBrowseStimulusList(Fl_Widget *, void *);
 	static void onBrowseAudio(Fl_Widget *, void *);
 	static void onBrowseBrir(Fl_Widget *, void *);
+	static void onBrowseProcessingGraph(Fl_Widget *, void *);
 	static void onConfirmTestSetup(Fl_Widget *, void *);
 	static void onPlayTrial(Fl_Widget *, void *);
 	static void onToggleSpatialization(Fl_Widget *, void *);
@@ -154,9 +163,14 @@ private:
 	static void onPlayCalibration(Fl_Widget *, void *);
 	static void onStopCalibration(Fl_Widget *, void *);
 	static void onSaveAudio(Fl_Widget *, void *);
+	static void onSweepParameters(Fl_Widget *, void *);
+	static void onStimuliLoaded(void *);
+	void redrawStimuliLoaded();
 
 	FltkWindow window;
 	FltkTestSetup testSetup_;
 	EventListener *listener{};
+	std::atomic<int> stimuliLoaded{};
+	std::atomic<int> stimuliToLoad{};
 	int browseResult{};
 };
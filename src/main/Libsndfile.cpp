@@ -12,6 +12,10 @@ void LibsndfileReader::readFrames(float *x, long long count) {
 	sf_readf_float(file, x, count);
 }
 
+void LibsndfileReader::seek(long long frame) {
+	sf_seek(file, frame, SEEK_SET);
+}
+
 long long LibsndfileReader::frames() {
 	return info.frames;
 }
@@ -15,6 +15,7 @@ public:
 	LibsndfileReader(const LibsndfileReader &) = delete;
 	LibsndfileReader &operator=(const LibsndfileReader &) = delete;
 	void readFrames(float *, long long) override;
+	void seek(long long frame) override;
 	long long frames() override;
 	int channels() override;
 	bool failed() override;
@@ -23,6 +23,10 @@ int NlohmannJsonParser::asInt(std::string property) {
 	return at<int>(std::move(property));
 }
 
+std::string NlohmannJsonParser::asString(std::string property) {
+	return at<std::string>(std::move(property));
+}
+
 std::shared_ptr<ConfigurationFileParser> NlohmannJsonParserFactory::make(std::string filePath) {
 	return std::make_shared<NlohmannJsonParser>(std::move(filePath));
 }
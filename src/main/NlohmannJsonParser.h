@@ -10,6 +10,7 @@ public:
 	std::vector<double> asVector(std::string property) override;
 	double asDouble(std::string property) override;
 	int asInt(std::string property) override;
+	std::string asString(std::string property) override;
 private:
 	template<typename T>
 	T at(std::string property) const {
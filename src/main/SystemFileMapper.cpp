@@ -0,0 +1,100 @@
+#include "SystemFileMapper.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	class SystemFileMapping : public FileMapping {
+		const unsigned char *view{};
+		std::size_t size{};
+	public:
+		SystemFileMapping(const void *view, std::size_t size) noexcept :
+			view{ static_cast<const unsigned char *>(view) },
+			size{ size } {}
+
+		~SystemFileMapping() noexcept override {
+#ifdef _WIN32
+			UnmapViewOfFile(view);
+#else
+			munmap(const_cast<unsigned char *>(view), size);
+#endif
+		}
+
+		SystemFileMapping(const SystemFileMapping &) = delete;
+		SystemFileMapping &operator=(const SystemFileMapping &) = delete;
+		SystemFileMapping(SystemFileMapping &&) = delete;
+		SystemFileMapping &operator=(SystemFileMapping &&) = delete;
+
+		gsl::span<const unsigned char> bytes() override {
+			return { view, gsl::narrow<gsl::span<const unsigned char>::index_type>(size) };
+		}
+
+		// Pages are at least this large everywhere the app runs, so reading
+		// one byte per step touches every page in range.
+		void prefault(long long offset, long long size_) override {
+			constexpr long long pageBytes = 4096;
+			const volatile unsigned char *first = view + offset;
+			unsigned char touched{};
+			for (long long i = 0; i < size_; i += pageBytes)
+				touched ^= first[i];
+			if (size_ > 0)
+				touched ^= first[size_ - 1];
+			static_cast<void>(touched);
+		}
+	};
+}
+
+// The view keeps the file mapped after its handles are closed.
+std::shared_ptr<FileMapping> SystemFileMapper::map(std::string filePath) {
+	const auto failure = "File '" + filePath + "' cannot be mapped.";
+#ifdef _WIN32
+	const auto file = CreateFileA(
+		filePath.c_str(), 
+		GENERIC_READ, 
+		FILE_SHARE_READ, 
+		nullptr, 
+		OPEN_EXISTING, 
+		FILE_ATTRIBUTE_NORMAL, 
+		nullptr
+	);
+	if (file == INVALID_HANDLE_VALUE)
+		throw MapFailure{ failure };
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		throw MapFailure{ failure };
+	}
+	const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+		throw MapFailure{ failure };
+	const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (view == nullptr)
+		throw MapFailure{ failure };
+	return std::make_shared<SystemFileMapping>(view, gsl::narrow<std::size_t>(size.QuadPart));
+#else
+	const auto file = open(filePath.c_str(), O_RDONLY);
+	if (file == -1)
+		throw MapFailure{ failure };
+	struct stat status{};
+	if (fstat(file, &status) == -1 || status.st_size == 0) {
+		close(file);
+		throw MapFailure{ failure };
+	}
+	const auto size = gsl::narrow<std::size_t>(status.st_size);
+	// Private or not, the mapping reads the file's own pages, so touching
+	// any beyond the end of a file truncated since raises SIGBUS.
+	const auto view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED)
+		throw MapFailure{ failure };
+	return std::make_shared<SystemFileMapping>(view, size);
+#endif
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <audio-file-reading-writing/FileMapping.h>
+
+class SystemFileMapper : public FileMapper {
+public:
+	std::shared_ptr<FileMapping> map(std::string filePath) override;
+};
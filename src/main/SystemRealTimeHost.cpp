@@ -0,0 +1,128 @@
+#include "SystemRealTimeHost.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define REAL_TIME_HOST_SSE
+#endif
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <algorithm>
+#endif
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#endif
+
+// Without permission for the highest real-time priority a lower one may
+// still be allowed: Linux caps unprivileged users at their RLIMIT_RTPRIO.
+static int allowedPriority() {
+#ifdef _WIN32
+	return THREAD_PRIORITY_TIME_CRITICAL;
+#else
+	const auto highest = sched_get_priority_max(SCHED_FIFO);
+#ifdef __linux__
+	rlimit limit{};
+	if (geteuid() != 0 && 
+		getrlimit(RLIMIT_RTPRIO, &limit) == 0 && 
+		limit.rlim_cur != RLIM_INFINITY
+	)
+		return static_cast<int>(std::min<rlim_t>(highest, limit.rlim_cur));
+#endif
+	return highest;
+#endif
+}
+
+SystemRealTimeHost::SystemRealTimeHost() :
+	priority{ allowedPriority() } {}
+
+bool SystemRealTimeHost::flushDenormals() {
+#if defined(REAL_TIME_HOST_SSE)
+	// Flush-to-zero and denormals-are-zero.
+	constexpr unsigned int ftzDaz = 0x8040;
+	_mm_setcsr(_mm_getcsr() | ftzDaz);
+	return (_mm_getcsr() & ftzDaz) == ftzDaz;
+#elif defined(__aarch64__)
+	// On ARM the one flush-to-zero bit covers both inputs and results.
+	constexpr unsigned long long flushToZero = 1ULL << 24;
+	unsigned long long fpcr;
+	__asm__ volatile("mrs %0, fpcr" : "=r"(fpcr));
+	__asm__ volatile("msr fpcr, %0" : : "r"(fpcr | flushToZero));
+	__asm__ volatile("mrs %0, fpcr" : "=r"(fpcr));
+	return (fpcr & flushToZero) != 0;
+#else
+	return false;
+#endif
+}
+
+#ifdef __APPLE__
+// Core Audio already runs its callbacks under a time constraint, which is
+// better than anything a fixed priority could give them.
+static bool hasTimeConstraint() {
+	thread_time_constraint_policy_data_t policy{};
+	mach_msg_type_number_t count = THREAD_TIME_CONSTRAINT_POLICY_COUNT;
+	boolean_t getDefault = FALSE;
+	const auto result = thread_policy_get(
+		pthread_mach_thread_np(pthread_self()),
+		THREAD_TIME_CONSTRAINT_POLICY,
+		reinterpret_cast<thread_policy_t>(&policy),
+		&count,
+		&getDefault
+	);
+	return result == KERN_SUCCESS && !getDefault;
+}
+#endif
+
+bool SystemRealTimeHost::raisePriority() {
+#ifdef _WIN32
+	return SetThreadPriority(GetCurrentThread(), priority) != 0;
+#else
+#ifdef __APPLE__
+	if (hasTimeConstraint())
+		return true;
+#endif
+	if (priority < sched_get_priority_min(SCHED_FIFO))
+		return false;
+	sched_param parameters{};
+	parameters.sched_priority = priority;
+	return pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) == 0;
+#endif
+}
+
+bool SystemRealTimeHost::pinToCore(int core) {
+	if (core < 0)
+		return false;
+#if defined(_WIN32)
+	if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+		return false;
+	return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << core) != 0;
+#elif defined(__linux__)
+	if (core >= CPU_SETSIZE)
+		return false;
+	cpu_set_t cores;
+	CPU_ZERO(&cores);
+	CPU_SET(core, &cores);
+	return pthread_setaffinity_np(pthread_self(), sizeof cores, &cores) == 0;
+#else
+	// macOS only takes affinity hints.
+	return false;
+#endif
+}
+
+bool SystemRealTimeHost::lockMemory() {
+#ifdef _WIN32
+	// Windows can only lock given ranges, within the working set minimum.
+	return false;
+#else
+	// Everything mapped so far, which includes the stimulus and processing
+	// just made. macOS refuses.
+	return mlockall(MCL_CURRENT) == 0;
+#endif
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <spatialized-hearing-aid-simulation/RealTimeSetupImpl.h>
+
+class SystemRealTimeHost : public RealTimeHost {
+	int priority;
+public:
+	// Chooses the real-time priority threads will ask for, so raising it 
+	// takes a single call.
+	SystemRealTimeHost();
+	bool flushDenormals() override;
+	bool raisePriority() override;
+	bool pinToCore(int) override;
+	bool lockMemory() override;
+};
@@ -5,10 +5,19 @@
 #include "NlohmannJsonParser.h"
 #include "FileSystemWriter.h"
 #include "MersenneTwisterRandomizer.h"
+#include "FileSystemSignalStore.h"
+#include "FileSystemTemporaryFiles.h"
+#include "FileSystemFileVersions.h"
+#include "SystemRealTimeHost.h"
+#include "SystemFileMapper.h"
 #include <audio-file-reading-writing/AudioFileWriterAdapter.h>
-#include <audio-file-reading-writing/AudioFileInMemory.h>
+#include <audio-file-reading-writing/StreamingAudioFile.h>
+#include <audio-file-reading-writing/MappedWavFile.h>
+#include <audio-file-reading-writing/StimulusBank.h>
+#include <audio-file-reading-writing/DecodedAudioCache.h>
 #include <binaural-room-impulse-response/BrirAdapter.h>
 #include <dsl-prescription/PrescriptionAdapter.h>
+#include <dsl-prescription/ProcessingGraphAdapter.h>
 #include <hearing-aid-processing/HearingAidProcessor.h>
 #include <fir-filtering/FirFilter.h>
 #include <signal-processing/ScalingProcessor.h>
@@ -18,53 +27,19 @@
 #include <stimulus-list/FileFilterDecorator.h>
 #include <test-documenting/TestDocumenterImpl.h>
 #include <spatialized-hearing-aid-simulation/ZeroPaddedLoader.h>
+#include <spatialized-hearing-aid-simulation/PipelinedLoader.h>
 #include <spatialized-hearing-aid-simulation/ChannelCopier.h>
-#include <spatialized-hearing-aid-simulation/SimulationChannelFactoryImpl.h>
+#include <spatialized-hearing-aid-simulation/ChannelProcessingGroup.h>
+#include <spatialized-hearing-aid-simulation/ParallelChannelProcessingGroup.h>
+#include <spatialized-hearing-aid-simulation/StaticSimulationChannelFactory.h>
 #include <spatialized-hearing-aid-simulation/CalibrationComputerImpl.h>
+#include <spatialized-hearing-aid-simulation/SignalCache.h>
+#include <spatialized-hearing-aid-simulation/BackgroundTaskRunner.h>
 #include <spatialized-hearing-aid-simulation/SpatialHearingAidModel.h>
+#include <filesystem>
+#include <fstream>
 #import <Foundation/Foundation.h>
 
-template<typename T>
-class SignalProcessorAdapter : public SignalProcessor {
-	T processor;
-public:
-	template<typename... Targs>
-	explicit SignalProcessorAdapter(Targs&&... args) : processor{ std::forward<Targs>(args)... } {}
-
-	void process(signal_type signal) override {
-		return processor.process(signal);
-	}
-
-	index_type groupDelay() override {
-		return processor.groupDelay();
-	}
-};
-
-class HearingAidFactoryImpl : public HearingAidFactory {
-	FilterbankCompressorFactory *compressorFactory;
-public:
-	explicit HearingAidFactoryImpl(FilterbankCompressorFactory *compressorFactory) : 
-		compressorFactory{ compressorFactory } {}
-
-	std::shared_ptr<SignalProcessor> make(FilterbankCompressor::Parameters p) override {
-		return std::make_shared<SignalProcessorAdapter<HearingAidProcessor>>(
-			compressorFactory->make(std::move(p))
-		);
-	}
-};
-
-class FirFilterFactoryImpl : public FirFilterFactory {
-	std::shared_ptr<SignalProcessor> make(BrirReader::impulse_response_type b) override {
-		return std::make_shared<SignalProcessorAdapter<FirFilter<float>>>(std::move(b));
-	}
-};
-
-class ScalarFactoryImpl : public ScalarFactory {
-	std::shared_ptr<SignalProcessor> make(float x) override {
-		return std::make_shared<SignalProcessorAdapter<ScalingProcessor<float>>>(x);
-	}
-};
-
 class CalibrationComputerFactoryImpl : public CalibrationComputerFactory {
 	std::shared_ptr<CalibrationComputer> make(AudioFrameReader *r) override {
 		return std::make_shared<CalibrationComputerImpl>(*r);
@@ -121,42 +96,100 @@ int main() {
 	MacOsDirectoryReaderFactory directoryReaderFactory{};
 	FileFilterDecoratorFactory fileDecorator{&directoryReaderFactory, ".wav"};
 	MersenneTwisterRandomizer randomizer{};
-	RandomizedStimulusList stimulusList{&fileDecorator, &randomizer};
 	FileSystemWriter persistentWriter;
 	TestDocumenterImpl testDocumenter{ &persistentWriter };
+	SystemRealTimeHost realTimeHost{};
+	RealTimeSetupImpl::Settings realTimeSettings{};
+	realTimeSettings.lockMemory = true;
+	RealTimeSetupImpl realTime{ &realTimeHost, realTimeSettings };
 	PortAudioDevice audioDevice{};
-	AudioDevicePlayer player{&audioDevice};
+	// The stream opens at the processing block size, so every callback 
+	// carries one block's work rather than some carrying a whole block and
+	// the rest none.
+	AudioDevicePlayer player{ &audioDevice, 0, &realTime };
 	ZeroPaddedLoaderFactory audioLoaderFactory{};
+	PipelinedLoaderFactory offlineLoaderFactory{};
 	LibsndfileFactory audioFileFactory{};
-	AudioFileInMemoryFactory inMemoryFactory{&audioFileFactory};
-	ChannelCopierFactory audioFrameReaderFactory{ &inMemoryFactory };
+	// Long maskers and soundscapes are decoded as they play rather than 
+	// all at once.
+	StreamingAudioFileFactory streamingFactory{
+		&audioFileFactory,
+		30,
+		AudioFileInMemory::Storage::compact
+	};
+	// Uncompressed WAV files are read in place from the page cache.
+	SystemFileMapper fileMapper{};
+	MappedWavFileFactory mappedWavFactory{ &fileMapper, &streamingFactory };
+	// Stimuli are decoded into memory when a test starts, a budget's worth.
+	DecodedAudioCache stimulusCache{
+		&audioFileFactory,
+		&mappedWavFactory,
+		std::size_t{ 2 } << 30
+	};
+	// A stimulus directory with a bank built for it has its stimuli read
+	// from the one mapped file, with nothing to decode.
+	StimulusBankFactory stimulusBanks{ &fileMapper, &stimulusCache, &stimulusCache };
+	StimulusBankDirectoryReaderFactory bankDirectories{ &stimulusBanks, &fileDecorator };
+	RandomizedStimulusList stimulusList{ &bankDirectories, &randomizer };
+	ChannelCopierFactory audioFrameReaderFactory{ &stimulusBanks };
 	AudioFileWriterAdapterFactory audioFrameWriterFactory{ &audioFileFactory };
 	NlohmannJsonParserFactory parserFactory{};
 	PrescriptionAdapter prescriptionReader{ &parserFactory };
 	BrirAdapter brirReader{ &audioFileFactory };
-	ScalarFactoryImpl scalarFactory{};
+	ProcessingGraphAdapter graphReader{ &parserFactory };
 	ChaproFactory compressorFactory{};
-	FirFilterFactoryImpl firFilterFactory{};
-	HearingAidFactoryImpl hearingAidFactory{&compressorFactory};
-	SimulationChannelFactoryImpl simulationFactory{
-		&scalarFactory, 
-		&firFilterFactory, 
-		&hearingAidFactory
-	};
+	StaticSimulationChannelFactory<
+		ScalingProcessor<float>, 
+		FirFilter<float>, 
+		HearingAidProcessor
+	> simulationFactory{ &compressorFactory };
 	CalibrationComputerFactoryImpl calibrationComputerFactory{};
+	ChannelProcessingGroupFactory sequentialGroupFactory{};
+	ParallelChannelProcessingGroupFactory parallelGroupFactory{};
+	// The callback thread takes one ear and a worker the other; leave
+	// headroom for the user interface and the device driver. Only chains
+	// with filtering or hearing aid stages use it; gain alone stays on the
+	// callback thread.
+	ProcessingGroupFactory *groupFactory = std::thread::hardware_concurrency() >= 4
+		? static_cast<ProcessingGroupFactory *>(&parallelGroupFactory)
+		: &sequentialGroupFactory;
+	FileSystemSignalStore spillStore{ std::filesystem::temp_directory_path().string() };
+	FileSystemTemporaryFiles temporaryFiles{ std::filesystem::temp_directory_path().string() };
+	FileSystemFileVersions fileVersions{};
+	SignalCache renderedStimuli{ &spillStore, std::size_t{ 256 } << 20 };
+	// Stimuli preloading in the background report to the view, so it must
+	// outlive the runners.
+	FltkView view{};
+	BackgroundTaskRunner preRendering{};
+	BackgroundTaskRunner preloading{};
 	SpatialHearingAidModel model{
 		&stimulusList,
 		&testDocumenter,
 		&player,
 		&audioLoaderFactory,
+		&offlineLoaderFactory,
 		&audioFrameReaderFactory,
 		&audioFrameWriterFactory,
 		&prescriptionReader, 
 		&brirReader, 
+		&graphReader, 
 		&simulationFactory,
-		&calibrationComputerFactory
+		&calibrationComputerFactory,
+		groupFactory,
+		&renderedStimuli,
+		&preRendering,
+		&temporaryFiles,
+		&realTime,
+		&stimulusBanks,
+		&fileVersions,
+		&preloading
 	};
-	FltkView view{};
 	Presenter presenter{ &model, &view };
 	presenter.run();
+	// Whether playback threads got what they asked for, for whoever 
+	// investigates glitches.
+	std::ofstream realTimeLog{ 
+		std::filesystem::temp_directory_path() / "spatialized-hearing-aid-simulation-real-time.log" 
+	};
+	realTimeLog << realTime.summary();
 }
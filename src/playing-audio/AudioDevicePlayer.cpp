@@ -1,7 +1,14 @@
 #include "AudioDevicePlayer.h"
-
-AudioDevicePlayer::AudioDevicePlayer(AudioDevice *device) :
-	device{ device }
+#include "BlockSizeAdapter.h"
+
+AudioDevicePlayer::AudioDevicePlayer(
+	AudioDevice *device, 
+	int framesPerDeviceBuffer,
+	RealTimeSetup *realTime
+) :
+	device{ device },
+	realTime{ realTime },
+	framesPerDeviceBuffer{ framesPerDeviceBuffer }
 {
 	throwIfDeviceFailed<DeviceFailure>();
 	device->setController(this);
@@ -14,7 +21,26 @@ void AudioDevicePlayer::throwIfDeviceFailed() {
 }
 
 void AudioDevicePlayer::setAudioLoader(std::shared_ptr<AudioLoader> loader_) {
-	loader = std::move(loader_);
+	source = std::move(loader_);
+	loaderWarm = false;
+	adaptLoader();
+	warmUp();
+}
+
+void AudioDevicePlayer::adaptLoader() {
+	loader = adapting() && source
+		? std::make_shared<BlockSizeAdapter>(
+			source, 
+			gsl::narrow<int>(audio.size()), 
+			framesPerBlock
+		)
+		: source;
+}
+
+bool AudioDevicePlayer::adapting() const noexcept {
+	return framesPerDeviceBuffer > 0 && 
+		framesPerBlock > 0 && 
+		framesPerDeviceBuffer != framesPerBlock;
 }
 
 void AudioDevicePlayer::prepareToPlay(Preparation p) {
@@ -25,7 +51,28 @@ void AudioDevicePlayer::prepareToPlay(Preparation p) {
 
 void AudioDevicePlayer::prepareToPlay_(Preparation p) {
 	audio.resize(p.channels);
+	framesPerBlock = p.framesPerBuffer;
+	adaptLoader();
 	reopenStream(std::move(p));
+	warmUp();
+}
+
+void AudioDevicePlayer::warmUp() {
+	if (loaderWarm || !loader || audio.empty() || framesPerBlock <= 0 || device->streaming())
+		return;
+
+	const auto frames = adapting() ? framesPerDeviceBuffer : framesPerBlock;
+	std::vector<std::vector<AudioLoader::channel_type::element_type>> silence(
+		audio.size(),
+		std::vector<AudioLoader::channel_type::element_type>(gsl::narrow<std::size_t>(frames))
+	);
+	std::vector<AudioLoader::channel_type> scratch{};
+	for (auto &channel : silence)
+		scratch.push_back(channel);
+	loader->prime(scratch);
+	loaderWarm = true;
+	if (realTime)
+		realTime->lockMemory();
 }
 
 void AudioDevicePlayer::reopenStream(Preparation p) {
@@ -39,7 +86,9 @@ void AudioDevicePlayer::openStream(Preparation p) {
 	AudioDevice::StreamParameters streaming;
 	streaming.sampleRate = p.sampleRate;
 	streaming.channels = p.channels;
-	streaming.framesPerBuffer = p.framesPerBuffer;
+	streaming.framesPerBuffer = adapting() 
+		? framesPerDeviceBuffer 
+		: p.framesPerBuffer;
 	streaming.deviceIndex = findDeviceIndex(p.audioDevice);
 	device->openStream(std::move(streaming));
 }
@@ -52,7 +101,9 @@ int AudioDevicePlayer::findDeviceIndex(std::string deviceName) {
 	return deviceIndex;
 }
 
+// A stream may be given a new callback thread each time it starts.
 void AudioDevicePlayer::play() {
+	callbackThreadConfigured = false;
 	device->startStream();
 }
 
@@ -61,6 +112,8 @@ void AudioDevicePlayer::stop() {
 }
 
 void AudioDevicePlayer::fillStreamBuffer(void * channels, int frames) {
+	if (realTime && !callbackThreadConfigured.exchange(true))
+		realTime->configureCurrentThread();
 	prepareAudioForLoading(channels, frames);
 	loader->load(audio);
 	signalDeviceIfDoneLoading();
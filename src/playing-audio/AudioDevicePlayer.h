@@ -4,13 +4,29 @@
 #include "playing-audio-exports.h"
 #include <spatialized-hearing-aid-simulation/AudioLoader.h>
 #include <spatialized-hearing-aid-simulation/AudioPlayer.h>
+#include <spatialized-hearing-aid-simulation/RealTimeSetup.h>
+#include <atomic>
 
 class AudioDevicePlayer : public AudioDeviceController, public AudioPlayer {
 	std::vector<AudioLoader::channel_type> audio;
+	std::shared_ptr<AudioLoader> source{};
 	std::shared_ptr<AudioLoader> loader{};
 	AudioDevice *device;
+	RealTimeSetup *realTime;
+	std::atomic<bool> callbackThreadConfigured{ false };
+	int framesPerDeviceBuffer;
+	int framesPerBlock{};
+	bool loaderWarm{};
 public:
-	explicit PLAYING_AUDIO_API AudioDevicePlayer(AudioDevice *);
+	// Without a device buffer size the stream is opened at the block size 
+	// loaders expect; otherwise loads go through a BlockSizeAdapter.
+	// With a real-time setup, each stream's callback thread is configured
+	// by its first callback and memory is locked after every warm-up.
+	explicit PLAYING_AUDIO_API AudioDevicePlayer(
+		AudioDevice *,
+		int framesPerDeviceBuffer = 0,
+		RealTimeSetup * = nullptr
+	);
 	PLAYING_AUDIO_API void prepareToPlay(Preparation) override;
 	PLAYING_AUDIO_API std::vector<std::string> audioDeviceDescriptions() override;
 	PLAYING_AUDIO_API void setAudioLoader(std::shared_ptr<AudioLoader>) override;
@@ -19,11 +35,17 @@ public:
 	PLAYING_AUDIO_API void stop() override;
 	PLAYING_AUDIO_API void play() override;
 private:
+	// Before the stream starts each new loader's processing is run over 
+	// silence and reset, so the first callback does not pay for cold caches 
+	// and untouched pages.
+	void warmUp();
 	void prepareToPlay_(Preparation);
 	void reopenStream(Preparation);
 	template<typename exception>
 		void throwIfDeviceFailed();
 	void openStream(Preparation);
+	void adaptLoader();
+	bool adapting() const noexcept;
 	void prepareAudioForLoading(void * channels, int frames);
 	void signalDeviceIfDoneLoading();
 	int findDeviceIndex(std::string deviceName);
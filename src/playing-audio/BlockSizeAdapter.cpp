@@ -0,0 +1,70 @@
+#include "BlockSizeAdapter.h"
+#include <algorithm>
+
+BlockSizeAdapter::BlockSizeAdapter(
+	std::shared_ptr<AudioLoader> loader,
+	int channels,
+	int framesPerBlock
+) :
+	fifo(
+		gsl::narrow<std::size_t>(channels),
+		std::vector<channel_type::element_type>(gsl::narrow<std::size_t>(framesPerBlock))
+	),
+	loader{ std::move(loader) },
+	framesPerBlock{ framesPerBlock },
+	head{ framesPerBlock }
+{
+	for (auto &channel : fifo)
+		block.push_back(channel);
+}
+
+void BlockSizeAdapter::load(gsl::span<channel_type> audio) {
+	const auto frames = audio.size() ? audio.begin()->size() : 0;
+	const auto channels = audio.first(std::min(
+		audio.size(), 
+		gsl::narrow<gsl::span<channel_type>::index_type>(block.size())
+	));
+	channel_type::index_type offset{ 0 };
+	while (offset < frames) {
+		if (head == framesPerBlock) {
+			if (loader->complete()) {
+				for (auto channel : audio)
+					std::fill(channel.begin() + offset, channel.end(), 0.0f);
+				return;
+			}
+			loader->load(block);
+			head = 0;
+		}
+		const auto count = std::min(framesPerBlock - head, frames - offset);
+		fill(channels, offset, count);
+		head += count;
+		offset += count;
+	}
+}
+
+void BlockSizeAdapter::fill(
+	gsl::span<channel_type> audio,
+	channel_type::index_type offset,
+	channel_type::index_type count
+) {
+	for (channel_type::index_type i{ 0 }; i < audio.size(); ++i)
+		std::copy_n(
+			block.at(i).begin() + head,
+			count,
+			audio.at(i).begin() + offset
+		);
+}
+
+// The wrapped loader only ever sees whole blocks, so it is primed with one,
+// unless frames of a loaded block are still waiting to be handed out.
+void BlockSizeAdapter::prime(gsl::span<channel_type>) {
+	if (head != framesPerBlock)
+		return;
+	for (auto channel : block)
+		std::fill(channel.begin(), channel.end(), 0.0f);
+	loader->prime(block);
+}
+
+bool BlockSizeAdapter::complete() {
+	return head == framesPerBlock && loader->complete();
+}
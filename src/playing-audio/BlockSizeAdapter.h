@@ -0,0 +1,37 @@
+#pragma once
+
+#include "playing-audio-exports.h"
+#include <spatialized-hearing-aid-simulation/AudioLoader.h>
+#include <memory>
+#include <vector>
+
+// Lets the device ask for buffers of any size while the loader it wraps is
+// always asked for whole blocks. Each block is loaded on demand into a FIFO
+// allocated up front and handed out across as many device buffers as it
+// spans. No sample is delayed or dropped, so the wrapped loader still pads
+// zeros for exactly its processor's group delay; what is added is the time
+// a processed frame may wait in the FIFO before the device takes it. A 
+// block is processed by the callback that first needs it, so that callback
+// carries the whole block's work.
+class BlockSizeAdapter : public AudioLoader {
+	std::vector<std::vector<channel_type::element_type>> fifo;
+	std::vector<channel_type> block;
+	std::shared_ptr<AudioLoader> loader;
+	channel_type::index_type framesPerBlock;
+	channel_type::index_type head;
+public:
+	PLAYING_AUDIO_API BlockSizeAdapter(
+		std::shared_ptr<AudioLoader>,
+		int channels,
+		int framesPerBlock
+	);
+	PLAYING_AUDIO_API void load(gsl::span<channel_type> audio) override;
+	PLAYING_AUDIO_API void prime(gsl::span<channel_type> silence) override;
+	PLAYING_AUDIO_API bool complete() override;
+private:
+	void fill(
+		gsl::span<channel_type> audio,
+		channel_type::index_type offset,
+		channel_type::index_type count
+	);
+};
@@ -2,6 +2,7 @@
 
 #include <common-includes/Interface.h>
 #include <common-includes/RuntimeError.h>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -14,12 +15,14 @@ public:
 		std::string leftDslPrescriptionFilePath;
 		std::string rightDslPrescriptionFilePath;
 		std::string brirFilePath;
+		std::string processingGraphFilePath;
 		double attack_ms;
 		double release_ms;
 		int windowSize{ 256 };
 		int chunkSize{ 1024 };
 		bool usingHearingAidSimulation;
 		bool usingSpatialization;
+		bool usingProcessingGraph{ false };
 	};
 
 	struct Testing {
@@ -28,6 +31,9 @@ public:
 		std::string testerId;
 		std::string audioDirectory;
 		std::string testFilePath;
+		// Told how many of the test's stimuli are loaded, first before any 
+		// are and then as they load on a background thread.
+		std::function<void(int loaded, int total)> stimuliLoaded;
 	};
 	virtual void prepareNewTest(const Testing &) = 0;
 
@@ -43,6 +49,7 @@ public:
 		std::string audioFilePath;
 		double level_dB_Spl;
 	};
+	// Playing calibration while it plays changes it without stopping.
 	virtual void playCalibration(const Calibration &) = 0;
 	virtual void stopCalibration() = 0;
 
@@ -54,6 +61,18 @@ public:
 	virtual void processAudioForSaving(const SavingAudio &) = 0;
 	virtual void saveAudio(std::string filePath) = 0;
 
+	// Saves the input processed once for every pairing of the attack and 
+	// release times given, each into its own file in the output directory.
+	struct ParameterSweeping {
+		SignalProcessing processing;
+		std::string inputAudioFilePath;
+		std::string outputDirectory;
+		std::vector<double> attack_ms;
+		std::vector<double> release_ms;
+		double level_dB_Spl;
+	};
+	virtual void sweepParameters(const ParameterSweeping &) = 0;
+
 	virtual std::vector<std::string> audioDeviceDescriptions() = 0;
 	virtual bool testComplete() = 0;
 };
@@ -112,6 +112,13 @@ void Presenter::browseForBrir() {
 	);
 }
 
+void Presenter::browseForProcessingGraph() {
+	applyIfBrowseNotCancelled(
+		view->browseForOpeningFile({ "*.json" }), 
+		[=](std::string p) { view->testSetup()->setProcessingGraphFilePath(std::move(p)); }
+	);
+}
+
 void Presenter::confirmTestSetup() {
 	try {
 		prepareNewTest();
@@ -142,12 +149,19 @@ Model::Testing Presenter::testing() {
 	testing_.audioDirectory = view->testSetup()->stimulusList();
 	testing_.subjectId = view->testSetup()->subjectId();
 	testing_.testerId = view->testSetup()->testerId();
+	testing_.stimuliLoaded = [=](int loaded, int total) { 
+		view->showStimuliLoaded(loaded, total); 
+	};
 	return testing_;
 }
 
 Model::SignalProcessing Presenter::signalProcessing() {
 	Model::SignalProcessing p;
-	if (view->usingHearingAidSimulation()) {
+	p.processingGraphFilePath = view->testSetup()->processingGraphFilePath();
+	// An entered graph replaces the fixed chain; its hearing aid nodes use
+	// the same compression parameters.
+	p.usingProcessingGraph = !p.processingGraphFilePath.empty();
+	if (view->usingHearingAidSimulation() || p.usingProcessingGraph) {
 		p.attack_ms = convertToDouble(view->testSetup()->attack_ms(), "attack time");
 		p.release_ms = convertToDouble(view->testSetup()->release_ms(), "release time");
 		p.chunkSize = convertToPositiveInteger(view->testSetup()->chunkSize(), "chunk size");
@@ -177,6 +191,26 @@ double Presenter::convertToDouble(
 	}
 }
 
+std::vector<double> Presenter::convertToDoubles(
+	std::string x,
+	std::string identifier
+) {
+	std::vector<double> values;
+	std::string::size_type first = 0;
+	for (auto separator = x.find(','); ; separator = x.find(',', first)) {
+		auto item = x.substr(first, separator - first);
+		auto begin = item.find_first_not_of(' ');
+		auto end = item.find_last_not_of(' ');
+		values.push_back(convertToDouble(
+			begin == std::string::npos ? std::string{} : item.substr(begin, end - begin + 1),
+			identifier
+		));
+		if (separator == std::string::npos)
+			return values;
+		first = separator + 1;
+	}
+}
+
 static bool containsOnlyDigits(std::string s) noexcept {
 	return s.find_first_not_of("0123456789") == std::string::npos;
 }
@@ -248,6 +282,30 @@ void Presenter::saveAudio_() {
 		model->saveAudio(save);
 }
 
+void Presenter::sweepParameters() {
+	try {
+		sweepParameters_();
+	}
+	catch (const std::runtime_error &e) {
+		view->showErrorDialog(e.what());
+	}
+}
+
+void Presenter::sweepParameters_() {
+	Model::ParameterSweeping sweeping_;
+	sweeping_.inputAudioFilePath = view->testSetup()->audioFilePath();
+	sweeping_.level_dB_Spl = convertToDouble(view->testSetup()->level_dB_Spl(), "level");
+	sweeping_.processing = signalProcessing();
+	// The attack and release fields each take a comma-separated list here.
+	sweeping_.attack_ms = convertToDoubles(view->testSetup()->attack_ms(), "attack time");
+	sweeping_.release_ms = convertToDoubles(view->testSetup()->release_ms(), "release time");
+	auto directory = view->browseForDirectory();
+	if (!view->browseCancelled()) {
+		sweeping_.outputDirectory = std::move(directory);
+		model->sweepParameters(sweeping_);
+	}
+}
+
 void Presenter::playCalibration() {
 	try {
 		playCalibration_();
@@ -26,6 +26,7 @@ public:
 	void browseForRightDslPrescription() override;
 	void browseForStimulusList() override;
 	void browseForBrir() override;
+	void browseForProcessingGraph() override;
 	void confirmTestSetup() override;
 	void playNextTrial() override;
 	void toggleUsingSpatialization() override;
@@ -34,6 +35,7 @@ public:
 	void stopCalibration() override;
 	void browseForAudioFile() override;
 	void saveAudio() override;
+	void sweepParameters() override;
 
 private:
 	void toggleSpatializationActivation();
@@ -55,11 +57,13 @@ private:
 	Model::SignalProcessing signalProcessing();
     RUNTIME_ERROR(BadInput)
 	double convertToDouble(std::string x, std::string identifier);
+	std::vector<double> convertToDoubles(std::string x, std::string identifier);
 	int convertToPositiveInteger(std::string x, std::string identifier);
 	int convertToInteger(std::string x, std::string identifier);
 	void playTrial_();
 	void playCalibration_();
 	void saveAudio_();
+	void sweepParameters_();
 	void switchViewIfTestComplete();
 	void hideTesterView();
 };
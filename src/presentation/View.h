@@ -19,6 +19,7 @@ public:
 		virtual std::string stimulusList() = 0;
 		virtual std::string audioFilePath() = 0;
 		virtual std::string brirFilePath() = 0;
+		virtual std::string processingGraphFilePath() = 0;
 		virtual std::string level_dB_Spl() = 0;
 		virtual std::string attack_ms() = 0;
 		virtual std::string release_ms() = 0;
@@ -29,6 +30,7 @@ public:
 		virtual void setRightDslPrescriptionFilePath(std::string) = 0;
 		virtual void setStimulusList(std::string) = 0;
 		virtual void setBrirFilePath(std::string) = 0;
+		virtual void setProcessingGraphFilePath(std::string) = 0;
 		virtual void setAudioFilePath(std::string) = 0;
 	};
 
@@ -41,6 +43,7 @@ public:
 		virtual void browseForRightDslPrescription() = 0;
 		virtual void browseForStimulusList() = 0;
 		virtual void browseForBrir() = 0;
+		virtual void browseForProcessingGraph() = 0;
 		virtual void toggleUsingSpatialization() = 0;
 		virtual void toggleUsingHearingAidSimulation() = 0;
 		virtual void playCalibration() = 0;
@@ -48,6 +51,7 @@ public:
 		virtual void confirmTestSetup() = 0;
 		virtual void playNextTrial() = 0;
 		virtual void saveAudio() = 0;
+		virtual void sweepParameters() = 0;
 	};
 
     INTERFACE_OPERATIONS(View)
@@ -87,4 +91,7 @@ public:
 	virtual void deactivateChunkSize() = 0;
 	virtual void hidePlayNextTrialButton() = 0;
 	virtual void showPlayNextTrialButton() = 0;
+	// Called from the thread loading stimuli; trials are not played until
+	// all of them are loaded.
+	virtual void showStimuliLoaded(int loaded, int total) = 0;
 };
@@ -14,4 +14,12 @@ auto ScalingProcessor<T>::groupDelay() -> index_type {
 	return index_type{ 0 };
 }
 
+template<typename T>
+void ScalingProcessor<T>::reset() {}
+
+template<typename T>
+void ScalingProcessor<T>::setScale(T s) {
+	scale = s;
+}
+
 template class ScalingProcessor<float>;
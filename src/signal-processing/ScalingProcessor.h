@@ -21,5 +21,7 @@ public:
 	SIGNAL_PROCESSING_API explicit ScalingProcessor(T scale);
 	SIGNAL_PROCESSING_API void process(signal_type signal);
 	SIGNAL_PROCESSING_API index_type groupDelay();
+	SIGNAL_PROCESSING_API void reset();
+	SIGNAL_PROCESSING_API void setScale(T);
 };
 
@@ -9,4 +9,6 @@ public:
 	using channel_type = gsl::span<float>;
 	virtual void process(gsl::span<channel_type> audio) = 0;
 	virtual channel_type::index_type groupDelay() = 0;
+	// Returns to the state it was made in.
+	virtual void reset() = 0;
 };
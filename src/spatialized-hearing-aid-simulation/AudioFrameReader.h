@@ -16,6 +16,11 @@ public:
 	virtual long long frames() = 0;
 	virtual void reset() = 0;
     virtual long long remainingFrames() = 0;
+	// Called off the audio thread just before the reader is played from the
+	// device's callback. Reads from then on, until a reset, must neither 
+	// block nor throw.
+	virtual void prepareForPlayback() = 0;
+	RUNTIME_ERROR(ReadFailure)
 };
 
 class AudioFrameReaderFactory {
@@ -5,10 +5,16 @@
 #include <common-includes/Interface.h>
 #include <gsl/gsl>
 
+// Loaders run on the audio device's callback thread. Once made, neither they
+// nor anything they call may allocate.
 class AudioLoader {
 public:
     INTERFACE_OPERATIONS(AudioLoader)
 	virtual bool complete() = 0;
 	using channel_type = gsl::span<float>;
 	virtual void load(gsl::span<channel_type> audio) = 0;
+	// Runs whatever processing a load would over the given silence, then
+	// returns that processing to its initial state. Reads nothing, but 
+	// readers a load reads from the callback are prepared for playback.
+	virtual void prime(gsl::span<channel_type> silence) = 0;
 };
@@ -14,9 +14,9 @@ public:
 
 	struct Preparation {
 		std::string audioDevice;
-		int framesPerBuffer;
+		int framesPerBuffer{};
 		int channels = 0;
-		int sampleRate;
+		int sampleRate{};
 	};
 	virtual void prepareToPlay(Preparation) = 0;
     RUNTIME_ERROR(PreparationFailure)
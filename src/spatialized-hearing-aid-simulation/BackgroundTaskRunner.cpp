@@ -0,0 +1,49 @@
+#include "BackgroundTaskRunner.h"
+
+BackgroundTaskRunner::BackgroundTaskRunner() :
+	worker{ [this]() { work(); } } {}
+
+BackgroundTaskRunner::~BackgroundTaskRunner() noexcept {
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		stopping = true;
+	}
+	changed.notify_all();
+	worker.join();
+}
+
+void BackgroundTaskRunner::run(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		tasks.push_back(std::move(task));
+	}
+	changed.notify_all();
+}
+
+void BackgroundTaskRunner::await() {
+	std::unique_lock<std::mutex> lock{ mutex };
+	changed.wait(lock, [this]() { return tasks.empty() && !running; });
+}
+
+void BackgroundTaskRunner::work() {
+	std::unique_lock<std::mutex> lock{ mutex };
+	for (;;) {
+		changed.wait(lock, [this]() { return stopping || !tasks.empty(); });
+		if (stopping)
+			return;
+		{
+			auto task = std::move(tasks.front());
+			tasks.pop_front();
+			running = true;
+			lock.unlock();
+			try {
+				task();
+			}
+			catch (...) {
+			}
+		}
+		lock.lock();
+		running = false;
+		changed.notify_all();
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "TaskRunner.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Runs tasks on a thread of its own. A task that throws is abandoned; 
+// tasks that need to report failure catch it themselves.
+class BackgroundTaskRunner : public TaskRunner {
+	std::deque<std::function<void()>> tasks{};
+	std::mutex mutex{};
+	std::condition_variable changed{};
+	std::thread worker{};
+	bool running{};
+	bool stopping{};
+public:
+	SPATIALIZED_HA_SIMULATION_API BackgroundTaskRunner();
+	// Finishes the task in progress; those still queued are dropped.
+	SPATIALIZED_HA_SIMULATION_API ~BackgroundTaskRunner() noexcept;
+	BackgroundTaskRunner(const BackgroundTaskRunner &) = delete;
+	BackgroundTaskRunner &operator=(const BackgroundTaskRunner &) = delete;
+	BackgroundTaskRunner(BackgroundTaskRunner &&) = delete;
+	BackgroundTaskRunner &operator=(BackgroundTaskRunner &&) = delete;
+	SPATIALIZED_HA_SIMULATION_API void run(std::function<void()>) override;
+	SPATIALIZED_HA_SIMULATION_API void await() override;
+private:
+	void work();
+};
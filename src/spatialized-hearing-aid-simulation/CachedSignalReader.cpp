@@ -0,0 +1,55 @@
+#include "CachedSignalReader.h"
+#include <gsl/gsl>
+
+CachedSignalReader::CachedSignalReader(
+	std::shared_ptr<const SignalCache::channels_type> signal,
+	int sampleRate
+) noexcept :
+	signal{ std::move(signal) },
+	sampleRate_{ sampleRate } {}
+
+void CachedSignalReader::read(gsl::span<channel_type> audio) {
+	if (audio.size() != channels())
+		return;
+	SignalCache::signal_type::size_type samples{ 0 };
+	for (int i{ 0 }; i < channels(); ++i) {
+		const auto &source = signal->at(i);
+		auto channel = audio[i];
+		samples = std::min(
+			gsl::narrow<SignalCache::signal_type::size_type>(channel.size()), 
+			frames_() - head
+		);
+		std::copy_n(source.begin() + head, samples, channel.begin());
+	}
+	head += samples;
+}
+
+bool CachedSignalReader::complete() {
+	return head == frames_();
+}
+
+int CachedSignalReader::sampleRate() {
+	return sampleRate_;
+}
+
+int CachedSignalReader::channels() {
+	return gsl::narrow<int>(signal->size());
+}
+
+long long CachedSignalReader::frames() {
+	return frames_();
+}
+
+void CachedSignalReader::reset() {
+	head = 0;
+}
+
+long long CachedSignalReader::remainingFrames() {
+	return frames_() - head;
+}
+
+void CachedSignalReader::prepareForPlayback() {}
+
+auto CachedSignalReader::frames_() const -> SignalCache::signal_type::size_type {
+	return signal->empty() ? 0 : signal->front().size();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "AudioFrameReader.h"
+#include "SignalCache.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <memory>
+
+// Reads a signal held by a SignalCache without copying it first.
+class CachedSignalReader : public AudioFrameReader {
+	std::shared_ptr<const SignalCache::channels_type> signal;
+	SignalCache::signal_type::size_type head{};
+	int sampleRate_;
+public:
+	SPATIALIZED_HA_SIMULATION_API CachedSignalReader(
+		std::shared_ptr<const SignalCache::channels_type>,
+		int sampleRate
+	) noexcept;
+	SPATIALIZED_HA_SIMULATION_API void read(gsl::span<channel_type> audio) override;
+	SPATIALIZED_HA_SIMULATION_API bool complete() override;
+	SPATIALIZED_HA_SIMULATION_API int sampleRate() override;
+	SPATIALIZED_HA_SIMULATION_API int channels() override;
+	SPATIALIZED_HA_SIMULATION_API long long frames() override;
+	SPATIALIZED_HA_SIMULATION_API void reset() override;
+	SPATIALIZED_HA_SIMULATION_API long long remainingFrames() override;
+	SPATIALIZED_HA_SIMULATION_API void prepareForPlayback() override;
+private:
+	SignalCache::signal_type::size_type frames_() const;
+};
@@ -8,6 +8,7 @@ class CalibrationComputer {
 public:
     INTERFACE_OPERATIONS(CalibrationComputer)
 	virtual double signalScale(int channel, double level) = 0;
+	virtual bool channelsEqual() = 0;
 };
 
 class CalibrationComputerFactory {
@@ -1,41 +1,65 @@
 #include "CalibrationComputerImpl.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
 #include <cmath>
 
-template<typename T>
-T rms(std::vector<T> x) {
-	return std::sqrt(
-		std::accumulate(
-			x.begin(),
-			x.end(),
-			T{ 0 },
-			[](T a, T b) { return a += b * b; }
-		) / x.size()
-	);
-}
-
-CalibrationComputerImpl::CalibrationComputerImpl(AudioFrameReader & reader) :
-	audioFileContents(
-		reader.channels(),
-		channel_type(gsl::narrow<channel_type::size_type>(reader.frames()))
-	)
+CalibrationComputerImpl::CalibrationComputerImpl(
+	AudioFrameReader &reader, 
+	int framesPerBlock
+) :
+	rms(gsl::narrow<channel_type::size_type>(reader.channels()))
 {
-	read(reader);
+	read(reader, framesPerBlock);
 }
 
 double CalibrationComputerImpl::signalScale(int channel, double level) {
 	return validChannel(channel)
-		? std::pow(10.0, level / 20.0) / rms(audioFileContents.at(channel))
+		? std::pow(10.0, level / 20.0) / rms.at(channel)
 		: 0;
 }
 
+bool CalibrationComputerImpl::channelsEqual() {
+	return channelsEqual_;
+}
+
 bool CalibrationComputerImpl::validChannel(int channel) {
-	return gsl::narrow<channel_type::size_type>(channel) < audioFileContents.size();
+	return gsl::narrow<channel_type::size_type>(channel) < rms.size();
 }
 
-void CalibrationComputerImpl::read(AudioFrameReader & reader) {
-	std::vector<AudioFrameReader::channel_type> adapted;
-	for (auto &channel : audioFileContents)
-		adapted.push_back({ channel });
-	reader.read(adapted);
+void CalibrationComputerImpl::read(AudioFrameReader &reader, int framesPerBlock) {
+	std::vector<channel_type> block(
+		rms.size(), 
+		channel_type(gsl::narrow<channel_type::size_type>(framesPerBlock))
+	);
+	// Long files sum too many squares for float to keep their precision.
+	std::vector<double> sumsOfSquares(rms.size());
+	const auto frames = reader.frames();
+	for (long long offset = 0; offset < frames; offset += framesPerBlock) {
+		const auto count = std::min<long long>(framesPerBlock, frames - offset);
+		std::vector<AudioFrameReader::channel_type> adapted;
+		for (auto &channel : block)
+			adapted.push_back({ channel.data(), gsl::narrow<AudioFrameReader::channel_type::index_type>(count) });
+		reader.read(adapted);
+		for (channel_type::size_type i = 0; i < block.size(); ++i)
+			sumsOfSquares.at(i) = std::accumulate(
+				block.at(i).begin(),
+				block.at(i).begin() + count,
+				sumsOfSquares.at(i),
+				[](double a, sample_type b) { return a + double{ b } * b; }
+			);
+		if (std::adjacent_find(
+			adapted.begin(),
+			adapted.end(),
+			[](AudioFrameReader::channel_type a, AudioFrameReader::channel_type b) {
+				return !std::equal(a.begin(), a.end(), b.begin(), b.end());
+			}
+		) != adapted.end())
+			channelsEqual_ = false;
+	}
+	for (channel_type::size_type i = 0; i < rms.size(); ++i)
+		rms.at(i) = gsl::narrow_cast<sample_type>(
+			std::sqrt(sumsOfSquares.at(i) / frames)
+		);
 	reader.reset();
 }
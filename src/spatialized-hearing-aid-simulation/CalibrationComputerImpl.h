@@ -4,16 +4,22 @@
 #include "spatialized-hearing-aid-simulation-exports.h"
 #include <vector>
 
+// Takes what it needs in one pass over the reader, a block at a time, so
+// long files are never held whole.
 class CalibrationComputerImpl : public CalibrationComputer {
 	using sample_type = AudioFrameReader::channel_type::element_type;
 	using channel_type = std::vector<sample_type>;
-    std::vector<channel_type> audioFileContents;
+	std::vector<sample_type> rms;
+	bool channelsEqual_{ true };
 public:
-	SPATIALIZED_HA_SIMULATION_API explicit CalibrationComputerImpl(AudioFrameReader &reader);
+	SPATIALIZED_HA_SIMULATION_API explicit CalibrationComputerImpl(
+		AudioFrameReader &reader,
+		int framesPerBlock = 8192
+	);
 	SPATIALIZED_HA_SIMULATION_API double signalScale(int channel, double level) override;
+	SPATIALIZED_HA_SIMULATION_API bool channelsEqual() override;
 
 private:
 	bool validChannel(int channel);
-	void read(AudioFrameReader & reader);
+	void read(AudioFrameReader &reader, int framesPerBlock);
 };
-
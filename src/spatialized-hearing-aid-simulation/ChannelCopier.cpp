@@ -52,6 +52,10 @@ long long ChannelCopier::remainingFrames() {
     return reader->remainingFrames();
 }
 
+void ChannelCopier::prepareForPlayback() {
+	reader->prepareForPlayback();
+}
+
 ChannelCopierFactory::ChannelCopierFactory(
 	AudioFrameReaderFactory* factory
 ) noexcept :
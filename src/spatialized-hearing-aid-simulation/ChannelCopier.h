@@ -17,6 +17,7 @@ public:
 	SPATIALIZED_HA_SIMULATION_API long long frames() override;
 	SPATIALIZED_HA_SIMULATION_API void reset() override;
     long long remainingFrames() override;
+	SPATIALIZED_HA_SIMULATION_API void prepareForPlayback() override;
 private:
 	void readAndCopyFirstChannel(gsl::span<channel_type> audio);
 	void readAllChannels(gsl::span<channel_type> audio);
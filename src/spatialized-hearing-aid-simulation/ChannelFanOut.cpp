@@ -0,0 +1,23 @@
+#include "ChannelFanOut.h"
+#include <algorithm>
+
+ChannelFanOut::ChannelFanOut(std::shared_ptr<SignalProcessor> processor) noexcept :
+	processor{ std::move(processor) } {}
+
+void ChannelFanOut::process(gsl::span<channel_type> audio) {
+	if (audio.size() == 0)
+		return;
+
+	auto firstChannel = audio.at(0);
+	processor->process(firstChannel);
+	for (auto channel : audio.last(audio.size() - 1))
+		std::copy(firstChannel.begin(), firstChannel.end(), channel.begin());
+}
+
+auto ChannelFanOut::groupDelay() -> channel_type::index_type {
+	return processor->groupDelay();
+}
+
+void ChannelFanOut::reset() {
+	processor->reset();
+}
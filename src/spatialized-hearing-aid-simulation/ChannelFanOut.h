@@ -0,0 +1,19 @@
+#pragma once
+
+#include "AudioFrameProcessor.h"
+#include "SignalProcessor.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <memory>
+
+// Processes the first channel and copies the result to every other channel,
+// for when all channels would otherwise be processed identically.
+class ChannelFanOut : public AudioFrameProcessor {
+	std::shared_ptr<SignalProcessor> processor;
+public:
+	SPATIALIZED_HA_SIMULATION_API explicit ChannelFanOut(
+		std::shared_ptr<SignalProcessor>
+	) noexcept;
+	SPATIALIZED_HA_SIMULATION_API void process(gsl::span<channel_type> audio) override;
+	SPATIALIZED_HA_SIMULATION_API channel_type::index_type groupDelay() override;
+	SPATIALIZED_HA_SIMULATION_API void reset() override;
+};
@@ -22,9 +22,22 @@ auto ChannelProcessingGroup::groupDelay() -> channel_type::index_type {
 	auto maximumDelayedProcessor = std::max_element(
 		processors.begin(),
 		processors.end(),
-		[](channel_processing_type a, channel_processing_type b) { 
+		[](const channel_processing_type &a, const channel_processing_type &b) { 
 			return a->groupDelay() < b->groupDelay(); 
 		}
 	);
 	return (*maximumDelayedProcessor)->groupDelay();
 }
+
+void ChannelProcessingGroup::reset() {
+	for (const auto &processor : processors)
+		processor->reset();
+}
+
+// Everything runs on the calling thread, which is already set up.
+std::shared_ptr<AudioFrameProcessor> ChannelProcessingGroupFactory::make(
+	processing_group_type processors,
+	RealTimeSetup *
+) {
+	return std::make_shared<ChannelProcessingGroup>(std::move(processors));
+}
@@ -1,22 +1,29 @@
 #pragma once
 
-#include "SignalProcessor.h"
-#include "AudioFrameProcessor.h"
+#include "ProcessingGroup.h"
 #include "spatialized-hearing-aid-simulation-exports.h"
 #include <vector>
 #include <memory>
 
 class ChannelProcessingGroup : public AudioFrameProcessor {
 public:
-	using channel_processing_type = std::shared_ptr<SignalProcessor>;
-	using processing_group_type = std::vector<channel_processing_type>;
+	using channel_processing_type = ProcessingGroupFactory::channel_processing_type;
+	using processing_group_type = ProcessingGroupFactory::processing_group_type;
 
 	SPATIALIZED_HA_SIMULATION_API explicit ChannelProcessingGroup(
 		processing_group_type processors
 	) noexcept;
 	SPATIALIZED_HA_SIMULATION_API void process(gsl::span<channel_type> audio) override;
 	SPATIALIZED_HA_SIMULATION_API channel_type::index_type groupDelay() override;
+	SPATIALIZED_HA_SIMULATION_API void reset() override;
 private:
 	processing_group_type processors;
 };
 
+class ChannelProcessingGroupFactory : public ProcessingGroupFactory {
+public:
+	SPATIALIZED_HA_SIMULATION_API std::shared_ptr<AudioFrameProcessor> make(
+		processing_group_type,
+		RealTimeSetup *
+	) override;
+};
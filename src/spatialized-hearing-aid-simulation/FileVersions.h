@@ -0,0 +1,14 @@
+#pragma once
+
+#include <common-includes/Interface.h>
+#include <string>
+
+// Tells a file's contents apart from what was under the same path before,
+// so what was computed from the old contents is not reused.
+class FileVersions {
+public:
+    INTERFACE_OPERATIONS(FileVersions)
+	// Empty when the file cannot be examined. Called from background tasks
+	// as well.
+	virtual std::string version(const std::string &filePath) = 0;
+};
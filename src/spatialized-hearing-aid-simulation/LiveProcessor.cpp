@@ -0,0 +1,106 @@
+#include "LiveProcessor.h"
+
+LiveProcessor::LiveProcessor(
+	std::shared_ptr<AudioFrameProcessor> processor,
+	int rampFrames,
+	int capacity
+) :
+	commands(gsl::narrow<std::size_t>(capacity)),
+	retired(gsl::narrow<std::size_t>(capacity)),
+	processor{ std::move(processor) },
+	rampFrames{ rampFrames },
+	capacity{ capacity } {}
+
+bool LiveProcessor::setGain(float g) {
+	return commands.push({ nullptr, g });
+}
+
+// Counting replacements until they are reclaimed keeps the callback from
+// ever finding the retired queue full.
+bool LiveProcessor::replace(std::shared_ptr<AudioFrameProcessor> replacement) {
+	if (replacementsInFlight == capacity)
+		return false;
+	if (!commands.push({ std::move(replacement), 1 }))
+		return false;
+	++replacementsInFlight;
+	return true;
+}
+
+void LiveProcessor::reclaim() {
+	std::shared_ptr<AudioFrameProcessor> replaced;
+	while (retired.pop(replaced)) {
+		replaced.reset();
+		--replacementsInFlight;
+	}
+}
+
+void LiveProcessor::process(gsl::span<channel_type> audio) {
+	Command command;
+	while (commands.pop(command))
+		apply(command);
+	swapIfFadedOut();
+	processor->process(audio);
+	applyGain(audio);
+}
+
+// Swapping chains mid-signal would click, so the current one is faded out
+// first. A gain set meanwhile is the one the replacement fades in to, and a
+// second replacement retires the first before it ever plays.
+void LiveProcessor::apply(Command &command) {
+	if (command.replacement) {
+		if (pending)
+			retire(pending);
+		else
+			rampTo(0);
+		pending = std::move(command.replacement);
+		pendingGain = command.gain;
+	}
+	else if (pending)
+		pendingGain = command.gain;
+	else
+		rampTo(command.gain);
+}
+
+void LiveProcessor::retire(std::shared_ptr<AudioFrameProcessor> &p) {
+	retired.push(std::move(p));
+	p = nullptr;
+}
+
+void LiveProcessor::swapIfFadedOut() {
+	if (!pending || rampRemaining > 0)
+		return;
+	std::swap(processor, pending);
+	retire(pending);
+	rampTo(pendingGain);
+}
+
+void LiveProcessor::rampTo(float g) {
+	targetGain = g;
+	rampRemaining = rampFrames;
+	gainStep = rampFrames > 0 ? (targetGain - gain) / rampFrames : 0;
+	if (rampFrames <= 0)
+		gain = targetGain;
+}
+
+void LiveProcessor::applyGain(gsl::span<channel_type> audio) {
+	if (rampRemaining == 0 && gain == 1)
+		return;
+	const auto frames = audio.size() ? audio.begin()->size() : 0;
+	for (channel_type::index_type i{ 0 }; i < frames; ++i) {
+		if (rampRemaining > 0) {
+			--rampRemaining;
+			gain = rampRemaining == 0 ? targetGain : gain + gainStep;
+		}
+		for (auto channel : audio)
+			channel[i] *= gain;
+	}
+}
+
+LiveProcessor::channel_type::index_type LiveProcessor::groupDelay() {
+	return processor->groupDelay();
+}
+
+// Only while the callback is not running.
+void LiveProcessor::reset() {
+	processor->reset();
+}
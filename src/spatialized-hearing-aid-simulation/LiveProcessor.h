@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AudioFrameProcessor.h"
+#include "SpscQueue.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <memory>
+
+// Lets one control thread change what the audio callback plays while it
+// plays. Commands travel to the callback through a lock-free queue and take
+// effect at the start of its next block: a gain is reached gradually over
+// the ramp, and a replacement chain takes over once the current one has 
+// faded out over the ramp, then fades in.
+// Replaced chains travel back the same way, so they are destroyed by the
+// control thread when it reclaims them and never by the callback.
+class LiveProcessor : public AudioFrameProcessor {
+	struct Command {
+		std::shared_ptr<AudioFrameProcessor> replacement;
+		float gain;
+	};
+	SpscQueue<Command> commands;
+	SpscQueue<std::shared_ptr<AudioFrameProcessor>> retired;
+	std::shared_ptr<AudioFrameProcessor> processor;
+	std::shared_ptr<AudioFrameProcessor> pending{};
+	float gain{ 1 };
+	float pendingGain{ 1 };
+	float targetGain{ 1 };
+	float gainStep{};
+	int rampFrames;
+	int rampRemaining{};
+	int replacementsInFlight{};
+	int capacity;
+public:
+	SPATIALIZED_HA_SIMULATION_API explicit LiveProcessor(
+		std::shared_ptr<AudioFrameProcessor>,
+		int rampFrames = 480,
+		int capacity = 8
+	);
+
+	// The control thread's side. Each returns false, changing nothing, when
+	// the callback has fallen too far behind to take another command.
+	SPATIALIZED_HA_SIMULATION_API bool setGain(float);
+	SPATIALIZED_HA_SIMULATION_API bool replace(std::shared_ptr<AudioFrameProcessor>);
+	SPATIALIZED_HA_SIMULATION_API void reclaim();
+
+	SPATIALIZED_HA_SIMULATION_API void process(gsl::span<channel_type> audio) override;
+	SPATIALIZED_HA_SIMULATION_API channel_type::index_type groupDelay() override;
+	SPATIALIZED_HA_SIMULATION_API void reset() override;
+private:
+	void apply(Command &);
+	void retire(std::shared_ptr<AudioFrameProcessor> &);
+	void swapIfFadedOut();
+	void rampTo(float);
+	void applyGain(gsl::span<channel_type> audio);
+};
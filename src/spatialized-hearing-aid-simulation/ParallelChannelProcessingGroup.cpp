@@ -0,0 +1,56 @@
+#include "ParallelChannelProcessingGroup.h"
+#include <algorithm>
+
+ParallelChannelProcessingGroup::ParallelChannelProcessingGroup(
+	processing_group_type processors_,
+	RealTimeSetup *realTime
+) :
+	processors{ std::move(processors_) },
+	workers{
+		processors.empty() ? 0 : gsl::narrow<int>(processors.size() - 1),
+		[this](int worker) { processChannel(worker + 1); },
+		realTime
+	} {}
+
+void ParallelChannelProcessingGroup::process(gsl::span<channel_type> audio) {
+	if (processors.empty())
+		return;
+
+	audio_ = audio;
+	workers.release();
+	processChannel(0);
+	workers.await();
+}
+
+void ParallelChannelProcessingGroup::processChannel(
+	processing_group_type::size_type channel
+) {
+	if (gsl::narrow<processing_group_type::size_type>(audio_.size()) > channel)
+		processors[channel]->process(audio_[gsl::narrow<channel_type::index_type>(channel)]);
+}
+
+auto ParallelChannelProcessingGroup::groupDelay() -> channel_type::index_type {
+	if (processors.size() == 0)
+		return 0;
+
+	auto maximumDelayedProcessor = std::max_element(
+		processors.begin(),
+		processors.end(),
+		[](const channel_processing_type &a, const channel_processing_type &b) { 
+			return a->groupDelay() < b->groupDelay(); 
+		}
+	);
+	return (*maximumDelayedProcessor)->groupDelay();
+}
+
+void ParallelChannelProcessingGroup::reset() {
+	for (const auto &processor : processors)
+		processor->reset();
+}
+
+std::shared_ptr<AudioFrameProcessor> ParallelChannelProcessingGroupFactory::make(
+	processing_group_type processors,
+	RealTimeSetup *realTime
+) {
+	return std::make_shared<ParallelChannelProcessingGroup>(std::move(processors), realTime);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ProcessingGroup.h"
+#include "PersistentWorkers.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <vector>
+#include <memory>
+
+// Processes the first channel on the calling thread and every other channel
+// on its own persistent worker.
+class ParallelChannelProcessingGroup : public AudioFrameProcessor {
+public:
+	using channel_processing_type = ProcessingGroupFactory::channel_processing_type;
+	using processing_group_type = ProcessingGroupFactory::processing_group_type;
+
+	SPATIALIZED_HA_SIMULATION_API explicit ParallelChannelProcessingGroup(
+		processing_group_type processors,
+		RealTimeSetup * = nullptr
+	);
+	SPATIALIZED_HA_SIMULATION_API void process(gsl::span<channel_type> audio) override;
+	SPATIALIZED_HA_SIMULATION_API channel_type::index_type groupDelay() override;
+	SPATIALIZED_HA_SIMULATION_API void reset() override;
+private:
+	void processChannel(processing_group_type::size_type channel);
+
+	processing_group_type processors;
+	gsl::span<channel_type> audio_{};
+	PersistentWorkers workers;
+};
+
+class ParallelChannelProcessingGroupFactory : public ProcessingGroupFactory {
+public:
+	SPATIALIZED_HA_SIMULATION_API std::shared_ptr<AudioFrameProcessor> make(
+		processing_group_type,
+		RealTimeSetup *
+	) override;
+};
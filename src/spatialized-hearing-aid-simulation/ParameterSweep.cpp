@@ -0,0 +1,277 @@
+#include "ParameterSweep.h"
+#include "SpatialHearingAidModel.h"
+#include <gsl/gsl>
+
+ParameterSweep::ParameterSweep(
+	AudioFrameReaderFactory *readerFactory,
+	AudioFrameWriterFactory *writerFactory,
+	BrirReader *brirReader,
+	PrescriptionReader *prescriptionReader,
+	SimulationChannelFactory *channelFactory,
+	CalibrationComputerFactory *calibrationFactory,
+	SignalCache *cache
+) :
+	readerFactory{ readerFactory },
+	writerFactory{ writerFactory },
+	brirReader{ brirReader },
+	prescriptionReader{ prescriptionReader },
+	channelFactory{ channelFactory },
+	calibrationFactory{ calibrationFactory },
+	cache{ cache } {}
+
+void ParameterSweep::run(const Sweep &sweep) {
+	try {
+		run_(sweep);
+	}
+	catch (const SignalStore::StoreFailure &e) {
+		throw SweepFailure{ e.what() };
+	}
+}
+
+static constexpr bool powerOfTwo(int n) noexcept {
+	return n > 0 && (n & (n - 1)) == 0;
+}
+
+static void assertSizeIsPowerOfTwo(int size) {
+	if (!powerOfTwo(size))
+		throw ParameterSweep::SweepFailure{
+			"Both the chunk size and window size must be powers of two; " +
+			std::to_string(size) + " is not a power of two."
+		};
+}
+
+// Each point's hearing aid stage is built only when it is rendered, so 
+// one point's stage at most is alive at a time.
+void ParameterSweep::run_(const Sweep &sweep) {
+	if (sweep.points.empty())
+		return;
+	for (const auto &point : sweep.points) {
+		assertSizeIsPowerOfTwo(point.windowSize);
+		assertSizeIsPowerOfTwo(point.chunkSize);
+	}
+	const auto &stimulus_ = stimulus(sweep.audioFilePath);
+	const auto left = readPrescription(sweep.leftDslPrescriptionFilePath);
+	const auto right = readPrescription(sweep.rightDslPrescriptionFilePath);
+	channelFactory->beginArena();
+	const auto prefix_ = prefix(sweep, stimulus_);
+	for (const auto &point : sweep.points)
+		render(point, stimulus_, prefix_, hearingAid(point, stimulus_, left, right));
+}
+
+auto ParameterSweep::stimulus(const std::string &filePath) -> const Stimulus & {
+	const auto found = stimuli.find(filePath);
+	if (found != stimuli.end())
+		return found->second;
+
+	auto reader = makeReader(filePath);
+	Stimulus stimulus_{};
+	stimulus_.calibration = calibrationFactory->make(reader.get());
+	stimulus_.frames = reader->frames();
+	stimulus_.channels = reader->channels();
+	stimulus_.sampleRate = reader->sampleRate();
+	SignalCache::channels_type decoded(
+		stimulus_.channels, 
+		SignalCache::signal_type(gsl::narrow<std::size_t>(stimulus_.frames))
+	);
+	std::vector<AudioFrameReader::channel_type> adapted;
+	for (auto &channel : decoded)
+		adapted.push_back({ channel });
+	reader->read(adapted);
+	cache->insert(decodedKey(filePath), std::move(decoded));
+	return stimuli[filePath] = std::move(stimulus_);
+}
+
+static std::size_t length(const SignalCache::channels_type &channels) {
+	return channels.empty() ? 0 : channels.front().size();
+}
+
+auto ParameterSweep::prefix(
+	const Sweep &sweep, 
+	const Stimulus &stimulus_
+) -> Prefix {
+	const auto key = prefixKey(sweep);
+	auto signal = cache->find(key);
+	const auto delay = prefixDelays.find(key);
+	if (signal && 
+		delay != prefixDelays.end() && 
+		length(*signal) >= gsl::narrow<std::size_t>(stimulus_.frames + delay->second)
+	)
+		return { std::move(signal), delay->second };
+
+	index_type groupDelay_{};
+	auto rendered = renderPrefix(sweep, stimulus_, groupDelay_);
+	prefixDelays[key] = groupDelay_;
+	return { cache->insert(key, std::move(rendered)), groupDelay_ };
+}
+
+// The prefix runs only as long as the stimulus and its own delay; each 
+// point's hearing aid is fed silence past its end.
+auto ParameterSweep::renderPrefix(
+	const Sweep &sweep, 
+	const Stimulus &stimulus_, 
+	index_type &delay
+) -> SignalCache::channels_type {
+	BrirReader::BinauralRoomImpulseResponse brir{};
+	if (sweep.usingSpatialization)
+		brir = readBrir(sweep.brirFilePath);
+	const auto digitalLevel = 
+		sweep.level_dB_Spl - SpatialHearingAidModel::fullScaleLevel_dB_Spl;
+	channel_processing_type processors;
+	for (int i = 0; i < stimulus_.channels; ++i) {
+		const auto scale = gsl::narrow_cast<float>(
+			stimulus_.calibration->signalScale(i, digitalLevel)
+		);
+		if (sweep.usingSpatialization) {
+			SimulationChannelFactory::Spatialization spatialization;
+			spatialization.filterCoefficients = i == 0 ? brir.left : brir.right;
+			processors.push_back(channelFactory->makeSpatialization(spatialization, scale));
+		}
+		else
+			processors.push_back(channelFactory->makeWithoutSimulation(scale));
+	}
+	delay = groupDelay(processors);
+
+	const auto decoded = cache->find(decodedKey(sweep.audioFilePath));
+	const auto frames = gsl::narrow<std::size_t>(stimulus_.frames + delay);
+	const auto framesPerBuffer = gsl::narrow<std::size_t>(std::max(1, sweep.framesPerBuffer));
+	SignalCache::channels_type rendered;
+	for (int i = 0; i < stimulus_.channels; ++i) {
+		SignalCache::signal_type channel(frames);
+		const auto &source = decoded->at(i);
+		std::copy(source.begin(), source.end(), channel.begin());
+		for (std::size_t head = 0; head < frames; head += framesPerBuffer)
+			processors.at(i)->process({ 
+				channel.data() + head, 
+				gsl::narrow<index_type>(std::min(framesPerBuffer, frames - head)) 
+			});
+		rendered.push_back(std::move(channel));
+	}
+	return rendered;
+}
+
+auto ParameterSweep::hearingAid(
+	const Point &point, 
+	const Stimulus &stimulus_,
+	const PrescriptionReader::Dsl &left,
+	const PrescriptionReader::Dsl &right
+) -> channel_processing_type {
+	SimulationChannelFactory::HearingAidSimulation simulation;
+	simulation.attack_ms = point.attack_ms;
+	simulation.release_ms = point.release_ms;
+	simulation.windowSize = point.windowSize;
+	simulation.chunkSize = point.chunkSize;
+	simulation.sampleRate = stimulus_.sampleRate;
+	simulation.fullScaleLevel_dB_Spl = SpatialHearingAidModel::fullScaleLevel_dB_Spl;
+	channel_processing_type processors;
+	for (int i = 0; i < stimulus_.channels; ++i) {
+		simulation.prescription = i == 0 ? left : right;
+		processors.push_back(channelFactory->makeHearingAidSimulation(simulation, 1));
+	}
+	return processors;
+}
+
+// The hearing aid only accepts whole chunks; past the end of the prefix it
+// is given silence.
+void ParameterSweep::render(
+	const Point &point, 
+	const Stimulus &stimulus_, 
+	const Prefix &prefix_, 
+	channel_processing_type processors
+) {
+	const auto frames = gsl::narrow<std::size_t>(
+		stimulus_.frames + prefix_.groupDelay + groupDelay(processors)
+	);
+	const auto chunkSize = gsl::narrow<std::size_t>(point.chunkSize);
+	SignalCache::signal_type chunk(chunkSize);
+	SignalCache::channels_type rendered;
+	for (int i = 0; i < stimulus_.channels; ++i) {
+		const auto &source = prefix_.signal->at(i);
+		SignalCache::signal_type channel(frames);
+		for (std::size_t head = 0; head < frames; head += chunkSize) {
+			const auto available = head < source.size() 
+				? std::min(chunkSize, source.size() - head) 
+				: 0;
+			std::fill(
+				std::copy_n(source.begin() + head, available, chunk.begin()),
+				chunk.end(),
+				0.0f
+			);
+			processors.at(i)->process(chunk);
+			std::copy_n(
+				chunk.begin(), 
+				std::min(chunkSize, frames - head), 
+				channel.begin() + head
+			);
+		}
+		rendered.push_back(std::move(channel));
+	}
+
+	AudioFrameWriter::AudioFormat format;
+	format.channels = stimulus_.channels;
+	format.sampleRate = stimulus_.sampleRate;
+	auto writer = makeWriter(point.outputFilePath, format);
+	std::vector<AudioFrameWriter::channel_type> adapted;
+	for (auto &channel : rendered)
+		adapted.push_back({ channel });
+	writer->write(adapted);
+}
+
+std::shared_ptr<AudioFrameReader> ParameterSweep::makeReader(std::string filePath) {
+	try {
+		return readerFactory->make(filePath);
+	}
+	catch (const AudioFrameReaderFactory::CreateError &) {
+		throw SweepFailure{ "Audio file '" + filePath + "' cannot be read." };
+	}
+}
+
+std::shared_ptr<AudioFrameWriter> ParameterSweep::makeWriter(
+	std::string filePath,
+	const AudioFrameWriter::AudioFormat &format
+) {
+	try {
+		return writerFactory->make(filePath, format);
+	}
+	catch (const AudioFrameWriterFactory::CreateError &) {
+		throw SweepFailure{ "Audio file '" + filePath + "' cannot be written." };
+	}
+}
+
+BrirReader::BinauralRoomImpulseResponse ParameterSweep::readBrir(std::string filePath) {
+	try {
+		auto brir = brirReader->read(filePath);
+		if (brir.left.empty() || brir.right.empty())
+			throw SweepFailure{ "BRIR '" + filePath + "' has empty coefficients." };
+		return brir;
+	}
+	catch (const BrirReader::ReadFailure &) {
+		throw SweepFailure{ "BRIR '" + filePath + "' cannot be read." };
+	}
+}
+
+PrescriptionReader::Dsl ParameterSweep::readPrescription(std::string filePath) {
+	try {
+		return prescriptionReader->read(filePath);
+	}
+	catch (const PrescriptionReader::ReadFailure &) {
+		throw SweepFailure{ "Prescription '" + filePath + "' cannot be read." };
+	}
+}
+
+std::string ParameterSweep::decodedKey(const std::string &audioFilePath) {
+	return "decoded\n" + audioFilePath;
+}
+
+std::string ParameterSweep::prefixKey(const Sweep &sweep) {
+	return 
+		"prefix\n" + sweep.audioFilePath + 
+		"\n" + std::to_string(sweep.level_dB_Spl) + 
+		"\n" + (sweep.usingSpatialization ? sweep.brirFilePath : std::string{});
+}
+
+auto ParameterSweep::groupDelay(const channel_processing_type &processors) -> index_type {
+	index_type delay{ 0 };
+	for (const auto &processor : processors)
+		delay = std::max(delay, processor->groupDelay());
+	return delay;
+}
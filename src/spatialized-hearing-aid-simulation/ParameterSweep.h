@@ -0,0 +1,106 @@
+#pragma once
+
+#include "SimulationChannelFactory.h"
+#include "CalibrationComputer.h"
+#include "AudioFrameReader.h"
+#include "AudioFrameWriter.h"
+#include "PrescriptionReader.h"
+#include "BrirReader.h"
+#include "SignalCache.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <common-includes/RuntimeError.h>
+#include <vector>
+#include <string>
+#include <map>
+
+// Renders one stimulus through the hearing aid simulation once per sweep
+// point. Everything ahead of the hearing aid (decoding, scaling and the BRIR
+// convolution) depends only on the stimulus, level and BRIR, so each of 
+// those prefixes is memoized in the cache and every point replays it into 
+// a hearing aid stage built just for it.
+class ParameterSweep {
+public:
+	struct Point {
+		std::string outputFilePath;
+		double attack_ms;
+		double release_ms;
+		int windowSize;
+		int chunkSize;
+	};
+
+	struct Sweep {
+		std::vector<Point> points;
+		std::string audioFilePath;
+		std::string brirFilePath;
+		std::string leftDslPrescriptionFilePath;
+		std::string rightDslPrescriptionFilePath;
+		double level_dB_Spl;
+		// The stages ahead of the hearing aid process this many frames at a
+		// time, as they would when playing.
+		int framesPerBuffer{ 1024 };
+		bool usingSpatialization;
+	};
+
+	SPATIALIZED_HA_SIMULATION_API ParameterSweep(
+		AudioFrameReaderFactory *,
+		AudioFrameWriterFactory *,
+		BrirReader *,
+		PrescriptionReader *,
+		SimulationChannelFactory *,
+		CalibrationComputerFactory *,
+		SignalCache *
+	);
+	SPATIALIZED_HA_SIMULATION_API void run(const Sweep &);
+	RUNTIME_ERROR(SweepFailure)
+private:
+	using channel_processing_type = std::vector<std::shared_ptr<SignalProcessor>>;
+	using index_type = SignalProcessor::index_type;
+
+	struct Stimulus {
+		std::shared_ptr<CalibrationComputer> calibration;
+		long long frames;
+		int channels;
+		int sampleRate;
+	};
+
+	struct Prefix {
+		std::shared_ptr<const SignalCache::channels_type> signal;
+		index_type groupDelay;
+	};
+
+	void run_(const Sweep &);
+	const Stimulus &stimulus(const std::string &filePath);
+	Prefix prefix(const Sweep &, const Stimulus &);
+	SignalCache::channels_type renderPrefix(
+		const Sweep &, 
+		const Stimulus &, 
+		index_type &groupDelay
+	);
+	channel_processing_type hearingAid(
+		const Point &, 
+		const Stimulus &,
+		const PrescriptionReader::Dsl &left,
+		const PrescriptionReader::Dsl &right
+	);
+	void render(const Point &, const Stimulus &, const Prefix &, channel_processing_type);
+	std::shared_ptr<AudioFrameReader> makeReader(std::string filePath);
+	std::shared_ptr<AudioFrameWriter> makeWriter(
+		std::string filePath, 
+		const AudioFrameWriter::AudioFormat &
+	);
+	BrirReader::BinauralRoomImpulseResponse readBrir(std::string filePath);
+	PrescriptionReader::Dsl readPrescription(std::string filePath);
+	static std::string decodedKey(const std::string &audioFilePath);
+	static std::string prefixKey(const Sweep &);
+	static index_type groupDelay(const channel_processing_type &);
+
+	std::map<std::string, Stimulus> stimuli{};
+	std::map<std::string, index_type> prefixDelays{};
+	AudioFrameReaderFactory *readerFactory;
+	AudioFrameWriterFactory *writerFactory;
+	BrirReader *brirReader;
+	PrescriptionReader *prescriptionReader;
+	SimulationChannelFactory *channelFactory;
+	CalibrationComputerFactory *calibrationFactory;
+	SignalCache *cache;
+};
@@ -0,0 +1,89 @@
+#include "PersistentWorkers.h"
+#include <system_error>
+
+// A release that follows closely on the last round is caught while 
+// spinning; anything later finds the worker parked, so an idle worker
+// costs nothing between blocks.
+static constexpr int workerSpins = 1 << 12;
+static constexpr int callerSpins = 1 << 10;
+
+PersistentWorkers::PersistentWorkers(
+	int count, 
+	task_type task, 
+	RealTimeSetup *realTime
+) :
+	task{ std::move(task) },
+	realTime{ realTime }
+{
+	try {
+		for (int i = 0; i < count; ++i)
+			workers.emplace_back([=]() { work(i); });
+	}
+	catch (const std::system_error &) {
+		stop();
+		throw;
+	}
+}
+
+PersistentWorkers::~PersistentWorkers() noexcept {
+	stop();
+}
+
+void PersistentWorkers::stop() {
+	stopping = true;
+	releaseGeneration();
+	for (auto &worker : workers)
+		worker.join();
+}
+
+int PersistentWorkers::count() const noexcept {
+	return static_cast<int>(workers.size());
+}
+
+void PersistentWorkers::release() {
+	pendingWorkers = count();
+	releaseGeneration();
+}
+
+// A worker counts itself parked before checking the generation under the
+// lock, so either it sees this release or this release sees it parked.
+void PersistentWorkers::releaseGeneration() {
+	++generation;
+	if (parkedWorkers > 0) {
+		{ std::lock_guard<std::mutex> lock{ parking }; }
+		parked.notify_all();
+	}
+}
+
+void PersistentWorkers::await() {
+	for (int i = 0; pendingWorkers > 0; ++i)
+		if (i >= callerSpins)
+			std::this_thread::yield();
+}
+
+void PersistentWorkers::work(int worker) {
+	if (realTime)
+		realTime->configureCurrentThread();
+	generation_type seen{ 0 };
+	for (;;) {
+		seen = awaitNextGeneration(seen);
+		if (stopping)
+			return;
+		task(worker);
+		--pendingWorkers;
+	}
+}
+
+auto PersistentWorkers::awaitNextGeneration(generation_type seen) -> generation_type {
+	for (int i = 0; i < workerSpins; ++i) {
+		const generation_type current = generation;
+		if (current != seen)
+			return current;
+	}
+	std::unique_lock<std::mutex> lock{ parking };
+	++parkedWorkers;
+	generation_type current{};
+	parked.wait(lock, [&]() { return (current = generation) != seen; });
+	--parkedWorkers;
+	return current;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "RealTimeSetup.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <functional>
+#include <condition_variable>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// A fixed set of threads that each run the same task once per release.
+// Workers are released by bumping a generation counter and report back 
+// through a pending count. A waiting worker spins briefly and then parks 
+// on a condition variable, so the releasing thread takes a lock only when
+// some worker has parked.
+class PersistentWorkers {
+public:
+	using task_type = std::function<void(int worker)>;
+
+	// Each worker configures itself with the real-time setup, when given,
+	// before its first task.
+	SPATIALIZED_HA_SIMULATION_API PersistentWorkers(
+		int count, 
+		task_type task, 
+		RealTimeSetup * = nullptr
+	);
+	SPATIALIZED_HA_SIMULATION_API ~PersistentWorkers() noexcept;
+	PersistentWorkers(const PersistentWorkers &) = delete;
+	PersistentWorkers &operator=(const PersistentWorkers &) = delete;
+	PersistentWorkers(PersistentWorkers &&) = delete;
+	PersistentWorkers &operator=(PersistentWorkers &&) = delete;
+	SPATIALIZED_HA_SIMULATION_API void release();
+	SPATIALIZED_HA_SIMULATION_API void await();
+	SPATIALIZED_HA_SIMULATION_API int count() const noexcept;
+private:
+	using generation_type = unsigned long long;
+	void work(int worker);
+	generation_type awaitNextGeneration(generation_type seen);
+	void releaseGeneration();
+	void stop();
+
+	task_type task;
+	RealTimeSetup *realTime;
+	std::vector<std::thread> workers{};
+	std::mutex parking{};
+	std::condition_variable parked{};
+	std::atomic<generation_type> generation{ 0 };
+	std::atomic<int> pendingWorkers{ 0 };
+	std::atomic<int> parkedWorkers{ 0 };
+	std::atomic<bool> stopping{ false };
+};
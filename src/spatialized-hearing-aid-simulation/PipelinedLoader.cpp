@@ -0,0 +1,173 @@
+#include "PipelinedLoader.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	// Lets the reading stage pad exactly as many zeros as the real processor
+	// needs without running it.
+	class GroupDelayOnly : public AudioFrameProcessor {
+		channel_type::index_type groupDelay_;
+	public:
+		explicit GroupDelayOnly(channel_type::index_type groupDelay_) noexcept :
+			groupDelay_{ groupDelay_ } {}
+
+		void process(gsl::span<channel_type>) override {}
+
+		channel_type::index_type groupDelay() override {
+			return groupDelay_;
+		}
+
+		void reset() override {}
+	};
+
+	void backOff(int &attempts) {
+		constexpr int spins = 1 << 10;
+		constexpr int yields = 1 << 10;
+		if (attempts >= spins + yields)
+			std::this_thread::sleep_for(std::chrono::microseconds{ 100 });
+		else if (attempts >= spins)
+			std::this_thread::yield();
+		++attempts;
+	}
+}
+
+PipelinedLoader::PipelinedLoader(
+	std::shared_ptr<AudioFrameReader> reader,
+	std::shared_ptr<AudioFrameProcessor> processor_,
+	int depth
+) :
+	emptyBlocks{ gsl::narrow<std::size_t>(depth) },
+	readBlocks{ gsl::narrow<std::size_t>(depth + 1) },
+	processedBlocks{ gsl::narrow<std::size_t>(depth + 1) },
+	processor{ std::move(processor_) },
+	padding{ 
+		std::move(reader), 
+		std::make_shared<GroupDelayOnly>(processor->groupDelay()) 
+	},
+	depth{ depth } {}
+
+PipelinedLoader::~PipelinedLoader() noexcept {
+	stop();
+}
+
+void PipelinedLoader::stop() {
+	stopping = true;
+	if (reading.joinable())
+		reading.join();
+	if (processing.joinable())
+		processing.join();
+}
+
+bool PipelinedLoader::complete() {
+	if (!started)
+		return padding.complete();
+
+	if (next == nullptr && !finished) {
+		next = await(processedBlocks);
+		finished = next == nullptr;
+	}
+	if (finished) {
+		if (readFailure)
+			std::rethrow_exception(readFailure);
+		if (processFailure)
+			std::rethrow_exception(processFailure);
+	}
+	return finished;
+}
+
+void PipelinedLoader::load(gsl::span<channel_type> audio) {
+	if (!started)
+		start(audio);
+	if (complete())
+		return;
+
+	using size_type = std::vector<channel_type>::size_type;
+	const auto channels = std::min(
+		gsl::narrow<size_type>(audio.size()), 
+		next->adapted.size()
+	);
+	for (size_type i{ 0 }; i < channels; ++i) {
+		const auto source = next->adapted.at(i);
+		std::copy(
+			source.begin(), 
+			source.end(), 
+			audio.at(gsl::narrow<gsl::span<channel_type>::index_type>(i)).begin()
+		);
+	}
+	enqueue(emptyBlocks, next);
+	next = nullptr;
+}
+
+// Once started the processor belongs to the processing thread.
+void PipelinedLoader::prime(gsl::span<channel_type> silence) {
+	if (started)
+		return;
+	processor->process(silence);
+	processor->reset();
+}
+
+void PipelinedLoader::start(gsl::span<channel_type> audio) {
+	const auto frames = audio.size() ? audio.begin()->size() : 0;
+	blocks.resize(gsl::narrow<std::size_t>(depth));
+	for (auto &block : blocks) {
+		block.channels.resize(gsl::narrow<std::size_t>(audio.size()));
+		for (auto &channel : block.channels) {
+			channel.resize(gsl::narrow<std::size_t>(frames));
+			block.adapted.push_back({ channel });
+		}
+		emptyBlocks.push(&block);
+	}
+	started = true;
+	reading = std::thread{ [this]() { read(); } };
+	processing = std::thread{ [this]() { process(); } };
+}
+
+void PipelinedLoader::read() {
+	try {
+		while (!padding.complete()) {
+			auto block = await(emptyBlocks);
+			if (block == nullptr)
+				return;
+			padding.load(block->adapted);
+			enqueue(readBlocks, block);
+		}
+	}
+	catch (...) {
+		readFailure = std::current_exception();
+	}
+	enqueue(readBlocks, nullptr);
+}
+
+void PipelinedLoader::process() {
+	try {
+		for (auto block = await(readBlocks); block != nullptr; block = await(readBlocks)) {
+			processor->process(block->adapted);
+			enqueue(processedBlocks, block);
+		}
+	}
+	catch (...) {
+		processFailure = std::current_exception();
+	}
+	enqueue(processedBlocks, nullptr);
+}
+
+auto PipelinedLoader::await(SpscQueue<Block *> &queue) -> Block * {
+	Block *block{};
+	for (int attempts = 0; !queue.pop(block); backOff(attempts))
+		if (stopping)
+			return nullptr;
+	return block;
+}
+
+void PipelinedLoader::enqueue(SpscQueue<Block *> &queue, Block *block) {
+	for (int attempts = 0; !queue.push(block); backOff(attempts))
+		if (stopping)
+			return;
+}
+
+std::shared_ptr<AudioLoader> PipelinedLoaderFactory::make(
+	std::shared_ptr<AudioFrameReader> r, 
+	std::shared_ptr<AudioFrameProcessor> p
+) {
+	return std::make_shared<PipelinedLoader>(std::move(r), std::move(p));
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "AudioProcessingLoader.h"
+#include "ZeroPaddedLoader.h"
+#include "SpscQueue.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <exception>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Produces the same blocks as ZeroPaddedLoader, but reads and processes them 
+// on separate threads ahead of the caller. Blocks are allocated once, on the 
+// first load, and cycle between the stages through bounded queues.
+class PipelinedLoader : public AudioLoader {
+	struct Block {
+		std::vector<std::vector<channel_type::element_type>> channels;
+		std::vector<channel_type> adapted;
+	};
+	std::vector<Block> blocks{};
+	SpscQueue<Block *> emptyBlocks;
+	SpscQueue<Block *> readBlocks;
+	SpscQueue<Block *> processedBlocks;
+	std::shared_ptr<AudioFrameProcessor> processor;
+	ZeroPaddedLoader padding;
+	std::thread reading{};
+	std::thread processing{};
+	std::exception_ptr readFailure{};
+	std::exception_ptr processFailure{};
+	Block *next{};
+	std::atomic<bool> stopping{ false };
+	int depth;
+	bool started{};
+	bool finished{};
+public:
+	SPATIALIZED_HA_SIMULATION_API PipelinedLoader(
+		std::shared_ptr<AudioFrameReader> reader,
+		std::shared_ptr<AudioFrameProcessor> processor,
+		int depth = 4
+	);
+	SPATIALIZED_HA_SIMULATION_API ~PipelinedLoader() noexcept;
+	PipelinedLoader(const PipelinedLoader &) = delete;
+	PipelinedLoader &operator=(const PipelinedLoader &) = delete;
+	PipelinedLoader(PipelinedLoader &&) = delete;
+	PipelinedLoader &operator=(PipelinedLoader &&) = delete;
+	SPATIALIZED_HA_SIMULATION_API void load(gsl::span<channel_type> audio) override;
+	SPATIALIZED_HA_SIMULATION_API void prime(gsl::span<channel_type> silence) override;
+	SPATIALIZED_HA_SIMULATION_API bool complete() override;
+private:
+	void start(gsl::span<channel_type> audio);
+	void read();
+	void process();
+	Block *await(SpscQueue<Block *> &);
+	void enqueue(SpscQueue<Block *> &, Block *);
+	void stop();
+};
+
+class PipelinedLoaderFactory : public AudioProcessingLoaderFactory {
+public:
+	SPATIALIZED_HA_SIMULATION_API std::shared_ptr<AudioLoader> make(
+		std::shared_ptr<AudioFrameReader>, 
+		std::shared_ptr<AudioFrameProcessor>
+	) override;
+};
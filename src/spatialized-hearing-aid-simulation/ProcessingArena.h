@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+// A monotonic arena for processing that lives and dies together, such as the
+// channels built for one test. Allocating is a pointer bump and freeing does
+// nothing; everything made here shares ownership of the arena, so its memory
+// is released in one step once the last such object is gone.
+// Objects made by different threads, and containers they keep, draw on the 
+// arena at once, so each bump is taken under the arena's own lock.
+class ProcessingArena {
+	class SynchronizedMonotonicResource : public std::pmr::memory_resource {
+		std::pmr::monotonic_buffer_resource upstream;
+		std::mutex mutex{};
+	public:
+		explicit SynchronizedMonotonicResource(std::size_t initialBytes) :
+			upstream{ initialBytes } {}
+
+	private:
+		void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+			std::lock_guard<std::mutex> lock{ mutex };
+			return upstream.allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+		bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	std::shared_ptr<std::pmr::memory_resource> resource;
+public:
+	template<typename T>
+	class Allocator {
+		template<typename> friend class Allocator;
+		std::shared_ptr<std::pmr::memory_resource> resource;
+	public:
+		using value_type = T;
+
+		explicit Allocator(std::shared_ptr<std::pmr::memory_resource> resource) noexcept :
+			resource{ std::move(resource) } {}
+
+		template<typename U>
+		Allocator(const Allocator<U> &other) noexcept :
+			resource{ other.resource } {}
+
+		T *allocate(std::size_t n) {
+			return static_cast<T *>(resource->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T *p, std::size_t n) noexcept {
+			resource->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		template<typename U>
+		bool operator==(const Allocator<U> &other) const noexcept {
+			return resource == other.resource;
+		}
+
+		template<typename U>
+		bool operator!=(const Allocator<U> &other) const noexcept {
+			return !(*this == other);
+		}
+	};
+
+	using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+	explicit ProcessingArena(std::size_t initialBytes = 1 << 16) :
+		resource{ std::make_shared<SynchronizedMonotonicResource>(initialBytes) } {}
+
+	template<typename T, typename... Arguments>
+	std::shared_ptr<T> make(Arguments &&... arguments) {
+		return std::allocate_shared<T>(
+			Allocator<T>{ resource },
+			std::forward<Arguments>(arguments)...
+		);
+	}
+
+	// Also hands the object the arena's allocator for its containers, taking
+	// it first after std::allocator_arg when it can and last otherwise. The
+	// allocator is reachable only through objects made this way, which 
+	// share ownership of the arena it refers to.
+	template<typename T, typename... Arguments>
+	std::shared_ptr<T> makeUsingAllocator(Arguments &&... arguments) {
+		const allocator_type allocator{ resource.get() };
+		if constexpr (std::is_constructible_v<
+			T, 
+			std::allocator_arg_t, 
+			const allocator_type &, 
+			Arguments...
+		>)
+			return make<T>(std::allocator_arg, allocator, std::forward<Arguments>(arguments)...);
+		else
+			return make<T>(std::forward<Arguments>(arguments)..., allocator);
+	}
+};
@@ -0,0 +1,277 @@
+#include "ProcessingGraph.h"
+#include <algorithm>
+#include <thread>
+
+ProcessingGraph::ProcessingGraph(
+	std::vector<Node> nodes_,
+	channel_type::index_type framesPerBuffer,
+	int maximumWorkers,
+	RealTimeSetup *realTime
+) :
+	nodes{ std::move(nodes_) },
+	order{ topologicalOrder(nodes) },
+	pending{ new std::atomic<int>[nodes.size()] },
+	readyNodes{ new int[nodes.size()] },
+	readyPublished{ new std::atomic<block_type>[nodes.size()] },
+	workers_{ 
+		std::max(0, std::min(parallelWidth() - 1, maximumWorkers)), 
+		[this](int) { runReadyNodes(); },
+		realTime
+	}
+{
+	const auto size = nodes.size();
+	consumers.resize(size);
+	dependencies.resize(size);
+	for (int node : order) {
+		if (!runsOnWorkers(node))
+			continue;
+		++scheduledNodes;
+		for (int input : nodes.at(node).inputs)
+			if (runsOnWorkers(input)) {
+				consumers.at(input).push_back(node);
+				++dependencies.at(node);
+			}
+		if (dependencies.at(node) == 0)
+			roots.push_back(node);
+	}
+	for (std::size_t i = 0; i < size; ++i)
+		readyPublished[i] = 0;
+	sizeBuffers(std::max(framesPerBuffer, channel_type::index_type{ 1 }));
+	groupDelay_ = longestPathDelay();
+}
+
+auto ProcessingGraph::inputsOf(const std::vector<Node> &nodes) 
+	-> std::vector<std::vector<int>>
+{
+	std::vector<std::vector<int>> inputs;
+	for (const auto &node : nodes) {
+		const auto count = node.inputs.size();
+		switch (node.operation) {
+		case Operation::input:
+			if (count != 0)
+				throw InvalidTopology{ "An input node cannot have inputs." };
+			break;
+		case Operation::output:
+		case Operation::process:
+			if (count != 1)
+				throw InvalidTopology{ "Output and processing nodes take exactly one input." };
+			break;
+		case Operation::mix:
+			if (count == 0)
+				throw InvalidTopology{ "A mix node needs at least one input." };
+			break;
+		}
+		if (node.channel < 0)
+			throw InvalidTopology{ "Channels cannot be negative." };
+		inputs.push_back(node.inputs);
+	}
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+		for (int input : nodes.at(i).inputs)
+			if (input >= 0 && 
+				input < gsl::narrow<int>(nodes.size()) && 
+				nodes.at(input).operation == Operation::output
+			)
+				throw InvalidTopology{ "An output node cannot feed another node." };
+	return inputs;
+}
+
+std::vector<int> ProcessingGraph::topologicalOrder(const std::vector<Node> &nodes) {
+	return topologicalOrder(inputsOf(nodes));
+}
+
+std::vector<int> ProcessingGraph::topologicalOrder(
+	const std::vector<std::vector<int>> &inputs
+) {
+	const auto size = gsl::narrow<int>(inputs.size());
+	std::vector<int> unresolved(inputs.size());
+	std::vector<std::vector<int>> consumers(inputs.size());
+	for (int node = 0; node < size; ++node)
+		for (int input : inputs.at(node)) {
+			if (input < 0 || input >= size)
+				throw InvalidTopology{ "A node refers to a node that does not exist." };
+			consumers.at(input).push_back(node);
+			++unresolved.at(node);
+		}
+	std::vector<int> order;
+	for (int node = 0; node < size; ++node)
+		if (unresolved.at(node) == 0)
+			order.push_back(node);
+	for (std::size_t next = 0; next < order.size(); ++next)
+		for (int consumer : consumers.at(order.at(next)))
+			if (--unresolved.at(consumer) == 0)
+				order.push_back(consumer);
+	if (order.size() != inputs.size())
+		throw InvalidTopology{ "The graph contains a cycle." };
+	return order;
+}
+
+bool ProcessingGraph::runsOnWorkers(int node) const {
+	const auto operation = nodes.at(node).operation;
+	return operation == Operation::process || operation == Operation::mix;
+}
+
+int ProcessingGraph::parallelWidth() const {
+	std::vector<int> level(nodes.size());
+	std::vector<int> nodesAtLevel(nodes.size() + 1);
+	for (int node : order) {
+		if (!runsOnWorkers(node))
+			continue;
+		for (int input : nodes.at(node).inputs)
+			if (runsOnWorkers(input))
+				level.at(node) = std::max(level.at(node), level.at(input) + 1);
+		++nodesAtLevel.at(level.at(node));
+	}
+	return *std::max_element(nodesAtLevel.begin(), nodesAtLevel.end());
+}
+
+int ProcessingGraph::workers() const noexcept {
+	return workers_.count();
+}
+
+void ProcessingGraph::sizeBuffers(channel_type::index_type n) {
+	buffers.resize(nodes.size());
+	for (auto &buffer_ : buffers)
+		buffer_.resize(gsl::narrow<std::size_t>(n));
+	capacity = n;
+	frames = n;
+}
+
+auto ProcessingGraph::buffer(int node) -> channel_type {
+	return { buffers[node].data(), frames };
+}
+
+// Buffers are sized once for the announced block size, so a longer call is
+// run a block at a time rather than reallocating on the audio thread.
+void ProcessingGraph::process(gsl::span<channel_type> audio) {
+	const auto framesToProcess = audio.size() ? audio.begin()->size() : 0;
+	for (channel_type::index_type offset = 0; offset < framesToProcess; offset += capacity)
+		processBlock(audio, offset, std::min(capacity, framesToProcess - offset));
+}
+
+void ProcessingGraph::processBlock(
+	gsl::span<channel_type> audio, 
+	channel_type::index_type offset, 
+	channel_type::index_type count
+) {
+	frames = count;
+	for (int node : order)
+		if (nodes.at(node).operation == Operation::input) {
+			auto destination = buffer(node);
+			if (nodes.at(node).channel < audio.size()) {
+				auto source = audio.at(nodes.at(node).channel).subspan(offset, count);
+				std::copy(source.begin(), source.end(), destination.begin());
+			}
+			else
+				std::fill(destination.begin(), destination.end(), 0.0f);
+		}
+
+	++block;
+	readyHead = 0;
+	readyTail = 0;
+	completed = 0;
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+		pending[i] = dependencies[i];
+	for (int root : roots)
+		pushReady(root);
+	workers_.release();
+	runReadyNodes();
+	workers_.await();
+
+	for (int node : order)
+		if (nodes.at(node).operation == Operation::output &&
+			nodes.at(node).channel < audio.size()
+		) {
+			auto source = buffer(nodes.at(node).inputs.front());
+			std::copy(
+				source.begin(), 
+				source.end(), 
+				audio.at(nodes.at(node).channel).subspan(offset, count).begin()
+			);
+		}
+}
+
+void ProcessingGraph::runReadyNodes() {
+	for (int attempts = 0; completed < scheduledNodes; ++attempts) {
+		int node{};
+		if (popReady(node)) {
+			run(node);
+			finish(node);
+			attempts = 0;
+		}
+		else if (attempts >= 1 << 10)
+			std::this_thread::yield();
+	}
+}
+
+void ProcessingGraph::run(int node) {
+	auto destination = buffer(node);
+	const auto &node_ = nodes[node];
+	auto first = buffer(node_.inputs.front());
+	std::copy(first.begin(), first.end(), destination.begin());
+	if (node_.operation == Operation::mix)
+		for (std::size_t i = 1; i < node_.inputs.size(); ++i) {
+			auto source = buffer(node_.inputs[i]);
+			std::transform(
+				source.begin(), 
+				source.end(), 
+				destination.begin(), 
+				destination.begin(), 
+				std::plus<channel_type::element_type>{}
+			);
+		}
+	else if (node_.processor)
+		node_.processor->process(destination);
+}
+
+void ProcessingGraph::finish(int node) {
+	for (int consumer : consumers[node])
+		if (pending[consumer].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			pushReady(consumer);
+	completed.fetch_add(1, std::memory_order_release);
+}
+
+// Every node becomes ready at most once per block, so the ready list never 
+// wraps: claiming a slot is a single increment and publishing it a store.
+void ProcessingGraph::pushReady(int node) {
+	const auto slot = readyTail.fetch_add(1, std::memory_order_acq_rel);
+	readyNodes[slot] = node;
+	readyPublished[slot].store(block, std::memory_order_release);
+}
+
+bool ProcessingGraph::popReady(int &node) {
+	auto head = readyHead.load(std::memory_order_acquire);
+	while (head < readyTail.load(std::memory_order_acquire))
+		if (readyHead.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel)) {
+			while (readyPublished[head].load(std::memory_order_acquire) != block) {}
+			node = readyNodes[head];
+			return true;
+		}
+	return false;
+}
+
+// Loaders ask for the delay on every block, so it is found once here rather 
+// than on the audio thread.
+auto ProcessingGraph::groupDelay() -> channel_type::index_type {
+	return groupDelay_;
+}
+
+void ProcessingGraph::reset() {
+	for (const auto &node : nodes)
+		if (node.processor)
+			node.processor->reset();
+}
+
+auto ProcessingGraph::longestPathDelay() const -> channel_type::index_type {
+	std::vector<channel_type::index_type> delay(nodes.size());
+	channel_type::index_type maximum{ 0 };
+	for (int node : order) {
+		const auto &node_ = nodes.at(node);
+		for (int input : node_.inputs)
+			delay.at(node) = std::max(delay.at(node), delay.at(input));
+		if (node_.operation == Operation::process && node_.processor)
+			delay.at(node) += node_.processor->groupDelay();
+		if (node_.operation == Operation::output)
+			maximum = std::max(maximum, delay.at(node));
+	}
+	return maximum;
+}
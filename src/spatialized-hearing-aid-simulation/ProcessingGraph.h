@@ -0,0 +1,88 @@
+#pragma once
+
+#include "AudioFrameProcessor.h"
+#include "SignalProcessor.h"
+#include "PersistentWorkers.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <common-includes/RuntimeError.h>
+#include <vector>
+#include <memory>
+#include <atomic>
+
+// Runs an acyclic graph of processing nodes over a block of audio.
+// Input nodes copy an audio channel into the graph and output nodes copy a 
+// node's result back, after every other node has run. The remaining nodes 
+// run as soon as their inputs are ready, on the calling thread and on up to
+// as many workers as the widest level of the graph can keep busy.
+class ProcessingGraph : public AudioFrameProcessor {
+public:
+	enum class Operation {
+		input,
+		output,
+		process,
+		mix
+	};
+
+	struct Node {
+		Operation operation;
+		std::vector<int> inputs;
+		// Passes the input through unchanged when empty.
+		std::shared_ptr<SignalProcessor> processor;
+		int channel;
+	};
+
+	SPATIALIZED_HA_SIMULATION_API ProcessingGraph(
+		std::vector<Node>,
+		channel_type::index_type framesPerBuffer,
+		int maximumWorkers,
+		RealTimeSetup * = nullptr
+	);
+	SPATIALIZED_HA_SIMULATION_API void process(gsl::span<channel_type> audio) override;
+	SPATIALIZED_HA_SIMULATION_API channel_type::index_type groupDelay() override;
+	SPATIALIZED_HA_SIMULATION_API void reset() override;
+	SPATIALIZED_HA_SIMULATION_API int workers() const noexcept;
+
+	// Throws InvalidTopology unless the nodes form a valid acyclic graph.
+	SPATIALIZED_HA_SIMULATION_API static std::vector<int> topologicalOrder(
+		const std::vector<Node> &
+	);
+	RUNTIME_ERROR(InvalidTopology)
+private:
+	static std::vector<int> topologicalOrder(const std::vector<std::vector<int>> &inputs);
+	static std::vector<std::vector<int>> inputsOf(const std::vector<Node> &);
+	bool runsOnWorkers(int node) const;
+	int parallelWidth() const;
+	channel_type::index_type longestPathDelay() const;
+	void sizeBuffers(channel_type::index_type);
+	void processBlock(
+		gsl::span<channel_type> audio, 
+		channel_type::index_type offset, 
+		channel_type::index_type count
+	);
+	void runReadyNodes();
+	void run(int node);
+	void finish(int node);
+	void pushReady(int node);
+	bool popReady(int &node);
+	channel_type buffer(int node);
+
+	using block_type = unsigned long long;
+	std::vector<Node> nodes;
+	std::vector<int> order;
+	std::vector<std::vector<int>> consumers{};
+	std::vector<int> dependencies{};
+	std::vector<int> roots{};
+	std::vector<std::vector<channel_type::element_type>> buffers{};
+	std::unique_ptr<std::atomic<int>[]> pending;
+	std::unique_ptr<int[]> readyNodes;
+	std::unique_ptr<std::atomic<block_type>[]> readyPublished;
+	std::atomic<int> readyHead{ 0 };
+	std::atomic<int> readyTail{ 0 };
+	std::atomic<int> completed{ 0 };
+	channel_type::index_type capacity{};
+	channel_type::index_type frames{};
+	channel_type::index_type groupDelay_{};
+	block_type block{ 0 };
+	int scheduledNodes{};
+	PersistentWorkers workers_;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <common-includes/Interface.h>
+#include <common-includes/RuntimeError.h>
+#include <vector>
+#include <string>
+
+class ProcessingGraphReader {
+public:
+    INTERFACE_OPERATIONS(ProcessingGraphReader)
+	enum class NodeType {
+		input,
+		output,
+		scale,
+		fir,
+		hearingAid,
+		mix,
+		split
+	};
+
+	struct Node {
+		std::vector<int> inputs;
+		// BRIR for FIR nodes, prescription for hearing aid nodes.
+		std::string filePath;
+		NodeType type;
+		// Audio channel for input and output nodes, calibrated channel for
+		// scale nodes, and BRIR ear (0 is left) for FIR nodes.
+		int channel;
+	};
+	virtual std::vector<Node> read(std::string filePath) = 0;
+    RUNTIME_ERROR(ReadFailure)
+};
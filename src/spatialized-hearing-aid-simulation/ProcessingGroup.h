@@ -0,0 +1,20 @@
+#pragma once
+
+#include "AudioFrameProcessor.h"
+#include "RealTimeSetup.h"
+#include "SignalProcessor.h"
+#include <vector>
+#include <memory>
+
+class ProcessingGroupFactory {
+public:
+    INTERFACE_OPERATIONS(ProcessingGroupFactory)
+	using channel_processing_type = std::shared_ptr<SignalProcessor>;
+	using processing_group_type = std::vector<channel_processing_type>;
+	// Any threads the group works on are set up for real time when given a
+	// setup, which is only for groups that play from the device's callback.
+	virtual std::shared_ptr<AudioFrameProcessor> make(
+		processing_group_type,
+		RealTimeSetup *
+	) = 0;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <common-includes/Interface.h>
+
+// Prepares threads that must keep up with the audio device.
+class RealTimeSetup {
+public:
+    INTERFACE_OPERATIONS(RealTimeSetup)
+	// Called on the thread itself before it does any audio work. Must not
+	// allocate, since the thread may already be the device's callback.
+	virtual void configureCurrentThread() = 0;
+	// Keeps the pages holding the stimulus and processing from being paged
+	// out. Called once both are made and before they are played.
+	virtual void lockMemory() = 0;
+};
@@ -0,0 +1,57 @@
+#include "RealTimeSetupImpl.h"
+#include <gsl/gsl>
+
+RealTimeSetupImpl::RealTimeSetupImpl(RealTimeHost *host, Settings settings) :
+	settings{ std::move(settings) },
+	host{ host } {}
+
+void RealTimeSetupImpl::configureCurrentThread() {
+	if (settings.flushDenormals)
+		count(denormalsFlushed, host->flushDenormals());
+	if (settings.raisePriority)
+		count(priorityRaised, host->raisePriority());
+	if (!settings.cores.empty()) {
+		const auto next = gsl::narrow_cast<std::size_t>(threadsPinned++);
+		count(pinnedToCore, host->pinToCore(settings.cores[next % settings.cores.size()]));
+	}
+}
+
+void RealTimeSetupImpl::lockMemory() {
+	if (settings.lockMemory)
+		count(memoryLocked, host->lockMemory());
+}
+
+void RealTimeSetupImpl::count(Tally &tally, bool succeeded) {
+	++tally.attempts;
+	if (succeeded)
+		++tally.successes;
+}
+
+auto RealTimeSetupImpl::step(const Tally &tally) -> Step {
+	return { tally.attempts.load(), tally.successes.load() };
+}
+
+static std::string line(const std::string &name, RealTimeSetupImpl::Step step) {
+	return 
+		name + ": " + 
+		std::to_string(step.successes) + " of " + 
+		std::to_string(step.attempts) + "\n";
+}
+
+std::string RealTimeSetupImpl::summary() const {
+	const auto report_ = report();
+	return 
+		line("denormals flushed", report_.denormalsFlushed) +
+		line("priority raised", report_.priorityRaised) +
+		line("pinned to core", report_.pinnedToCore) +
+		line("memory locked", report_.memoryLocked);
+}
+
+auto RealTimeSetupImpl::report() const -> Report {
+	return { 
+		step(denormalsFlushed), 
+		step(priorityRaised), 
+		step(pinnedToCore), 
+		step(memoryLocked) 
+	};
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "RealTimeSetup.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+// What the operating system and processor offer. Each returns whether it
+// took effect.
+class RealTimeHost {
+public:
+    INTERFACE_OPERATIONS(RealTimeHost)
+	// Flushes denormal results and treats denormal inputs as zero, so decaying
+	// reverb tails and release phases do not slow the calling thread.
+	virtual bool flushDenormals() = 0;
+	// Real-time scheduling when permitted; otherwise the highest allowed.
+	virtual bool raisePriority() = 0;
+	virtual bool pinToCore(int) = 0;
+	virtual bool lockMemory() = 0;
+};
+
+class RealTimeSetupImpl : public RealTimeSetup {
+public:
+	struct Settings {
+		// Threads are pinned to these in turn; none are pinned when empty.
+		std::vector<int> cores{};
+		bool flushDenormals{ true };
+		bool raisePriority{ true };
+		bool lockMemory{};
+	};
+
+	struct Step {
+		int attempts;
+		int successes;
+	};
+
+	// How often each step was tried and how often it took effect, over
+	// every thread configured so far.
+	struct Report {
+		Step denormalsFlushed;
+		Step priorityRaised;
+		Step pinnedToCore;
+		Step memoryLocked;
+	};
+
+	SPATIALIZED_HA_SIMULATION_API RealTimeSetupImpl(RealTimeHost *, Settings);
+	SPATIALIZED_HA_SIMULATION_API void configureCurrentThread() override;
+	SPATIALIZED_HA_SIMULATION_API void lockMemory() override;
+	SPATIALIZED_HA_SIMULATION_API Report report() const;
+	// The report as text, a line per step, for the app's log.
+	SPATIALIZED_HA_SIMULATION_API std::string summary() const;
+private:
+	struct Tally {
+		std::atomic<int> attempts{ 0 };
+		std::atomic<int> successes{ 0 };
+	};
+	static void count(Tally &, bool succeeded);
+	static Step step(const Tally &);
+
+	Settings settings;
+	Tally denormalsFlushed{};
+	Tally priorityRaised{};
+	Tally pinnedToCore{};
+	Tally memoryLocked{};
+	std::atomic<int> threadsPinned{ 0 };
+	RealTimeHost *host;
+};
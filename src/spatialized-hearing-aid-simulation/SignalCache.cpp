@@ -0,0 +1,120 @@
+#include "SignalCache.h"
+
+SignalCache::SignalCache(
+	SignalStore *store, 
+	std::size_t memoryBudgetBytes
+) :
+	store{ store },
+	memoryBudgetBytes{ memoryBudgetBytes } {}
+
+SignalCache::~SignalCache() noexcept {
+	for (auto &entry : entries)
+		try {
+			remove(entry.second);
+		}
+		catch (const SignalStore::StoreFailure &) {
+		}
+}
+
+auto SignalCache::find(const std::string &key) -> std::shared_ptr<const channels_type> {
+	const auto found = entries.find(key);
+	if (found == entries.end())
+		return {};
+	auto &entry = found->second;
+	if (!entry.signal)
+		load(entry);
+	touch(entry);
+	auto signal = entry.signal;
+	spillUntilWithinBudget();
+	return signal;
+}
+
+auto SignalCache::insert(
+	std::string key, 
+	channels_type channels
+) -> std::shared_ptr<const channels_type> {
+	const auto existing = entries.find(key);
+	if (existing != entries.end()) {
+		remove(existing->second);
+		if (existing->second.signal)
+			residentBytes_ -= existing->second.bytes;
+		recency.erase(existing->second.recency);
+		entries.erase(existing);
+	}
+	Entry entry{};
+	entry.id = nextId++;
+	for (const auto &channel : channels) {
+		entry.frames.push_back(channel.size());
+		entry.bytes += channel.size() * sizeof(float);
+	}
+	entry.signal = std::make_shared<const channels_type>(std::move(channels));
+	entry.recency = recency.insert(recency.end(), key);
+	residentBytes_ += entry.bytes;
+	auto signal = entry.signal;
+	auto &inserted = entries.emplace(std::move(key), std::move(entry)).first->second;
+	touch(inserted);
+	spillUntilWithinBudget();
+	return signal;
+}
+
+void SignalCache::touch(Entry &entry) {
+	recency.splice(recency.end(), recency, entry.recency);
+}
+
+void SignalCache::spillUntilWithinBudget() {
+	for (const auto &key : recency) {
+		if (residentBytes_ <= memoryBudgetBytes)
+			return;
+		auto &entry = entries.at(key);
+		if (entry.signal)
+			spill(entry);
+	}
+}
+
+// Signals never change once inserted, so one that was saved before is 
+// only dropped from memory.
+void SignalCache::spill(Entry &entry) {
+	if (!entry.stored) {
+		for (std::size_t i = 0; i < entry.signal->size(); ++i)
+			store->save(storedName(entry, i), entry.signal->at(i));
+		entry.stored = true;
+	}
+	entry.signal.reset();
+	residentBytes_ -= entry.bytes;
+}
+
+void SignalCache::load(Entry &entry) {
+	channels_type channels;
+	for (std::size_t i = 0; i < entry.frames.size(); ++i) {
+		signal_type channel(entry.frames.at(i));
+		store->load(storedName(entry, i), channel);
+		channels.push_back(std::move(channel));
+	}
+	entry.signal = std::make_shared<const channels_type>(std::move(channels));
+	residentBytes_ += entry.bytes;
+}
+
+void SignalCache::remove(Entry &entry) {
+	if (!entry.stored)
+		return;
+	entry.stored = false;
+	for (std::size_t i = 0; i < entry.frames.size(); ++i)
+		store->remove(storedName(entry, i));
+}
+
+std::string SignalCache::storedName(const Entry &entry, std::size_t channel) const {
+	return std::to_string(entry.id) + "-" + std::to_string(channel);
+}
+
+bool SignalCache::resident(const std::string &key) const {
+	const auto found = entries.find(key);
+	return found != entries.end() && found->second.signal;
+}
+
+bool SignalCache::fits(std::size_t bytes) const noexcept {
+	return bytes <= memoryBudgetBytes;
+}
+
+std::size_t SignalCache::residentBytes() const noexcept {
+	return residentBytes_;
+}
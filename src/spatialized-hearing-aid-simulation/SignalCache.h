@@ -0,0 +1,63 @@
+#pragma once
+
+#include "SignalStore.h"
+#include "spatialized-hearing-aid-simulation-exports.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <list>
+#include <map>
+
+// Memoizes multichannel signals by key. Once the signals held in memory 
+// exceed the budget, the least recently used are saved to a store and 
+// loaded back when found again. Signals already handed out stay valid.
+class SignalCache {
+public:
+	using signal_type = std::vector<float>;
+	using channels_type = std::vector<signal_type>;
+
+	SPATIALIZED_HA_SIMULATION_API SignalCache(
+		SignalStore *, 
+		std::size_t memoryBudgetBytes
+	);
+	SPATIALIZED_HA_SIMULATION_API ~SignalCache() noexcept;
+	SignalCache(const SignalCache &) = delete;
+	SignalCache &operator=(const SignalCache &) = delete;
+	SignalCache(SignalCache &&) = delete;
+	SignalCache &operator=(SignalCache &&) = delete;
+
+	// Returns null when nothing was inserted under the key.
+	SPATIALIZED_HA_SIMULATION_API std::shared_ptr<const channels_type> find(
+		const std::string &key
+	);
+	SPATIALIZED_HA_SIMULATION_API std::shared_ptr<const channels_type> insert(
+		std::string key, 
+		channels_type
+	);
+	SPATIALIZED_HA_SIMULATION_API bool resident(const std::string &key) const;
+	// Whether a signal of that many bytes could be held in memory at all.
+	SPATIALIZED_HA_SIMULATION_API bool fits(std::size_t bytes) const noexcept;
+	SPATIALIZED_HA_SIMULATION_API std::size_t residentBytes() const noexcept;
+private:
+	struct Entry {
+		std::shared_ptr<const channels_type> signal;
+		std::list<std::string>::iterator recency;
+		std::vector<std::size_t> frames;
+		std::size_t bytes;
+		int id;
+		bool stored;
+	};
+	void touch(Entry &);
+	void spillUntilWithinBudget();
+	void spill(Entry &);
+	void load(Entry &);
+	void remove(Entry &);
+	std::string storedName(const Entry &, std::size_t channel) const;
+
+	std::map<std::string, Entry> entries{};
+	std::list<std::string> recency{};
+	SignalStore *store;
+	std::size_t memoryBudgetBytes;
+	std::size_t residentBytes_{};
+	int nextId{};
+};
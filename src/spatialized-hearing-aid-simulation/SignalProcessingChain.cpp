@@ -2,7 +2,7 @@
 #include <algorithm>
 
 void SignalProcessingChain::process(signal_type signal) {
-	for (auto processor : processors)
+	for (const auto &processor : processors)
 		processor->process(signal);
 }
 
@@ -10,13 +10,28 @@ void SignalProcessingChain::add(processing_element_type processor) {
 	processors.push_back(std::move(processor));
 }
 
+void SignalProcessingChain::addScalable(processing_element_type processor) {
+	scalable.push_back(processor);
+	add(std::move(processor));
+}
+
 auto SignalProcessingChain::groupDelay() -> index_type {
 	return std::accumulate(
 		processors.begin(),
 		processors.end(),
 		index_type{ 0 },
-		[](index_type x, processing_element_type processor) { 
+		[](index_type x, const processing_element_type &processor) { 
 			return x + processor->groupDelay(); 
 		}
 	);
-}
\ No newline at end of file
+}
+
+void SignalProcessingChain::reset() {
+	for (const auto &processor : processors)
+		processor->reset();
+}
+
+void SignalProcessingChain::setScale(float scale) {
+	for (const auto &processor : scalable)
+		processor->setScale(scale);
+}
@@ -10,7 +10,14 @@ public:
 	using processing_element_type = std::shared_ptr<SignalProcessor>;
 	SPATIALIZED_HA_SIMULATION_API void process(signal_type signal) override;
 	SPATIALIZED_HA_SIMULATION_API void add(processing_element_type);
+
+	// For stages with a gain, such as the calibration scale, which are the
+	// only ones given the scale.
+	SPATIALIZED_HA_SIMULATION_API void addScalable(processing_element_type);
 	SPATIALIZED_HA_SIMULATION_API index_type groupDelay() override;
+	SPATIALIZED_HA_SIMULATION_API void reset() override;
+	SPATIALIZED_HA_SIMULATION_API void setScale(float) override;
 private:
 	std::vector<processing_element_type> processors{};
+	std::vector<processing_element_type> scalable{};
 };
@@ -10,4 +10,6 @@ public:
 	using index_type = signal_type::index_type;
 	virtual void process(signal_type signal) = 0;
 	virtual index_type groupDelay() = 0;
+	virtual void reset() = 0;
+	virtual void setScale(float) = 0;
 };
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <common-includes/Interface.h>
+#include <common-includes/RuntimeError.h>
+#include <gsl/gsl>
+#include <string>
+
+// Holds signals outside of memory until they are loaded again by name.
+class SignalStore {
+public:
+    INTERFACE_OPERATIONS(SignalStore)
+	using signal_type = gsl::span<float>;
+	virtual void save(std::string name, gsl::span<const float>) = 0;
+	virtual void load(std::string name, signal_type) = 0;
+	virtual void remove(std::string name) = 0;
+	RUNTIME_ERROR(StoreFailure)
+};
@@ -40,4 +40,9 @@ public:
 	virtual std::shared_ptr<SignalProcessor> makeFullSimulation(
 		FullSimulation , float 
 	) = 0;
+
+	// Channels made afterwards share a new arena; the previous one is 
+	// released once the last channel made from it is gone. Channels may be
+	// made on other threads meanwhile.
+	virtual void beginArena() = 0;
 };
@@ -15,7 +15,7 @@ std::shared_ptr<SignalProcessor> SimulationChannelFactoryImpl::makeFullSimulatio
 	float scale
 ) {
 	auto chain = std::make_shared<SignalProcessingChain>();
-	chain->add(makeScalingProcessor(scale));
+	chain->addScalable(makeScalingProcessor(scale));
 	chain->add(makeFirFilter(std::move(p.spatialization)));
 	chain->add(makeHearingAid(std::move(p.hearingAid)));
 	return chain;
@@ -39,7 +39,7 @@ std::shared_ptr<SignalProcessor> SimulationChannelFactoryImpl::makeHearingAidSim
 )
 {
 	auto chain = std::make_shared<SignalProcessingChain>();
-	chain->add(makeScalingProcessor(scale));
+	chain->addScalable(makeScalingProcessor(scale));
 	chain->add(makeHearingAid(std::move(s)));
 	return chain;
 }
@@ -49,7 +49,7 @@ std::shared_ptr<SignalProcessor> SimulationChannelFactoryImpl::makeSpatializatio
 	float scale
 ) {
 	auto chain = std::make_shared<SignalProcessingChain>();
-	chain->add(makeScalingProcessor(scale));
+	chain->addScalable(makeScalingProcessor(scale));
 	chain->add(makeFirFilter(std::move(s)));
 	return chain;
 }
@@ -60,6 +60,9 @@ std::shared_ptr<SignalProcessor> SimulationChannelFactoryImpl::makeWithoutSimula
 	return makeScalingProcessor(scale);
 }
 
+// Each stage comes from its own factory, which decides how it is allocated.
+void SimulationChannelFactoryImpl::beginArena() {}
+
 FilterbankCompressor::Parameters SimulationChannelFactoryImpl::compression(
 	HearingAidSimulation p
 ) {
@@ -47,9 +47,12 @@ public:
 	SPATIALIZED_HA_SIMULATION_API std::shared_ptr<SignalProcessor> makeWithoutSimulation(
 		float scale
 	) override;
+	SPATIALIZED_HA_SIMULATION_API void beginArena() override;
+	SPATIALIZED_HA_SIMULATION_API static FilterbankCompressor::Parameters compression(
+		HearingAidSimulation p
+	);
 private:
 	std::shared_ptr<SignalProcessor> makeScalingProcessor(float scale);
 	std::shared_ptr<SignalProcessor> makeFirFilter(Spatialization);
 	std::shared_ptr<SignalProcessor> makeHearingAid(HearingAidSimulation);
-	FilterbankCompressor::Parameters compression(HearingAidSimulation p);
 };
@@ -1,6 +1,16 @@
 #include "SpatialHearingAidModel.h"
+#include "ProcessingGroup.h"
 #include "ChannelProcessingGroup.h"
+#include "ProcessingGraph.h"
+#include "CachedSignalReader.h"
+#include "ChannelFanOut.h"
 #include <gsl/gsl>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 class StereoCalibration {
 	std::shared_ptr<CalibrationComputer> computer;
@@ -25,73 +35,319 @@ public:
 	float rightChannelScale() {
 		return gsl::narrow_cast<float>(channelScale(1));
 	}
+
+	bool channelsEqual() {
+		return computer->channelsEqual();
+	}
 };
 
+// Measures each stimulus file once per test, however many readers it is
+// read through, so playing it again does not decode all of it first. The 
+// model tells which file each of its readers reads as it makes them.
+class MeasuredStimuli : public CalibrationComputerFactory {
+	struct Reading {
+		std::weak_ptr<AudioFrameReader> reader;
+		std::string filePath;
+	};
+	std::map<const AudioFrameReader *, Reading> readings{};
+	std::map<std::string, std::shared_ptr<CalibrationComputer>> measured{};
+	std::mutex mutex{};
+	CalibrationComputerFactory *factory;
+public:
+	explicit MeasuredStimuli(CalibrationComputerFactory *factory) noexcept :
+		factory{ factory } {}
+
+	void track(const std::shared_ptr<AudioFrameReader> &reader, std::string filePath) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		for (auto it = readings.begin(); it != readings.end();)
+			it = it->second.reader.expired() ? readings.erase(it) : std::next(it);
+		readings[reader.get()] = { reader, std::move(filePath) };
+	}
+
+	void clear() {
+		std::lock_guard<std::mutex> lock{ mutex };
+		measured.clear();
+	}
+
+	std::shared_ptr<CalibrationComputer> make(AudioFrameReader *reader) override {
+		const auto filePath = trackedFilePath(reader);
+		if (filePath.empty())
+			return factory->make(reader);
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			const auto found = measured.find(filePath);
+			if (found != measured.end())
+				return found->second;
+		}
+		auto computer = factory->make(reader);
+		std::lock_guard<std::mutex> lock{ mutex };
+		measured.emplace(filePath, computer);
+		return computer;
+	}
+
+private:
+	// An expired reader's address may since have been reused.
+	std::string trackedFilePath(AudioFrameReader *reader) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		const auto found = readings.find(reader);
+		if (found == readings.end() || found->second.reader.lock().get() != reader)
+			return {};
+		return found->second.filePath;
+	}
+};
+
+static bool equal(const Model::SignalProcessing &a, const Model::SignalProcessing &b) {
+	return
+		a.leftDslPrescriptionFilePath == b.leftDslPrescriptionFilePath &&
+		a.rightDslPrescriptionFilePath == b.rightDslPrescriptionFilePath &&
+		a.brirFilePath == b.brirFilePath &&
+		a.processingGraphFilePath == b.processingGraphFilePath &&
+		a.attack_ms == b.attack_ms &&
+		a.release_ms == b.release_ms &&
+		a.windowSize == b.windowSize &&
+		a.chunkSize == b.chunkSize &&
+		a.usingHearingAidSimulation == b.usingHearingAidSimulation &&
+		a.usingSpatialization == b.usingSpatialization &&
+		a.usingProcessingGraph == b.usingProcessingGraph;
+}
+
+static bool equal(const PrescriptionReader::Dsl &a, const PrescriptionReader::Dsl &b) {
+	return 
+		a.crossFrequenciesHz == b.crossFrequenciesHz &&
+		a.compressionRatios == b.compressionRatios &&
+		a.kneepointGains_dB == b.kneepointGains_dB &&
+		a.kneepoints_dBSpl == b.kneepoints_dBSpl &&
+		a.broadbandOutputLimitingThresholds_dBSpl == b.broadbandOutputLimitingThresholds_dBSpl &&
+		a.channels == b.channels;
+}
+
 class NullProcessorFactory : public StereoSimulationFactory {
 	std::shared_ptr<AudioFrameProcessor> make(AudioFrameReader *, double) override { return {}; }
+	std::shared_ptr<AudioFrameProcessor> makeUnitGain(AudioFrameReader *) override { return {}; }
+	std::shared_ptr<AudioFrameProcessor> makeGain(AudioFrameReader *, double) override { return {}; }
+	std::shared_ptr<StereoSimulationFactory> clone() override { 
+		return std::make_shared<NullProcessorFactory>(); 
+	}
+};
+
+// Plays a signal that was processed ahead of time.
+class AlreadyProcessed : public AudioFrameProcessor {
+public:
+	void process(gsl::span<channel_type>) override {}
+	channel_type::index_type groupDelay() override { return 0; }
+	void reset() override {}
+};
+
+// Keeps the channels built for the first trial so later trials only clear 
+// their state and take the new calibration scales.
+class ReusableChannels {
+	ProcessingGroupFactory::processing_group_type channels{};
+	std::shared_ptr<AudioFrameProcessor> processor{};
+public:
+	void clear() {
+		channels.clear();
+		processor.reset();
+	}
+
+	template<typename MakeChannel, typename MakeProcessor>
+	std::shared_ptr<AudioFrameProcessor> make(
+		std::vector<float> scales,
+		MakeChannel makeChannel,
+		MakeProcessor makeProcessor
+	) {
+		using size_type = std::vector<float>::size_type;
+		if (processor) {
+			for (size_type i{ 0 }; i < scales.size(); ++i) {
+				channels.at(i)->reset();
+				channels.at(i)->setScale(scales.at(i));
+			}
+			return processor;
+		}
+
+		for (size_type i{ 0 }; i < scales.size(); ++i)
+			channels.push_back(makeChannel(gsl::narrow<int>(i), scales.at(i)));
+		return processor = makeProcessor(channels);
+	}
+};
+
+static StereoSimulationFactory::HearingAidSimulation hearingAidSimulation(
+	const SimulationChannelFactory::HearingAidSimulation &left,
+	const SimulationChannelFactory::HearingAidSimulation &right
+) {
+	StereoSimulationFactory::HearingAidSimulation processing{};
+	processing.leftPrescription = left.prescription;
+	processing.rightPrescription = right.prescription;
+	processing.attack_ms = left.attack_ms;
+	processing.release_ms = left.release_ms;
+	processing.windowSize = left.windowSize;
+	processing.chunkSize = left.chunkSize;
+	return processing;
+}
+
+// Scaling a channel costs less than handing it to another thread, so gain
+// alone is always processed one channel after the other.
+class StereoNoSimulation : public StereoSimulationFactory {
+	ReusableChannels scaled{};
+	ReusableChannels unscaled{};
+	ChannelProcessingGroupFactory groupFactory{};
+	SimulationChannelFactory *channelFactory;
+	CalibrationComputerFactory *calibrationComputerFactory;
+	RealTimeSetup *realTime;
+public:
+	StereoNoSimulation(
+		SimulationChannelFactory *channelFactory,
+		CalibrationComputerFactory *calibrationComputerFactory,
+		RealTimeSetup *realTime
+	) noexcept :
+		channelFactory{ channelFactory },
+		calibrationComputerFactory{ calibrationComputerFactory },
+		realTime{ realTime } {}
+
+	std::shared_ptr<AudioFrameProcessor> make(AudioFrameReader *reader, double level_dB_Spl) override {
+		StereoCalibration stereoCalibration{ calibrationComputerFactory->make(reader), level_dB_Spl };
+		return scale(
+			scaled, 
+			{ stereoCalibration.leftChannelScale(), stereoCalibration.rightChannelScale() }
+		);
+	}
+
+	std::shared_ptr<AudioFrameProcessor> makeUnitGain(AudioFrameReader *) override {
+		return scale(unscaled, { 1, 1 });
+	}
+
+	std::shared_ptr<AudioFrameProcessor> makeGain(AudioFrameReader *reader, double level_dB_Spl) override {
+		return make(reader, level_dB_Spl);
+	}
+
+	std::shared_ptr<StereoSimulationFactory> clone() override {
+		return std::make_shared<StereoNoSimulation>(
+			channelFactory, 
+			calibrationComputerFactory, 
+			nullptr
+		);
+	}
+
+private:
+	std::shared_ptr<AudioFrameProcessor> scale(
+		ReusableChannels &channels, 
+		std::vector<float> scales
+	) {
+		return channels.make(
+			std::move(scales),
+			[=](int, float scale) { return channelFactory->makeWithoutSimulation(scale); },
+			[=](ProcessingGroupFactory::processing_group_type group) { 
+				return groupFactory.make(std::move(group), realTime); 
+			}
+		);
+	}
 };
 
 class StereoSpatializationFactory : public StereoSimulationFactory {
 	SimulationChannelFactory::Spatialization left_spatial;
 	SimulationChannelFactory::Spatialization right_spatial;
+	StereoNoSimulation gain;
+	ReusableChannels scaled{};
+	ReusableChannels unscaled{};
 	SimulationChannelFactory *channelFactory;
 	CalibrationComputerFactory *calibrationComputerFactory;
+	ProcessingGroupFactory *groupFactory;
+	RealTimeSetup *realTime;
 public:
 	StereoSpatializationFactory(
 		BrirReader::BinauralRoomImpulseResponse brir_,
 		SimulationChannelFactory *channelFactory,
-		CalibrationComputerFactory *calibrationComputerFactory
+		CalibrationComputerFactory *calibrationComputerFactory,
+		ProcessingGroupFactory *groupFactory,
+		RealTimeSetup *realTime
 	) :
+		gain{ channelFactory, calibrationComputerFactory, realTime },
 		channelFactory{ channelFactory },
-		calibrationComputerFactory{ calibrationComputerFactory } 
+		calibrationComputerFactory{ calibrationComputerFactory },
+		groupFactory{ groupFactory },
+		realTime{ realTime }
 	{
 		left_spatial.filterCoefficients = std::move(brir_.left);
 		right_spatial.filterCoefficients = std::move(brir_.right);
 	}
 
 	std::shared_ptr<AudioFrameProcessor> make(AudioFrameReader *reader, double level_dB_Spl) override {
-		return std::make_shared<ChannelProcessingGroup>(makeChannels(reader, level_dB_Spl));
+		StereoCalibration stereoCalibration{ calibrationComputerFactory->make(reader), level_dB_Spl };
+		return spatialize(
+			scaled, 
+			{ stereoCalibration.leftChannelScale(), stereoCalibration.rightChannelScale() }
+		);
 	}
 
-	std::vector<ChannelProcessingGroup::channel_processing_type> makeChannels(
-		AudioFrameReader *reader, 
-		double level_dB_Spl
-	) {
-		StereoCalibration stereoCalibration{ calibrationComputerFactory->make(reader), level_dB_Spl };
+	std::shared_ptr<AudioFrameProcessor> makeUnitGain(AudioFrameReader *) override {
+		return spatialize(unscaled, { 1, 1 });
+	}
 
-		return { 
-			channelFactory->makeSpatialization(
-				left_spatial, 
-				stereoCalibration.leftChannelScale()
-			), 
-			channelFactory->makeSpatialization(
-				right_spatial, 
-				stereoCalibration.rightChannelScale()
-			) 
-		};
+	std::shared_ptr<AudioFrameProcessor> makeGain(AudioFrameReader *reader, double level_dB_Spl) override {
+		return gain.make(reader, level_dB_Spl);
+	}
+
+	std::shared_ptr<StereoSimulationFactory> clone() override {
+		BrirReader::BinauralRoomImpulseResponse brir{};
+		brir.left = left_spatial.filterCoefficients;
+		brir.right = right_spatial.filterCoefficients;
+		return std::make_shared<StereoSpatializationFactory>(
+			std::move(brir),
+			channelFactory, 
+			calibrationComputerFactory, 
+			groupFactory,
+			nullptr
+		);
+	}
+
+private:
+	std::shared_ptr<AudioFrameProcessor> spatialize(
+		ReusableChannels &channels, 
+		std::vector<float> scales
+	) {
+		return channels.make(
+			std::move(scales),
+			[=](int channel, float scale) { 
+				return channelFactory->makeSpatialization(
+					channel == 0 ? left_spatial : right_spatial, 
+					scale
+				); 
+			},
+			[=](ProcessingGroupFactory::processing_group_type group) { 
+				return groupFactory->make(std::move(group), realTime); 
+			}
+		);
 	}
 };
 
 class StereoHearingAidFactory : public StereoSimulationFactory {
 	SimulationChannelFactory::HearingAidSimulation left_hs;
 	SimulationChannelFactory::HearingAidSimulation right_hs;
+	ReusableChannels channels{};
 	SimulationChannelFactory *channelFactory;
 	CalibrationComputerFactory *calibrationComputerFactory;
+	ProcessingGroupFactory *groupFactory;
+	RealTimeSetup *realTime;
+	bool identical{};
 public:
 	StereoHearingAidFactory(
 		HearingAidSimulation processing,
 		SimulationChannelFactory *channelFactory,
-		CalibrationComputerFactory *calibrationComputerFactory
+		CalibrationComputerFactory *calibrationComputerFactory,
+		ProcessingGroupFactory *groupFactory,
+		RealTimeSetup *realTime
 	) :
 		channelFactory{ channelFactory },
-		calibrationComputerFactory{ calibrationComputerFactory } 
+		calibrationComputerFactory{ calibrationComputerFactory },
+		groupFactory{ groupFactory },
+		realTime{ realTime }
 	{
-		SimulationChannelFactory::HearingAidSimulation both_hs;
+		SimulationChannelFactory::HearingAidSimulation both_hs{};
 		both_hs.attack_ms = processing.attack_ms;
 		both_hs.release_ms = processing.release_ms;
 		both_hs.chunkSize = processing.chunkSize;
 		both_hs.windowSize = processing.windowSize;
 		both_hs.fullScaleLevel_dB_Spl = SpatialHearingAidModel::fullScaleLevel_dB_Spl;
+		both_hs.sampleRate = 0;
 
 		left_hs = both_hs;
 		right_hs = both_hs;
@@ -100,55 +356,99 @@ public:
 	}
 
 	std::shared_ptr<AudioFrameProcessor> make(AudioFrameReader *reader, double level_dB_Spl) override {
-		return std::make_shared<ChannelProcessingGroup>(makeChannels(reader, level_dB_Spl));
-	}
-
-	std::vector<ChannelProcessingGroup::channel_processing_type> makeChannels(
-		AudioFrameReader *reader, 
-		double level_dB_Spl
-	) {
+		StereoCalibration stereoCalibration{ calibrationComputerFactory->make(reader), level_dB_Spl };
+		const auto identical_ = identicalChains(stereoCalibration);
+		if (reader->sampleRate() != left_hs.sampleRate || identical_ != identical)
+			channels.clear();
 		left_hs.sampleRate = reader->sampleRate();
 		right_hs.sampleRate = reader->sampleRate();
+		identical = identical_;
 
-		StereoCalibration stereoCalibration{ calibrationComputerFactory->make(reader), level_dB_Spl };
-
-		return { 
-			channelFactory->makeHearingAidSimulation(
-				left_hs, 
-				stereoCalibration.leftChannelScale()
-			), 
-			channelFactory->makeHearingAidSimulation(
-				right_hs, 
-				stereoCalibration.rightChannelScale()
-			) 
+		auto makeChannel = [=](int channel, float scale) {
+			return channelFactory->makeHearingAidSimulation(
+				channel == 0 ? left_hs : right_hs, 
+				scale
+			);
 		};
+		if (identical)
+			return channels.make(
+				{ stereoCalibration.leftChannelScale() },
+				makeChannel,
+				[](ProcessingGroupFactory::processing_group_type group) {
+					return std::make_shared<ChannelFanOut>(group.front());
+				}
+			);
+
+		return channels.make(
+			{ stereoCalibration.leftChannelScale(), stereoCalibration.rightChannelScale() },
+			makeChannel,
+			[=](ProcessingGroupFactory::processing_group_type group) { 
+				return groupFactory->make(std::move(group), realTime); 
+			}
+		);
+	}
+
+	std::shared_ptr<AudioFrameProcessor> makeUnitGain(AudioFrameReader *) override {
+		return {};
+	}
+
+	std::shared_ptr<AudioFrameProcessor> makeGain(AudioFrameReader *, double) override {
+		return {};
+	}
+
+	std::shared_ptr<StereoSimulationFactory> clone() override {
+		return std::make_shared<StereoHearingAidFactory>(
+			hearingAidSimulation(left_hs, right_hs),
+			channelFactory, 
+			calibrationComputerFactory, 
+			groupFactory,
+			nullptr
+		);
+	}
+
+private:
+	// Equal inputs through equal prescriptions at equal scales produce
+	// equal outputs, e.g. a mono stimulus for a symmetric loss.
+	bool identicalChains(StereoCalibration &calibration) {
+		return 
+			calibration.channelsEqual() &&
+			equal(left_hs.prescription, right_hs.prescription) &&
+			calibration.leftChannelScale() == calibration.rightChannelScale();
 	}
 };
 
 class StereoSpatializedHearingAidSimulationFactory : public StereoSimulationFactory {	
 	SimulationChannelFactory::FullSimulation left_fs;	
 	SimulationChannelFactory::FullSimulation right_fs;
+	ReusableChannels channels{};
 	SimulationChannelFactory *channelFactory;
 	CalibrationComputerFactory *calibrationComputerFactory;
+	ProcessingGroupFactory *groupFactory;
+	RealTimeSetup *realTime;
 public:
 	StereoSpatializedHearingAidSimulationFactory(
 		BrirReader::BinauralRoomImpulseResponse brir_,
 		StereoSimulationFactory::HearingAidSimulation processing,
 		SimulationChannelFactory *channelFactory,
-		CalibrationComputerFactory *calibrationComputerFactory
+		CalibrationComputerFactory *calibrationComputerFactory,
+		ProcessingGroupFactory *groupFactory,
+		RealTimeSetup *realTime
 	) :
 		channelFactory{ channelFactory },
-		calibrationComputerFactory{ calibrationComputerFactory } 
+		calibrationComputerFactory{ calibrationComputerFactory },
+		groupFactory{ groupFactory },
+		realTime{ realTime }
 	{
 		left_fs.spatialization.filterCoefficients = std::move(brir_.left);
 		right_fs.spatialization.filterCoefficients = std::move(brir_.right);
 
-		SimulationChannelFactory::HearingAidSimulation both_hs;
+		SimulationChannelFactory::HearingAidSimulation both_hs{};
 		both_hs.attack_ms = processing.attack_ms;
 		both_hs.release_ms = processing.release_ms;
 		both_hs.chunkSize = processing.chunkSize;
 		both_hs.windowSize = processing.windowSize;
 		both_hs.fullScaleLevel_dB_Spl = SpatialHearingAidModel::fullScaleLevel_dB_Spl;
+		both_hs.sampleRate = 0;
 
 		left_fs.hearingAid = both_hs;
 		right_fs.hearingAid = both_hs;
@@ -157,91 +457,216 @@ public:
 	}
 
 	std::shared_ptr<AudioFrameProcessor> make(AudioFrameReader *reader, double level_dB_Spl) override {
-		return std::make_shared<ChannelProcessingGroup>(makeChannels(reader, level_dB_Spl));
-	}
-
-	std::vector<ChannelProcessingGroup::channel_processing_type> makeChannels(
-		AudioFrameReader *reader, 
-		double level_dB_Spl
-	) {
+		if (reader->sampleRate() != left_fs.hearingAid.sampleRate)
+			channels.clear();
 		left_fs.hearingAid.sampleRate = reader->sampleRate();
 		right_fs.hearingAid.sampleRate = reader->sampleRate();
 		
 		StereoCalibration stereoCalibration{ calibrationComputerFactory->make(reader), level_dB_Spl };
+		return channels.make(
+			{ stereoCalibration.leftChannelScale(), stereoCalibration.rightChannelScale() },
+			[=](int channel, float scale) {
+				return channelFactory->makeFullSimulation(
+					channel == 0 ? left_fs : right_fs, 
+					scale
+				);
+			},
+			[=](ProcessingGroupFactory::processing_group_type group) { 
+				return groupFactory->make(std::move(group), realTime); 
+			}
+		);
+	}
 
-		return { 
-			channelFactory->makeFullSimulation(
-				left_fs, 
-				stereoCalibration.leftChannelScale()
-			), 
-			channelFactory->makeFullSimulation(
-				right_fs, 
-				stereoCalibration.rightChannelScale()
-			) 
-		};
+	std::shared_ptr<AudioFrameProcessor> makeUnitGain(AudioFrameReader *) override {
+		return {};
+	}
+
+	std::shared_ptr<AudioFrameProcessor> makeGain(AudioFrameReader *, double) override {
+		return {};
+	}
+
+	std::shared_ptr<StereoSimulationFactory> clone() override {
+		BrirReader::BinauralRoomImpulseResponse brir{};
+		brir.left = left_fs.spatialization.filterCoefficients;
+		brir.right = right_fs.spatialization.filterCoefficients;
+		return std::make_shared<StereoSpatializedHearingAidSimulationFactory>(
+			std::move(brir),
+			hearingAidSimulation(left_fs.hearingAid, right_fs.hearingAid),
+			channelFactory, 
+			calibrationComputerFactory, 
+			groupFactory,
+			nullptr
+		);
 	}
 };
 
-class StereoNoSimulation : public StereoSimulationFactory {
+static ProcessingGraph::Operation graphOperation(ProcessingGraphReader::NodeType t) {
+	using NodeType = ProcessingGraphReader::NodeType;
+	switch (t) {
+	case NodeType::input:
+		return ProcessingGraph::Operation::input;
+	case NodeType::output:
+		return ProcessingGraph::Operation::output;
+	case NodeType::mix:
+		return ProcessingGraph::Operation::mix;
+	default:
+		return ProcessingGraph::Operation::process;
+	}
+}
+
+// The graph, its workers and its hearing aids are built for the first trial
+// and kept for the rest of the test; each trial only rescales and resets
+// them. Trials are made one at a time, so the previous one is never still
+// playing.
+class ProcessingGraphSimulationFactory : public StereoSimulationFactory {
+	ProcessingGraphSimulation graph;
+	std::vector<std::shared_ptr<SignalProcessor>> scales{};
+	std::shared_ptr<ProcessingGraph> processor{};
 	SimulationChannelFactory *channelFactory;
 	CalibrationComputerFactory *calibrationComputerFactory;
+	RealTimeSetup *realTime;
+	int sampleRate{};
 public:
-	StereoNoSimulation(
+	ProcessingGraphSimulationFactory(
+		ProcessingGraphSimulation graph,
 		SimulationChannelFactory *channelFactory,
-		CalibrationComputerFactory *calibrationComputerFactory
-	) noexcept :
+		CalibrationComputerFactory *calibrationComputerFactory,
+		RealTimeSetup *realTime
+	) :
+		graph{ std::move(graph) },
 		channelFactory{ channelFactory },
-		calibrationComputerFactory{ calibrationComputerFactory } {}
+		calibrationComputerFactory{ calibrationComputerFactory },
+		realTime{ realTime } {}
 
 	std::shared_ptr<AudioFrameProcessor> make(AudioFrameReader *reader, double level_dB_Spl) override {
-		return std::make_shared<ChannelProcessingGroup>(makeChannels(reader, level_dB_Spl));
+		StereoCalibration calibration{ calibrationComputerFactory->make(reader), level_dB_Spl };
+		if (!processor || reader->sampleRate() != sampleRate)
+			build(reader->sampleRate());
+		else
+			processor->reset();
+		for (std::size_t i = 0; i < graph.nodes.size(); ++i)
+			if (scales.at(i))
+				scales.at(i)->setScale(
+					gsl::narrow_cast<float>(calibration.channelScale(graph.nodes.at(i).channel))
+				);
+		return processor;
 	}
 
-	std::vector<ChannelProcessingGroup::channel_processing_type> makeChannels(
-		AudioFrameReader *reader, 
-		double level_dB_Spl
-	) {
-		StereoCalibration stereoCalibration{ calibrationComputerFactory->make(reader), level_dB_Spl };
+	std::shared_ptr<AudioFrameProcessor> makeUnitGain(AudioFrameReader *) override {
+		return {};
+	}
 
-		return { 
-			channelFactory->makeWithoutSimulation(
-				stereoCalibration.leftChannelScale()
-			), 
-			channelFactory->makeWithoutSimulation(
-				stereoCalibration.rightChannelScale()
-			)
-		};
+	std::shared_ptr<AudioFrameProcessor> makeGain(AudioFrameReader *, double) override {
+		return {};
+	}
+
+	std::shared_ptr<StereoSimulationFactory> clone() override {
+		return std::make_shared<ProcessingGraphSimulationFactory>(
+			graph, 
+			channelFactory, 
+			calibrationComputerFactory,
+			nullptr
+		);
+	}
+
+private:
+	void build(int sampleRate_) {
+		sampleRate = sampleRate_;
+		processor = {};
+		scales.clear();
+		std::vector<ProcessingGraph::Node> nodes;
+		for (const auto &node : graph.nodes) {
+			ProcessingGraph::Node graphNode{};
+			graphNode.operation = graphOperation(node.type);
+			graphNode.inputs = node.inputs;
+			graphNode.channel = node.channel;
+			graphNode.processor = makeProcessor(node);
+			scales.push_back(
+				node.type == ProcessingGraphReader::NodeType::scale
+					? graphNode.processor
+					: nullptr
+			);
+			nodes.push_back(std::move(graphNode));
+		}
+		processor = std::make_shared<ProcessingGraph>(
+			std::move(nodes), 
+			graph.chunkSize, 
+			gsl::narrow<int>(std::thread::hardware_concurrency()) - 1,
+			realTime
+		);
+	}
+
+	// The channel factory only builds calibrated chains, so FIR and hearing 
+	// aid nodes are made with unit scale. Scale nodes are set for each trial.
+	std::shared_ptr<SignalProcessor> makeProcessor(const ProcessingGraphSimulation::Node &node) {
+		using NodeType = ProcessingGraphReader::NodeType;
+		switch (node.type) {
+		case NodeType::scale:
+			return channelFactory->makeWithoutSimulation(1);
+		case NodeType::fir: {
+			SimulationChannelFactory::Spatialization spatialization;
+			spatialization.filterCoefficients = node.filterCoefficients;
+			return channelFactory->makeSpatialization(std::move(spatialization), 1);
+		}
+		case NodeType::hearingAid: {
+			SimulationChannelFactory::HearingAidSimulation hearingAid;
+			hearingAid.prescription = node.prescription;
+			hearingAid.attack_ms = graph.attack_ms;
+			hearingAid.release_ms = graph.release_ms;
+			hearingAid.chunkSize = graph.chunkSize;
+			hearingAid.windowSize = graph.windowSize;
+			hearingAid.sampleRate = sampleRate;
+			hearingAid.fullScaleLevel_dB_Spl = SpatialHearingAidModel::fullScaleLevel_dB_Spl;
+			return channelFactory->makeHearingAidSimulation(std::move(hearingAid), 1);
+		}
+		default:
+			return {};
+		}
 	}
 };
 
+// Each simulation it makes serves one test, calibration or save, so the 
+// channels for each get their own arena.
 class StereoProcessorFactoryFactory : public AudioFrameProcessorFactoryFactory {
 	SimulationChannelFactory *channelFactory;
 	CalibrationComputerFactory *calibrationComputerFactory;
+	ProcessingGroupFactory *groupFactory;
+	RealTimeSetup *realTime;
 public:
 	StereoProcessorFactoryFactory(
 		SimulationChannelFactory *channelFactory,
-		CalibrationComputerFactory *calibrationComputerFactory
+		CalibrationComputerFactory *calibrationComputerFactory,
+		ProcessingGroupFactory *groupFactory,
+		RealTimeSetup *realTime
 	) noexcept :
 		channelFactory{ channelFactory },
-		calibrationComputerFactory{ calibrationComputerFactory } {}
+		calibrationComputerFactory{ calibrationComputerFactory },
+		groupFactory{ groupFactory },
+		realTime{ realTime } {}
 
 	std::shared_ptr<StereoSimulationFactory> makeSpatialization(
 		BrirReader::BinauralRoomImpulseResponse hearingAid
 	) override {
+		channelFactory->beginArena();
 		return std::make_shared<StereoSpatializationFactory>(
 			std::move(hearingAid), 
 			channelFactory, 
-			calibrationComputerFactory
+			calibrationComputerFactory,
+			groupFactory,
+			realTime
 		);
 	}
 	
 	std::shared_ptr<StereoSimulationFactory> makeHearingAid(
 		StereoSimulationFactory::HearingAidSimulation hearingAid
 	) override {
+		channelFactory->beginArena();
 		return std::make_shared<StereoHearingAidFactory>(
 			std::move(hearingAid),
 			channelFactory, 
-			calibrationComputerFactory
+			calibrationComputerFactory,
+			groupFactory,
+			realTime
 		);
 	}
 
@@ -249,18 +674,35 @@ public:
 		BrirReader::BinauralRoomImpulseResponse brir, 
 		StereoSimulationFactory::HearingAidSimulation hearingAid
 	) override {
+		channelFactory->beginArena();
 		return std::make_shared<StereoSpatializedHearingAidSimulationFactory>(
 			std::move(brir), 
 			std::move(hearingAid),
 			channelFactory, 
-			calibrationComputerFactory
+			calibrationComputerFactory,
+			groupFactory,
+			realTime
 		);
 	}
 
 	std::shared_ptr<StereoSimulationFactory> makeNoSimulation() override {
+		channelFactory->beginArena();
 		return std::make_shared<StereoNoSimulation>(
 			channelFactory, 
-			calibrationComputerFactory
+			calibrationComputerFactory,
+			realTime
+		);
+	}
+
+	std::shared_ptr<StereoSimulationFactory> makeProcessingGraph(
+		StereoSimulationFactory::ProcessingGraphSimulation graph
+	) override {
+		channelFactory->beginArena();
+		return std::make_shared<ProcessingGraphSimulationFactory>(
+			std::move(graph),
+			channelFactory, 
+			calibrationComputerFactory,
+			realTime
 		);
 	}
 };
@@ -274,17 +716,41 @@ SpatialHearingAidModel::SpatialHearingAidModel(
 	TestDocumenter *documenter,
 	AudioPlayer *player,
 	AudioProcessingLoaderFactory *audioLoaderFactory,
+	AudioProcessingLoaderFactory *offlineLoaderFactory,
 	AudioFrameReaderFactory *audioReaderFactory,
 	AudioFrameWriterFactory *audioWriterFactory,
 	PrescriptionReader *prescriptionReader,
 	BrirReader *brirReader,
+	ProcessingGraphReader *graphReader,
 	SimulationChannelFactory *channelFactory,
-	CalibrationComputerFactory *calibrationComputerFactory
+	CalibrationComputerFactory *calibrationComputerFactory,
+	ProcessingGroupFactory *groupFactory,
+	SignalCache *renderedStimuli,
+	TaskRunner *backgroundTasks,
+	TemporaryFiles *temporaryFiles,
+	RealTimeSetup *realTime,
+	StimulusCache *stimulusCache,
+	FileVersions *fileVersions,
+	TaskRunner *preloadTasks
 ) :
+	measuredStimuli{ std::make_shared<MeasuredStimuli>(calibrationComputerFactory) },
+	parameterSweep{
+		std::make_shared<ParameterSweep>(
+			audioReaderFactory,
+			audioWriterFactory,
+			brirReader,
+			prescriptionReader,
+			channelFactory,
+			calibrationComputerFactory,
+			renderedStimuli
+		)
+	},
     processorFactoryFactory{
         std::make_shared<StereoProcessorFactoryFactory>(
             channelFactory,
-            calibrationComputerFactory
+            measuredStimuli.get(),
+            groupFactory,
+            realTime
         )
     },
     processorFactoryForTest{
@@ -294,22 +760,97 @@ SpatialHearingAidModel::SpatialHearingAidModel(
 	documenter{ documenter },
 	prescriptionReader{ prescriptionReader },
 	brirReader{ brirReader },
+	graphReader{ graphReader },
 	audioReaderFactory{ audioReaderFactory },
 	audioWriterFactory{ audioWriterFactory },
     player{ player },
-    audioProcessingLoaderFactory{ audioLoaderFactory }
+    audioProcessingLoaderFactory{ audioLoaderFactory },
+    offlineLoaderFactory{ offlineLoaderFactory },
+	renderedStimuli{ renderedStimuli },
+	backgroundTasks{ backgroundTasks },
+	temporaryFiles{ temporaryFiles },
+	stimulusCache{ stimulusCache },
+	fileVersions{ fileVersions },
+	preloadTasks{ preloadTasks }
 {
 }
 
+// Pre-rendering tasks refer to this model.
+SpatialHearingAidModel::~SpatialHearingAidModel() noexcept {
+	backgroundTasks->await();
+	if (!savingFilePath.empty())
+		temporaryFiles->remove(savingFilePath);
+}
+
 void SpatialHearingAidModel::prepareNewTest(const Testing &p) {
+	backgroundTasks->await();
+	measuredStimuli->clear();
 	framesPerBufferForTest = framesPerBuffer(p.processing);
 	processorFactoryForTest = makeProcessorFactory(p.processing);
+	preRenderingFactoryForTest = processorFactoryForTest->clone();
+	renderingKeyForTest = renderingKey(p.processing, framesPerBufferForTest);
+	processingKeyForTest = processingKey(p.processing);
 	prepareNewTest_(p);
+	preRenderNextTrial(false, 0);
+}
+
+// Only spatialization renders stimuli ahead of time; without simulation
+// a trial already costs no more than the gain applied to the rendering.
+std::string SpatialHearingAidModel::renderingKey(
+	const SignalProcessing &p, 
+	int framesPerBuffer_
+) {
+	if (p.usingProcessingGraph || p.usingHearingAidSimulation || !p.usingSpatialization)
+		return {};
+	return versioned(p.brirFilePath) + "\n" + std::to_string(framesPerBuffer_);
+}
+
+// A nonlinear simulation's output depends on all of its settings and on the
+// level, so its renderings are keyed by them; settings the mode does not 
+// use are left out. Linear simulations reuse unit gain renderings instead.
+std::string SpatialHearingAidModel::processingKey(const SignalProcessing &p) {
+	if (!p.usingProcessingGraph && !p.usingHearingAidSimulation)
+		return {};
+	auto key = p.usingProcessingGraph
+		? "graph\n" + versioned(p.processingGraphFilePath)
+		: "hearing aid\n" + 
+			versioned(p.leftDslPrescriptionFilePath) + "\n" + 
+			versioned(p.rightDslPrescriptionFilePath) + "\n" + 
+			(p.usingSpatialization ? versioned(p.brirFilePath) : std::string{});
+	return key + "\n" +
+		std::to_string(p.attack_ms) + "\n" +
+		std::to_string(p.release_ms) + "\n" +
+		std::to_string(p.windowSize) + "\n" +
+		std::to_string(p.chunkSize);
+}
+
+// The stimulus's length and sample rate also guard against a stimulus 
+// without a version of its own, such as one read from a bank; the sample 
+// rate also configures the simulation.
+std::string SpatialHearingAidModel::processedKey(
+	const std::string &processingKey_,
+	double level_dB_Spl,
+	const std::string &stimulus,
+	AudioFrameReader &reader
+) {
+	return processingKey_ + "\n" + 
+		std::to_string(level_dB_Spl) + "\n" + 
+		versioned(stimulus) + "\n" + 
+		std::to_string(reader.frames()) + "\n" + 
+		std::to_string(reader.sampleRate());
+}
+
+// Files are keyed by their version as well as their path, so one replaced
+// under the same path is processed again.
+std::string SpatialHearingAidModel::versioned(const std::string &filePath) {
+	return fileVersions 
+		? filePath + "\n" + fileVersions->version(filePath) 
+		: filePath;
 }
 
 int SpatialHearingAidModel::framesPerBuffer(const SignalProcessing &p) {
 	return 
-		p.usingHearingAidSimulation
+		p.usingHearingAidSimulation || p.usingProcessingGraph
 		? p.chunkSize
 		: defaultFramesPerBuffer;
 }
@@ -317,7 +858,9 @@ int SpatialHearingAidModel::framesPerBuffer(const SignalProcessing &p) {
 std::shared_ptr<StereoSimulationFactory> SpatialHearingAidModel::makeProcessorFactory(
 	const SignalProcessing &p
 ) {
-	if (p.usingHearingAidSimulation && p.usingSpatialization)
+	if (p.usingProcessingGraph)
+		return processorFactoryFactory->makeProcessingGraph(processingGraphSimulation(p));
+	else if (p.usingHearingAidSimulation && p.usingSpatialization)
 		return processorFactoryFactory->makeFullSimulation(
 			readAndCheckBrir(std::move(p.brirFilePath)),
 			hearingAidSimulation(p)
@@ -347,6 +890,65 @@ StereoSimulationFactory::HearingAidSimulation
 	return simulation;
 }
 
+StereoSimulationFactory::ProcessingGraphSimulation 
+	SpatialHearingAidModel::processingGraphSimulation(const SignalProcessing &p) 
+{
+	auto description = readProcessingGraph(p.processingGraphFilePath);
+	std::vector<ProcessingGraph::Node> topology;
+	for (const auto &node : description) {
+		ProcessingGraph::Node graphNode{};
+		graphNode.operation = graphOperation(node.type);
+		graphNode.inputs = node.inputs;
+		graphNode.channel = node.channel;
+		topology.push_back(std::move(graphNode));
+	}
+	try {
+		ProcessingGraph::topologicalOrder(topology);
+	}
+	catch (const ProcessingGraph::InvalidTopology &e) {
+		throw RequestFailure{ 
+			"Processing graph '" + p.processingGraphFilePath + "' is invalid: " + e.what() 
+		};
+	}
+
+	StereoSimulationFactory::ProcessingGraphSimulation simulation;
+	simulation.attack_ms = p.attack_ms;
+	simulation.release_ms = p.release_ms;
+	simulation.chunkSize = p.chunkSize;
+	simulation.windowSize = p.windowSize;
+	using NodeType = ProcessingGraphReader::NodeType;
+	for (auto &node : description) {
+		StereoSimulationFactory::ProcessingGraphSimulation::Node simulated{};
+		simulated.type = node.type;
+		simulated.inputs = std::move(node.inputs);
+		simulated.channel = node.channel;
+		if (node.type == NodeType::fir) {
+			auto brir = readAndCheckBrir(node.filePath);
+			simulated.filterCoefficients = node.channel == 0 
+				? std::move(brir.left) 
+				: std::move(brir.right);
+		}
+		if (node.type == NodeType::hearingAid) {
+			assertSizeIsPowerOfTwo(p.chunkSize);
+			assertSizeIsPowerOfTwo(p.windowSize);
+			simulated.prescription = readPrescription(node.filePath);
+		}
+		simulation.nodes.push_back(std::move(simulated));
+	}
+	return simulation;
+}
+
+std::vector<ProcessingGraphReader::Node> SpatialHearingAidModel::readProcessingGraph(
+	std::string filePath
+) {
+	try {
+		return graphReader->read(filePath);
+	}
+	catch (const ProcessingGraphReader::ReadFailure &) {
+		throw RequestFailure{ "Processing graph '" + filePath + "' cannot be read." };
+	}
+}
+
 static std::string coefficientErrorMessage(std::string which) {
 	return 
 		"The " + which + " BRIR coefficients are empty, "
@@ -400,6 +1002,8 @@ void SpatialHearingAidModel::prepareNewTest_(const Testing &p) {
 		stimulusList->initialize(p.audioDirectory);
 		documenter->initialize(p.testFilePath);
 		documenter->documentTestParameters(p);
+		if (stimulusCache && preloadTasks)
+			preload(stimulusList->remaining(), p.stimuliLoaded);
 		nextStimulus_ = stimulusList->next();
 	}
 	catch (const TestDocumenter::InitializationFailure &) {
@@ -410,26 +1014,123 @@ void SpatialHearingAidModel::prepareNewTest_(const Testing &p) {
 	}
 }
 
+// Stimuli load in the background alongside pre-rendering, so a new test 
+// starts without waiting on them and a trial whose stimulus is not loaded 
+// yet reads it itself. That none are loaded yet is reported first. The 
+// task refers only to the cache and the view, not to this model.
+void SpatialHearingAidModel::preload(
+	std::vector<std::string> filePaths,
+	std::function<void(int, int)> progress
+) {
+	if (progress)
+		progress(0, gsl::narrow<int>(filePaths.size()));
+	preloadTasks->run([cache = stimulusCache, filePaths, progress]() { 
+		cache->preload(filePaths, progress); 
+	});
+}
+
 void SpatialHearingAidModel::playNextTrial(const Trial &p) {
 	if (player->isPlaying())
 		return;
 
+	backgroundTasks->await();
 	PlayAudioRequest request;
 	request.audioFilePath = nextStimulus_;
 	request.audioDevice = std::move(p.audioDevice);
 	request.level_dB_Spl = p.level_dB_Spl;
+	request.renderingKey = renderingKeyForTest;
+	request.processingKey = processingKeyForTest;
 	request.framesPerBuffer = framesPerBufferForTest;
 	request.processorFactory = processorFactoryForTest.get();
+	const auto preRendered = takePreRenderedNextTrial();
+	request.preRendered = preRendered.get();
+	request.calibrating = false;
 	playAudio(request);
+	calibrationProcessor = {};
 	TestDocumenter::TrialParameters trial;
 	trial.level_dB_Spl = p.level_dB_Spl;
 	trial.stimulus = nextStimulus_;
 	documenter->documentTrialParameters(std::move(trial));
 	nextStimulus_ = stimulusList->next();
+	preRenderNextTrial(!processingKeyForTest.empty(), p.level_dB_Spl);
+}
+
+// A pre-rendered reader is used up by playing it, so it is handed out once.
+auto SpatialHearingAidModel::takePreRenderedNextTrial() 
+	-> std::shared_ptr<const PreRenderedTrial> 
+{
+	auto trial = std::move(nextTrial);
+	nextTrial = {};
+	if (trial && trial->complete && trial->stimulus == nextStimulus_)
+		return trial;
+	return {};
+}
+
+// While the listener responds, the next stimulus is read and, when that 
+// does not depend on the level, rendered. A nonlinear simulation is 
+// rendered at the level just played in the hope the next is the same; a 
+// trial at another level plays the stimulus already read and processes it
+// live as before. Either way it is measured here, so live processing need
+// not decode all of it before playing. A stimulus that cannot be read or
+// rendered, or whose rendering cannot be kept, fails its trial without
+// being tried again.
+void SpatialHearingAidModel::preRenderNextTrial(bool speculative, double level_dB_Spl) {
+	nextTrial = std::make_shared<PreRenderedTrial>();
+	if (nextStimulus_.empty())
+		return;
+
+	nextTrial->stimulus = nextStimulus_;
+	MakeAudioLoader loading;
+	if (!renderingKeyForTest.empty())
+		loading.renderingKey = renderingKeyForTest + "\n" + versioned(nextStimulus_);
+	loading.level_dB_Spl = level_dB_Spl;
+	loading.loaderFactory = offlineLoaderFactory;
+	loading.framesPerBuffer = framesPerBufferForTest;
+	backgroundTasks->run([
+		=, 
+		trial = nextTrial, 
+		factory = preRenderingFactoryForTest
+	]() mutable {
+		try {
+			loading.reader = makeReader(trial->stimulus);
+		}
+		catch (const RequestFailure &e) {
+			trial->readFailure = e.what();
+			trial->complete = true;
+			return;
+		}
+		try {
+			loading.processorFactory = factory.get();
+			if (!loading.renderingKey.empty())
+				renderAtUnitGain(loading);
+			else if (speculative)
+				renderProcessed(
+					processedKey(
+						processingKeyForTest, 
+						level_dB_Spl, 
+						trial->stimulus, 
+						*loading.reader
+					),
+					loading
+				);
+			else
+				measuredStimuli->make(loading.reader.get());
+		}
+		catch (const std::exception &e) {
+			trial->readFailure = e.what();
+		}
+		loading.reader->reset();
+		trial->reader = std::move(loading.reader);
+		trial->complete = true;
+	});
 }
 
 void SpatialHearingAidModel::playAudio(const PlayAudioRequest &p) {
-	auto reader = makeReader(p.audioFilePath);
+	if (p.preRendered && !p.preRendered->readFailure.empty())
+		throw RequestFailure{ p.preRendered->readFailure };
+	auto reader = p.preRendered 
+		? p.preRendered->reader 
+		: makeReader(p.audioFilePath);
 
 	AudioPlayer::Preparation preparation;
 	preparation.channels = reader->channels();
@@ -438,25 +1139,239 @@ void SpatialHearingAidModel::playAudio(const PlayAudioRequest &p) {
 	preparation.audioDevice = std::move(p.audioDevice);
 	prepareAudioPlayer(preparation);
 
+	auto processed = p.processingKey.empty()
+		? nullptr
+		: findProcessed(processedKey(p.processingKey, p.level_dB_Spl, p.audioFilePath, *reader));
+	const auto sampleRate = reader->sampleRate();
 	MakeAudioLoader makingLoader;
+	if (!p.renderingKey.empty())
+		makingLoader.renderingKey = p.renderingKey + "\n" + versioned(p.audioFilePath);
 	makingLoader.level_dB_Spl = p.level_dB_Spl;
 	makingLoader.reader = std::move(reader);
 	makingLoader.processorFactory = p.processorFactory;
-	player->setAudioLoader(makeLoader(makingLoader));
+	makingLoader.loaderFactory = audioProcessingLoaderFactory;
+	makingLoader.framesPerBuffer = p.framesPerBuffer;
+	std::shared_ptr<AudioLoader> loader;
+	if (processed)
+		loader = makeProcessedLoader(std::move(processed), sampleRate);
+	else if (p.calibrating)
+		loader = makeCalibrationLoader(makingLoader);
+	else
+		loader = makeLoader(makingLoader);
+	try {
+		player->setAudioLoader(std::move(loader));
+	}
+	catch (const AudioFrameReader::ReadFailure &) {
+		throw RequestFailure{ "Audio file '" + p.audioFilePath + "' cannot be read." };
+	}
 
 	player->play();
 }
 
 std::shared_ptr<AudioLoader> SpatialHearingAidModel::makeLoader(const MakeAudioLoader &p) {
-	return audioProcessingLoaderFactory->make(
+	if (!p.renderingKey.empty())
+		return makeRenderedLoader(p);
+	return p.loaderFactory->make(
 		p.reader, 
 		p.processorFactory->make(p.reader.get(), p.level_dB_Spl)
 	);
 }
 
+std::shared_ptr<AudioLoader> SpatialHearingAidModel::makeProcessedLoader(
+	std::shared_ptr<const SignalCache::channels_type> processed,
+	int sampleRate
+) {
+	return audioProcessingLoaderFactory->make(
+		std::make_shared<CachedSignalReader>(std::move(processed), sampleRate),
+		std::make_shared<AlreadyProcessed>()
+	);
+}
+
+std::shared_ptr<AudioLoader> SpatialHearingAidModel::makeCalibrationLoader(
+	const MakeAudioLoader &p
+) {
+	auto chain = p.processorFactory->make(p.reader.get(), p.level_dB_Spl);
+	calibrationChainGroupDelay = chain->groupDelay();
+	calibrationProcessor = std::make_shared<LiveProcessor>(std::move(chain));
+	return p.loaderFactory->make(p.reader, calibrationProcessor);
+}
+
+// A linear simulation renders each stimulus once at unit gain, so replaying
+// it at another level costs a single gain instead of another convolution.
+std::shared_ptr<AudioLoader> SpatialHearingAidModel::makeRenderedLoader(const MakeAudioLoader &p) {
+	auto gain = p.processorFactory->makeGain(p.reader.get(), p.level_dB_Spl);
+	return p.loaderFactory->make(
+		std::make_shared<CachedSignalReader>(renderAtUnitGain(p), p.reader->sampleRate()),
+		std::move(gain)
+	);
+}
+
+auto SpatialHearingAidModel::renderAtUnitGain(const MakeAudioLoader &p) 
+	-> std::shared_ptr<const SignalCache::channels_type> 
+{
+	try {
+		if (auto rendered = renderedStimuli->find(p.renderingKey))
+			return rendered;
+		auto unitGain = offlineLoaderFactory->make(
+			p.reader, 
+			p.processorFactory->makeUnitGain(p.reader.get())
+		);
+		return renderedStimuli->insert(
+			p.renderingKey, 
+			render(*unitGain, p.reader->channels(), p.framesPerBuffer)
+		);
+	}
+	catch (const SignalStore::StoreFailure &e) {
+		throw RequestFailure{ e.what() };
+	}
+}
+
+auto SpatialHearingAidModel::renderProcessed(
+	const std::string &key, 
+	const MakeAudioLoader &p
+) -> std::shared_ptr<const SignalCache::channels_type> {
+	try {
+		if (auto processed = renderedStimuli->find(key))
+			return processed;
+		auto loader = makeLoader(p);
+		return renderedStimuli->insert(
+			key, 
+			render(*loader, p.reader->channels(), p.framesPerBuffer)
+		);
+	}
+	catch (const SignalStore::StoreFailure &e) {
+		throw RequestFailure{ e.what() };
+	}
+}
+
+auto SpatialHearingAidModel::findProcessed(const std::string &key) 
+	-> std::shared_ptr<const SignalCache::channels_type> 
+{
+	try {
+		return renderedStimuli->find(key);
+	}
+	catch (const SignalStore::StoreFailure &e) {
+		throw RequestFailure{ e.what() };
+	}
+}
+
+// Loads into the same buffers until the loader completes, handing each 
+// block to the callable before loading the next.
+template<typename F>
+static void forEachBlock(AudioLoader &loader, int channels, int framesPerBuffer_, F f) {
+	using channel_type = AudioLoader::channel_type;
+	std::vector<std::vector<channel_type::element_type>> buffers(channels);
+	std::vector<channel_type> adapted;
+	for (auto &buffer : buffers) {
+		buffer.resize(framesPerBuffer_);
+		adapted.push_back({ buffer });
+	}
+	while (!loader.complete()) {
+		loader.load(adapted);
+		f(adapted);
+	}
+}
+
+static void append(
+	SignalCache::channels_type &rendered, 
+	const std::vector<AudioLoader::channel_type> &block
+) {
+	for (std::size_t i = 0; i < rendered.size(); ++i)
+		rendered.at(i).insert(
+			rendered.at(i).end(), 
+			block.at(i).begin(), 
+			block.at(i).end()
+		);
+}
+
+SignalCache::channels_type SpatialHearingAidModel::render(
+	AudioLoader &loader, 
+	int channels, 
+	int framesPerBuffer_
+) {
+	SignalCache::channels_type rendered(channels);
+	forEachBlock(
+		loader, 
+		channels, 
+		framesPerBuffer_, 
+		[&](std::vector<AudioLoader::channel_type> &block) { append(rendered, block); }
+	);
+	return rendered;
+}
+
+// Writes a rendering already held in memory one block at a time, so the
+// writer never needs room for all of it at once.
+static void writeInBlocks(
+	const SignalCache::channels_type &rendered,
+	AudioFrameWriter &writer,
+	int framesPerBuffer_
+) {
+	using channel_type = AudioFrameWriter::channel_type;
+	using size_type = std::vector<channel_type::element_type>::size_type;
+	std::vector<std::vector<channel_type::element_type>> buffers(rendered.size());
+	std::vector<channel_type> adapted(rendered.size());
+	const auto frames = rendered.empty() ? size_type{ 0 } : rendered.front().size();
+	const auto blockSize = gsl::narrow<size_type>(framesPerBuffer_);
+	for (size_type offset{ 0 }; offset < frames; offset += blockSize) {
+		const auto size = std::min(blockSize, frames - offset);
+		for (size_type i{ 0 }; i < rendered.size(); ++i) {
+			const auto first = rendered.at(i).begin() + gsl::narrow<std::ptrdiff_t>(offset);
+			buffers.at(i).assign(first, first + gsl::narrow<std::ptrdiff_t>(size));
+			adapted.at(i) = buffers.at(i);
+		}
+		writer.write(adapted);
+	}
+}
+
+// A rendering already made is written from the cache. Otherwise each block
+// is written as soon as it is rendered, and the rendering is only kept for
+// next time while it fits in the cache's memory.
+void SpatialHearingAidModel::writeProcessed(
+	const std::string &key,
+	const MakeAudioLoader &p,
+	AudioFrameWriter &writer
+) {
+	if (const auto processed = findProcessed(key)) {
+		writeInBlocks(*processed, writer, p.framesPerBuffer);
+		return;
+	}
+	const auto channels = p.reader->channels();
+	SignalCache::channels_type rendered(channels);
+	std::size_t bytes{ 0 };
+	bool keeping{ true };
+	auto loader = makeLoader(p);
+	forEachBlock(
+		*loader, 
+		channels, 
+		p.framesPerBuffer, 
+		[&](std::vector<AudioLoader::channel_type> &block) { 
+			writer.write(block);
+			if (!keeping)
+				return;
+			for (const auto &channel : block)
+				bytes += gsl::narrow<std::size_t>(channel.size()) * sizeof(float);
+			keeping = renderedStimuli->fits(bytes);
+			if (keeping)
+				append(rendered, block);
+			else
+				SignalCache::channels_type{}.swap(rendered);
+		}
+	);
+	if (!keeping)
+		return;
+	try {
+		renderedStimuli->insert(key, std::move(rendered));
+	}
+	catch (const SignalStore::StoreFailure &e) {
+		throw RequestFailure{ e.what() };
+	}
+}
+
 std::shared_ptr<AudioFrameReader> SpatialHearingAidModel::makeReader(std::string filePath) {
 	try {
-		return audioReaderFactory->make(filePath);
+		auto reader = audioReaderFactory->make(filePath);
+		measuredStimuli->track(reader, filePath);
+		return reader;
 	}
 	catch (const AudioFrameReaderFactory::CreateError &) {
 		throw RequestFailure{ "Audio file '" + filePath + "' cannot be read." };
@@ -473,23 +1388,100 @@ void SpatialHearingAidModel::prepareAudioPlayer(const AudioPlayer::Preparation &
 }
 
 void SpatialHearingAidModel::playCalibration(const Calibration &p) {
-	if (player->isPlaying())
-		return;
+	if (!player->isPlaying())
+		startCalibration(p);
+	else if (calibrationProcessor)
+		updateCalibration(p);
+}
 
+void SpatialHearingAidModel::startCalibration(const Calibration &p) {
+	backgroundTasks->await();
 	const auto framesPerBuffer_ = framesPerBuffer(p.processing);
 	auto processorFactory_ = makeProcessorFactory(p.processing);
 
 	PlayAudioRequest request;
-	request.audioFilePath = std::move(p.audioFilePath);
-	request.audioDevice = std::move(p.audioDevice);
+	request.audioFilePath = p.audioFilePath;
+	request.audioDevice = p.audioDevice;
 	request.level_dB_Spl = p.level_dB_Spl;
 	request.framesPerBuffer = framesPerBuffer_;
 	request.processorFactory = processorFactory_.get();
+	request.preRendered = nullptr;
+	request.calibrating = true;
 	playAudio(request);
+	calibrationFactory = std::move(processorFactory_);
+	calibrationPlaying = p;
+	calibrationChainLevel_dB_Spl = p.level_dB_Spl;
+}
+
+// While calibration plays, playing it again applies the new level or 
+// processing without stopping the stream. Changing what the stream itself
+// depends on (the audio file, device or block size) restarts it instead.
+void SpatialHearingAidModel::updateCalibration(const Calibration &p) {
+	calibrationProcessor->reclaim();
+	if (updateCalibrationLive(p))
+		return;
+	player->stop();
+	startCalibration(p);
+}
+
+// A chain's first block is the one that touches everything it will use,
+// so a replacement runs once over silence here and is returned to its 
+// initial state before the callback ever sees it.
+static void prime(AudioFrameProcessor &chain, int channels, int framesPerBuffer) {
+	std::vector<std::vector<AudioFrameProcessor::channel_type::element_type>> silence(
+		gsl::narrow<std::size_t>(channels),
+		std::vector<AudioFrameProcessor::channel_type::element_type>(
+			gsl::narrow<std::size_t>(framesPerBuffer)
+		)
+	);
+	std::vector<AudioFrameProcessor::channel_type> adapted;
+	for (auto &channel : silence)
+		adapted.push_back({ channel });
+	chain.process(adapted);
+	chain.reset();
+}
+
+// A linear simulation changes level with a smoothed gain; anything else 
+// is built anew here and swapped in whole. The loader pads the stream's end
+// for the delay of the chain it started with, so a replacement delaying the
+// signal by any other amount restarts the stream instead.
+bool SpatialHearingAidModel::updateCalibrationLive(const Calibration &p) {
+	if (p.audioFilePath != calibrationPlaying.audioFilePath ||
+		p.audioDevice != calibrationPlaying.audioDevice ||
+		framesPerBuffer(p.processing) != framesPerBuffer(calibrationPlaying.processing)
+	)
+		return false;
+
+	if (equal(p.processing, calibrationPlaying.processing) &&
+		!p.processing.usingHearingAidSimulation &&
+		!p.processing.usingProcessingGraph
+	) {
+		const auto gain = std::pow(10.0, (p.level_dB_Spl - calibrationChainLevel_dB_Spl) / 20);
+		if (!calibrationProcessor->setGain(gsl::narrow_cast<float>(gain)))
+			return false;
+		calibrationPlaying = p;
+		return true;
+	}
+
+	backgroundTasks->await();
+	auto processorFactory_ = makeProcessorFactory(p.processing);
+	auto reader = makeReader(p.audioFilePath);
+	auto chain = processorFactory_->make(reader.get(), p.level_dB_Spl);
+	if (chain->groupDelay() != calibrationChainGroupDelay)
+		return false;
+	prime(*chain, reader->channels(), framesPerBuffer(p.processing));
+	if (!calibrationProcessor->replace(std::move(chain)))
+		return false;
+	calibrationFactory = std::move(processorFactory_);
+	calibrationPlaying = p;
+	calibrationChainLevel_dB_Spl = p.level_dB_Spl;
+	return true;
 }
 
 void SpatialHearingAidModel::stopCalibration() {
 	player->stop();
+	if (calibrationProcessor)
+		calibrationProcessor->reclaim();
 }
 
 /*
@@ -502,51 +1494,117 @@ void SpatialHearingAidModel::processAudioForSavingDirectory(const SavingAudio &p
 }
 */
 
+// Each block is written as soon as it is rendered, so however long the 
+// audio is, saving holds no more of it in memory than the cache allows.
 void SpatialHearingAidModel::processAudioForSaving(const SavingAudio &p) {
+	backgroundTasks->await();
+	processedForSaving = false;
 	auto reader = makeReader(p.inputAudioFilePath);
-    formatToWrite_.channels = reader->channels();
-    formatToWrite_.sampleRate = reader->sampleRate();
-	auto processorFactory_ = makeProcessorFactory(p.processing);
+	// Saving renders off the device's callback, like pre-rendering.
+	auto processorFactory_ = makeProcessorFactory(p.processing)->clone();
+	const auto framesPerBuffer_ = framesPerBuffer(p.processing);
 	MakeAudioLoader loading;
 	loading.level_dB_Spl = p.level_dB_Spl;
 	loading.reader = reader;
 	loading.processorFactory = processorFactory_.get();
-	auto loader_ = makeLoader(loading);
-	const auto framesPerBuffer_ = framesPerBuffer(p.processing);
-	using channel_type = AudioLoader::channel_type;
-	std::vector<std::vector<channel_type::element_type>> channels(reader->channels());
-	std::vector<channel_type> adapted;
-	for (auto &channel : channels) {
-		channel.resize(framesPerBuffer_);
-		adapted.push_back({ channel });
-	}
-	toWrite_.resize(reader->channels());
-	for (auto &channel : toWrite_)
-		channel.clear();
-
-	while (!loader_->complete()) {
-		loader_->load(adapted);
-		for (int i = 0; i < reader->channels(); ++i)
-			toWrite_.at(i).insert(
-				toWrite_.at(i).end(), 
-				channels.at(i).begin(), 
-				channels.at(i).end()
-			);
+	loading.loaderFactory = offlineLoaderFactory;
+	loading.framesPerBuffer = framesPerBuffer_;
+	if (savingFilePath.empty())
+		savingFilePath = temporaryFiles->make();
+	AudioFrameWriter::AudioFormat format;
+	format.channels = reader->channels();
+	format.sampleRate = reader->sampleRate();
+	auto writer_ = makeWriter(savingFilePath, format);
+	const auto processingKey_ = processingKey(p.processing);
+	if (processingKey_.empty()) {
+		auto loader_ = makeLoader(loading);
+		forEachBlock(
+			*loader_, 
+			reader->channels(), 
+			framesPerBuffer_, 
+			[&](std::vector<AudioLoader::channel_type> &block) { writer_->write(block); }
+		);
 	}
+	else
+		writeProcessed(
+			processedKey(processingKey_, p.level_dB_Spl, p.inputAudioFilePath, *reader),
+			loading,
+			*writer_
+		);
+	processedForSaving = true;
 }
 
 void SpatialHearingAidModel::saveAudio(std::string filePath) {
-	auto writer_ = makeWriter(std::move(filePath));
-	using channel_type = AudioFrameWriter::channel_type;
-	std::vector<channel_type> adapted;
-	for (auto &channel : toWrite_)
-		adapted.push_back({ channel });
-	writer_->write(adapted);
+	if (!processedForSaving)
+		throw RequestFailure{ "No audio has been processed for saving." };
+	try {
+		temporaryFiles->copy(savingFilePath, filePath);
+	}
+	catch (const TemporaryFiles::CopyFailure &) {
+		throw RequestFailure{ "Audio file '" + filePath + "' cannot be written." };
+	}
+}
+
+static std::string fileStem(const std::string &filePath) {
+	const auto separator = filePath.find_last_of("/\\");
+	auto name = separator == std::string::npos 
+		? filePath 
+		: filePath.substr(separator + 1);
+	return name.substr(0, name.find_last_of('.'));
 }
 
-std::shared_ptr<AudioFrameWriter> SpatialHearingAidModel::makeWriter(std::string filePath) {
+static std::string sweepFilePath(
+	const Model::ParameterSweeping &p, 
+	double attack_ms, 
+	double release_ms
+) {
+	std::ostringstream stream;
+	stream << 
+		p.outputDirectory << '/' << fileStem(p.inputAudioFilePath) << 
+		"_attack_" << attack_ms << "_release_" << release_ms << ".wav";
+	return stream.str();
+}
+
+// The sweep varies only the hearing aid's time constants, so there is 
+// nothing to sweep through without the fixed hearing aid chain.
+void SpatialHearingAidModel::sweepParameters(const ParameterSweeping &p) {
+	if (!p.processing.usingHearingAidSimulation || p.processing.usingProcessingGraph)
+		throw RequestFailure{ "Sweeping parameters needs the hearing aid simulation." };
+	assertSizeIsPowerOfTwo(p.processing.chunkSize);
+	assertSizeIsPowerOfTwo(p.processing.windowSize);
+	backgroundTasks->await();
+	ParameterSweep::Sweep sweep;
+	sweep.audioFilePath = p.inputAudioFilePath;
+	sweep.brirFilePath = p.processing.brirFilePath;
+	sweep.leftDslPrescriptionFilePath = p.processing.leftDslPrescriptionFilePath;
+	sweep.rightDslPrescriptionFilePath = p.processing.rightDslPrescriptionFilePath;
+	sweep.level_dB_Spl = p.level_dB_Spl;
+	sweep.framesPerBuffer = framesPerBuffer(p.processing);
+	sweep.usingSpatialization = p.processing.usingSpatialization;
+	for (auto attack_ms : p.attack_ms)
+		for (auto release_ms : p.release_ms) {
+			ParameterSweep::Point point;
+			point.outputFilePath = sweepFilePath(p, attack_ms, release_ms);
+			point.attack_ms = attack_ms;
+			point.release_ms = release_ms;
+			point.windowSize = p.processing.windowSize;
+			point.chunkSize = p.processing.chunkSize;
+			sweep.points.push_back(std::move(point));
+		}
+	try {
+		parameterSweep->run(sweep);
+	}
+	catch (const ParameterSweep::SweepFailure &e) {
+		throw RequestFailure{ e.what() };
+	}
+}
+
+std::shared_ptr<AudioFrameWriter> SpatialHearingAidModel::makeWriter(
+	std::string filePath,
+	const AudioFrameWriter::AudioFormat &format
+) {
 	try {
-		return audioWriterFactory->make(filePath, formatToWrite_);
+		return audioWriterFactory->make(filePath, format);
 	}
 	catch (const AudioFrameWriterFactory::CreateError &) {
 		throw RequestFailure{ "Audio file '" + filePath + "' cannot be written." };
@@ -4,11 +4,21 @@
 #include "SimulationChannelFactory.h"
 #include "PrescriptionReader.h"
 #include "BrirReader.h"
+#include "ProcessingGraphReader.h"
 #include "AudioFrameReader.h"
 #include "AudioFrameWriter.h"
 #include "AudioProcessingLoader.h"
 #include "CalibrationComputer.h"
+#include "FileVersions.h"
+#include "LiveProcessor.h"
+#include "ParameterSweep.h"
+#include "ProcessingGroup.h"
+#include "RealTimeSetup.h"
+#include "SignalCache.h"
+#include "StimulusCache.h"
 #include "StimulusList.h"
+#include "TaskRunner.h"
+#include "TemporaryFiles.h"
 #include "TestDocumenter.h"
 #include "spatialized-hearing-aid-simulation-exports.h"
 #include <presentation/Model.h>
@@ -27,10 +37,40 @@ public:
 		int windowSize;
 		int chunkSize;
 	};
+
+	struct ProcessingGraphSimulation {
+		struct Node {
+			std::vector<int> inputs;
+			BrirReader::impulse_response_type filterCoefficients;
+			PrescriptionReader::Dsl prescription;
+			ProcessingGraphReader::NodeType type;
+			int channel;
+		};
+		std::vector<Node> nodes;
+		double attack_ms;
+		double release_ms;
+		int windowSize;
+		int chunkSize;
+	};
+
 	virtual std::shared_ptr<AudioFrameProcessor> make(
 		AudioFrameReader *reader,
 		double level_dB_Spl
 	) = 0;
+
+	// A linear, time-invariant simulation equals its unit gain rendering
+	// followed by a calibrated gain. The others return null from both.
+	virtual std::shared_ptr<AudioFrameProcessor> makeUnitGain(AudioFrameReader *) = 0;
+	virtual std::shared_ptr<AudioFrameProcessor> makeGain(
+		AudioFrameReader *reader,
+		double level_dB_Spl
+	) = 0;
+
+	// The same simulation with channels of its own, so it can make 
+	// processors while those made here are still in use. Its processors
+	// render off the device's callback, so their workers are left as they
+	// are rather than set up for real time.
+	virtual std::shared_ptr<StereoSimulationFactory> clone() = 0;
 };
 
 class AudioFrameProcessorFactoryFactory {
@@ -50,42 +90,91 @@ public:
 	) = 0;
 
 	virtual std::shared_ptr<StereoSimulationFactory> makeNoSimulation() = 0;
+
+	virtual std::shared_ptr<StereoSimulationFactory> makeProcessingGraph(
+		StereoSimulationFactory::ProcessingGraphSimulation
+	) = 0;
 };
 
+class MeasuredStimuli;
+
 class SpatialHearingAidModel : public Model {
-	std::vector<std::vector<AudioFrameWriter::channel_type::element_type>> toWrite_{};
-    AudioFrameWriter::AudioFormat formatToWrite_{};
+	std::shared_ptr<MeasuredStimuli> measuredStimuli;
+	std::shared_ptr<ParameterSweep> parameterSweep;
+	// Processed audio is written here as it is rendered and copied to
+	// wherever it is saved.
+	std::string savingFilePath{};
+	bool processedForSaving{};
 	std::string nextStimulus_{};
 	std::shared_ptr<AudioFrameProcessorFactoryFactory> processorFactoryFactory;
 	std::shared_ptr<StereoSimulationFactory> processorFactoryForTest;
+	std::shared_ptr<StereoSimulationFactory> preRenderingFactoryForTest;
 	StimulusList *stimulusList;
 	TestDocumenter *documenter;
 	PrescriptionReader* prescriptionReader;
 	BrirReader *brirReader;
+	ProcessingGraphReader *graphReader;
 	AudioFrameReaderFactory *audioReaderFactory;
 	AudioFrameWriterFactory *audioWriterFactory;
 	AudioPlayer *player;
 	AudioProcessingLoaderFactory *audioProcessingLoaderFactory;
+	AudioProcessingLoaderFactory *offlineLoaderFactory;
+	SignalCache *renderedStimuli;
+	TaskRunner *backgroundTasks;
+	TemporaryFiles *temporaryFiles;
+	StimulusCache *stimulusCache;
+	FileVersions *fileVersions;
+	// Preloading can take as long as decoding every stimulus, so it runs
+	// apart from the tasks that calibration, saving and trials await.
+	TaskRunner *preloadTasks;
+
+	// Written by a background task and read only after awaiting it.
+	struct PreRenderedTrial {
+		std::string stimulus;
+		std::shared_ptr<AudioFrameReader> reader;
+		std::string readFailure;
+		bool complete{};
+	};
+	std::shared_ptr<PreRenderedTrial> nextTrial{};
+	std::string renderingKeyForTest{};
+	std::string processingKeyForTest{};
 	int framesPerBufferForTest{};
+	std::shared_ptr<LiveProcessor> calibrationProcessor{};
+	std::shared_ptr<StereoSimulationFactory> calibrationFactory{};
+	Calibration calibrationPlaying{};
+	double calibrationChainLevel_dB_Spl{};
+	AudioFrameProcessor::channel_type::index_type calibrationChainGroupDelay{};
 public:
 	SPATIALIZED_HA_SIMULATION_API SpatialHearingAidModel(
 		StimulusList *,
 		TestDocumenter *,
 		AudioPlayer *,
 		AudioProcessingLoaderFactory *,
+		AudioProcessingLoaderFactory *,
 		AudioFrameReaderFactory *,
 		AudioFrameWriterFactory *,
 		PrescriptionReader *,
 		BrirReader *,
+		ProcessingGraphReader *,
 		SimulationChannelFactory *,
-		CalibrationComputerFactory *
+		CalibrationComputerFactory *,
+		ProcessingGroupFactory *,
+		SignalCache *,
+		TaskRunner *,
+		TemporaryFiles *,
+		RealTimeSetup * = nullptr,
+		StimulusCache * = nullptr,
+		FileVersions * = nullptr,
+		TaskRunner *preloadTasks = nullptr
 	);
+	SPATIALIZED_HA_SIMULATION_API ~SpatialHearingAidModel() noexcept override;
 	SPATIALIZED_HA_SIMULATION_API void prepareNewTest(const Testing &) override;
 	SPATIALIZED_HA_SIMULATION_API void playNextTrial(const Trial &) override;
 	SPATIALIZED_HA_SIMULATION_API bool testComplete() override;
 	SPATIALIZED_HA_SIMULATION_API void playCalibration(const Calibration &) override;
 	SPATIALIZED_HA_SIMULATION_API void processAudioForSaving(const SavingAudio &) override;
 	SPATIALIZED_HA_SIMULATION_API void saveAudio(std::string) override;
+	SPATIALIZED_HA_SIMULATION_API void sweepParameters(const ParameterSweeping &) override;
 	SPATIALIZED_HA_SIMULATION_API void stopCalibration() override;
 	SPATIALIZED_HA_SIMULATION_API std::vector<std::string> audioDeviceDescriptions() override;
 	SPATIALIZED_HA_SIMULATION_API static const double fullScaleLevel_dB_Spl;
@@ -94,18 +183,57 @@ private:
 	struct PlayAudioRequest {
 		std::string audioFilePath;
 		std::string audioDevice;
+		std::string renderingKey;
+		std::string processingKey;
 		double level_dB_Spl;
 		int framesPerBuffer;
 		StereoSimulationFactory *processorFactory;
+		const PreRenderedTrial *preRendered;
+		bool calibrating;
 	};
 	void playAudio(const PlayAudioRequest &);
+	std::shared_ptr<const PreRenderedTrial> takePreRenderedNextTrial();
+	void preRenderNextTrial(bool speculative, double level_dB_Spl);
+	void startCalibration(const Calibration &);
+	void updateCalibration(const Calibration &);
+	bool updateCalibrationLive(const Calibration &);
+	std::shared_ptr<AudioLoader> makeProcessedLoader(
+		std::shared_ptr<const SignalCache::channels_type>,
+		int sampleRate
+	);
 	
 	struct MakeAudioLoader {
+		std::string renderingKey;
 		double level_dB_Spl;
 		std::shared_ptr<AudioFrameReader> reader;
 		StereoSimulationFactory *processorFactory;
+		AudioProcessingLoaderFactory *loaderFactory;
+		int framesPerBuffer;
 	};
 	std::shared_ptr<AudioLoader>makeLoader(const MakeAudioLoader &);
+	std::shared_ptr<AudioLoader> makeRenderedLoader(const MakeAudioLoader &);
+	std::shared_ptr<AudioLoader> makeCalibrationLoader(const MakeAudioLoader &);
+	std::shared_ptr<const SignalCache::channels_type> renderAtUnitGain(
+		const MakeAudioLoader &
+	);
+	std::shared_ptr<const SignalCache::channels_type> renderProcessed(
+		const std::string &key,
+		const MakeAudioLoader &
+	);
+	std::shared_ptr<const SignalCache::channels_type> findProcessed(
+		const std::string &key
+	);
+	SignalCache::channels_type render(AudioLoader &, int channels, int framesPerBuffer);
+	void writeProcessed(const std::string &key, const MakeAudioLoader &, AudioFrameWriter &);
+	std::string renderingKey(const SignalProcessing &, int framesPerBuffer);
+	std::string processingKey(const SignalProcessing &);
+	std::string versioned(const std::string &filePath);
+	std::string processedKey(
+		const std::string &processingKey,
+		double level_dB_Spl,
+		const std::string &stimulus,
+		AudioFrameReader &
+	);
 
 	void assertSizeIsPowerOfTwo(int);
 	int framesPerBuffer(const SignalProcessing &);
@@ -113,9 +241,17 @@ private:
 	PrescriptionReader::Dsl readPrescription(std::string filePath);
 	BrirReader::BinauralRoomImpulseResponse readBrir(std::string filePath);
 	std::shared_ptr<AudioFrameReader> makeReader(std::string filePath);
-	std::shared_ptr<AudioFrameWriter> makeWriter(std::string filePath);
+	std::shared_ptr<AudioFrameWriter> makeWriter(
+		std::string filePath,
+		const AudioFrameWriter::AudioFormat &
+	);
 	void prepareAudioPlayer(const AudioPlayer::Preparation &);
 	void prepareNewTest_(const Testing &);
+	void preload(std::vector<std::string> filePaths, std::function<void(int, int)> progress);
 	std::shared_ptr<StereoSimulationFactory> makeProcessorFactory(const SignalProcessing &);
 	StereoSimulationFactory::HearingAidSimulation hearingAidSimulation(const SignalProcessing &);
+	StereoSimulationFactory::ProcessingGraphSimulation processingGraphSimulation(
+		const SignalProcessing &
+	);
+	std::vector<ProcessingGraphReader::Node> readProcessingGraph(std::string filePath);
 };
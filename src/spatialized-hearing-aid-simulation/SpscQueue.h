@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producing and one consuming thread.
+template<typename T>
+class SpscQueue {
+	using size_type = typename std::vector<T>::size_type;
+	std::vector<T> slots;
+	alignas(64) std::atomic<size_type> head{ 0 };
+	alignas(64) std::atomic<size_type> tail{ 0 };
+public:
+	explicit SpscQueue(size_type capacity) :
+		slots(capacity + 1) {}
+
+	bool push(T item) {
+		const auto tail_ = tail.load(std::memory_order_relaxed);
+		const auto next = advance(tail_);
+		if (next == head.load(std::memory_order_acquire))
+			return false;
+		slots[tail_] = std::move(item);
+		tail.store(next, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T &item) {
+		const auto head_ = head.load(std::memory_order_relaxed);
+		if (head_ == tail.load(std::memory_order_acquire))
+			return false;
+		item = std::move(slots[head_]);
+		head.store(advance(head_), std::memory_order_release);
+		return true;
+	}
+
+	bool empty() const {
+		return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+	}
+
+private:
+	size_type advance(size_type position) const noexcept {
+		return position + 1 == slots.size() ? 0 : position + 1;
+	}
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "SignalProcessor.h"
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+template<typename Processor, typename = void>
+struct scalable : std::false_type {};
+
+template<typename Processor>
+struct scalable<
+	Processor, 
+	std::void_t<decltype(std::declval<Processor &>().setScale(1.0f))>
+> : std::true_type {};
+
+// Holds each stage by value so a fixed chain costs one virtual call per block
+// rather than one per stage.
+template<typename... Processors>
+class StaticSignalProcessingChain final : public SignalProcessor {
+	std::tuple<Processors...> processors;
+public:
+	template<typename... Arguments>
+	explicit StaticSignalProcessingChain(Arguments &&... arguments) :
+		processors{ std::forward<Arguments>(arguments)... } {}
+
+	// Stages declaring an allocator_type, such as those with buffers, are 
+	// given the allocator.
+	template<typename Allocator, typename... Arguments>
+	StaticSignalProcessingChain(
+		std::allocator_arg_t, 
+		const Allocator &allocator, 
+		Arguments &&... arguments
+	) :
+		processors{ std::allocator_arg, allocator, std::forward<Arguments>(arguments)... } {}
+
+	void process(signal_type signal) override {
+		std::apply(
+			[=](auto &... processor) { (processor.process(signal), ...); },
+			processors
+		);
+	}
+
+	index_type groupDelay() override {
+		return std::apply(
+			[](auto &... processor) { 
+				return (index_type{ 0 } + ... + processor.groupDelay()); 
+			},
+			processors
+		);
+	}
+
+	void reset() override {
+		std::apply([](auto &... processor) { (processor.reset(), ...); }, processors);
+	}
+
+	// Only stages with a gain, such as the calibration scale, take the scale.
+	void setScale(float scale) override {
+		std::apply(
+			[=](auto &... processor) { (setScale_(processor, scale), ...); },
+			processors
+		);
+	}
+
+private:
+	template<typename Processor>
+	static void setScale_(Processor &processor, float scale) {
+		if constexpr (scalable<Processor>::value)
+			processor.setScale(scale);
+	}
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "SimulationChannelFactoryImpl.h"
+#include "StaticSignalProcessingChain.h"
+#include "ProcessingArena.h"
+#include <mutex>
+#include <utility>
+
+template<typename Scaling, typename Fir, typename HearingAid>
+class StaticSimulationChannelFactory : public SimulationChannelFactory {
+	// Pre-rendering makes channels on a background thread while the control
+	// thread may be beginning another arena. The lock guards only which 
+	// arena is current; the arena guards its own memory.
+	ProcessingArena arena{};
+	std::mutex arenaMutex{};
+	FilterbankCompressorFactory *compressorFactory;
+public:
+	using without_simulation_type = StaticSignalProcessingChain<Scaling>;
+	using spatialization_type = StaticSignalProcessingChain<Scaling, Fir>;
+	using hearing_aid_simulation_type = StaticSignalProcessingChain<Scaling, HearingAid>;
+	using full_simulation_type = StaticSignalProcessingChain<Scaling, Fir, HearingAid>;
+
+	explicit StaticSimulationChannelFactory(
+		FilterbankCompressorFactory *compressorFactory
+	) noexcept :
+		compressorFactory{ compressorFactory } {}
+
+	std::shared_ptr<SignalProcessor> makeFullSimulation(
+		FullSimulation p, 
+		float scale
+	) override {
+		return make<full_simulation_type>(
+			scale,
+			std::move(p.spatialization.filterCoefficients),
+			makeCompressor(std::move(p.hearingAid))
+		);
+	}
+
+	std::shared_ptr<SignalProcessor> makeHearingAidSimulation(
+		HearingAidSimulation p, 
+		float scale
+	) override {
+		return make<hearing_aid_simulation_type>(
+			scale,
+			makeCompressor(std::move(p))
+		);
+	}
+
+	std::shared_ptr<SignalProcessor> makeSpatialization(
+		Spatialization p, 
+		float scale
+	) override {
+		return make<spatialization_type>(
+			scale,
+			std::move(p.filterCoefficients)
+		);
+	}
+
+	std::shared_ptr<SignalProcessor> makeWithoutSimulation(float scale) override {
+		return make<without_simulation_type>(scale);
+	}
+
+	void beginArena() override {
+		ProcessingArena next{};
+		std::lock_guard<std::mutex> lock{ arenaMutex };
+		std::swap(arena, next);
+	}
+
+private:
+	template<typename Chain, typename... Arguments>
+	std::shared_ptr<SignalProcessor> make(Arguments &&... arguments) {
+		return currentArena().template makeUsingAllocator<Chain>(
+			std::forward<Arguments>(arguments)...
+		);
+	}
+
+	ProcessingArena currentArena() {
+		std::lock_guard<std::mutex> lock{ arenaMutex };
+		return arena;
+	}
+
+	std::shared_ptr<FilterbankCompressor> makeCompressor(HearingAidSimulation p) {
+		return compressorFactory->make(
+			SimulationChannelFactoryImpl::compression(std::move(p))
+		);
+	}
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <common-includes/Interface.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Loads stimuli ahead of the trials that play them.
+class StimulusCache {
+public:
+    INTERFACE_OPERATIONS(StimulusCache)
+	// Files are loaded in the order given, as far as memory allows; one that
+	// cannot be loaded is left for its trial to report. Progress is 
+	// reported on the calling thread as files finish.
+	virtual void preload(
+		std::vector<std::string> filePaths,
+		std::function<void(int loaded, int total)> progress
+	) = 0;
+};
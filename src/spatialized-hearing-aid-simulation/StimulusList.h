@@ -3,6 +3,7 @@
 #include <common-includes/Interface.h>
 #include <common-includes/RuntimeError.h>
 #include <string>
+#include <vector>
 
 class StimulusList {
 public:
@@ -11,4 +12,6 @@ public:
     RUNTIME_ERROR(InitializationFailure)
 	virtual std::string next() = 0;
 	virtual bool empty() = 0;
+	// What next returns from here on, in order.
+	virtual std::vector<std::string> remaining() = 0;
 };
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <common-includes/Interface.h>
+#include <functional>
+
+// Runs tasks away from the caller, one at a time and in the order given.
+class TaskRunner {
+public:
+    INTERFACE_OPERATIONS(TaskRunner)
+	virtual void run(std::function<void()>) = 0;
+	// Returns once every task given so far has finished.
+	virtual void await() = 0;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <common-includes/Interface.h>
+#include <common-includes/RuntimeError.h>
+#include <string>
+
+// Files to write to before it is known where their contents belong.
+class TemporaryFiles {
+public:
+    INTERFACE_OPERATIONS(TemporaryFiles)
+	// A path that no other file uses.
+	virtual std::string make() = 0;
+	virtual void copy(std::string from, std::string to) = 0;
+	// Never throws, so it can be called while destroying.
+	virtual void remove(std::string) = 0;
+	RUNTIME_ERROR(CopyFailure)
+};
@@ -22,6 +22,12 @@ void ZeroPaddedLoader::load(gsl::span<channel_type> audio) {
 	processor->process(audio);
 }
 
+void ZeroPaddedLoader::prime(gsl::span<channel_type> silence) {
+	processor->process(silence);
+	processor->reset();
+	reader->prepareForPlayback();
+}
+
 void ZeroPaddedLoader::padZeros(gsl::span<channel_type> audio, long long zerosToPad) {
 	for (auto channel : audio)
 		std::fill(
@@ -14,6 +14,7 @@ public:
 	) noexcept;
 	SPATIALIZED_HA_SIMULATION_API void reset();
 	SPATIALIZED_HA_SIMULATION_API void load(gsl::span<channel_type> audio) override;
+	SPATIALIZED_HA_SIMULATION_API void prime(gsl::span<channel_type> silence) override;
 	SPATIALIZED_HA_SIMULATION_API bool complete() override;
 private:
 	void padZeros(gsl::span<channel_type> audio, long long zerosToPad);
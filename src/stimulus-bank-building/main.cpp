@@ -0,0 +1,69 @@
+#include <main/Libsndfile.h>
+#include <audio-file-reading-writing/StimulusBank.h>
+#include <audio-file-reading-writing/StimulusBankBuilder.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// Packs a stimulus directory's WAV files into a bank in that directory.
+// Tests then read the directory's stimuli from the bank, so it should be
+// built again whenever the directory's files change.
+
+static bool wav(const std::filesystem::path &p) {
+	return p.extension() == ".wav";
+}
+
+int main(int argc, char *argv[]) {
+	if (argc != 2) {
+		std::cerr << "usage: stimulus-bank-building <stimulus directory>\n";
+		return 1;
+	}
+	const std::string directory{ argv[1] };
+	std::vector<std::filesystem::path> stimuli;
+	try {
+		for (const auto &entry : std::filesystem::directory_iterator{ directory })
+			if (entry.is_regular_file() && wav(entry.path()))
+				stimuli.push_back(entry.path());
+	}
+	catch (const std::filesystem::filesystem_error &e) {
+		std::cerr << e.what() << '\n';
+		return 1;
+	}
+	std::sort(stimuli.begin(), stimuli.end());
+
+	LibsndfileFactory files{};
+	StimulusBankBuilder builder{ &files };
+	for (const auto &stimulus : stimuli)
+		builder.add(stimulus.filename().string(), stimulus.string());
+	// The app may have the bank mapped, so it is never written in place: 
+	// the new one is written beside it and renamed over it, leaving the old
+	// file intact for mappings already made. Windows refuses to replace a 
+	// mapped file, in which case the old bank stays.
+	const auto bankPath = directory + "/" + StimulusBank::fileName;
+	const auto buildingPath = bankPath + ".building";
+	std::ofstream bank{ buildingPath, std::ios::binary };
+	try {
+		builder.write(bank);
+	}
+	catch (const StimulusBankBuilder::FileError &e) {
+		std::cerr << e.what() << '\n';
+		bank.close();
+		std::filesystem::remove(buildingPath);
+		return 1;
+	}
+	bank.close();
+	if (!bank) {
+		std::cerr << buildingPath << " cannot be written.\n";
+		std::filesystem::remove(buildingPath);
+		return 1;
+	}
+	std::error_code error;
+	std::filesystem::rename(buildingPath, bankPath, error);
+	if (error) {
+		std::cerr << bankPath << " cannot be replaced: " << error.message() << '\n';
+		std::filesystem::remove(buildingPath);
+		return 1;
+	}
+	std::cout << stimuli.size() << " stimuli packed into " << bankPath << '\n';
+}
@@ -26,6 +26,13 @@ std::string RandomizedStimulusList::next() {
     return directory_ + "/" + current_;
 }
 
+std::vector<std::string> RandomizedStimulusList::remaining() {
+	std::vector<std::string> filePaths;
+	for (const auto &file : files)
+		filePaths.push_back(directory_ + "/" + file);
+	return filePaths;
+}
+
 std::shared_ptr<DirectoryReader> RandomizedStimulusList::makeReader(std::string directory) {	
 	auto reader = factory->make(std::move(directory));
 	if (reader->failed())
@@ -17,6 +17,7 @@ public:
     void initialize(std::string directory) override;
     bool empty() override;
     std::string next() override;
+    std::vector<std::string> remaining() override;
 private:
 	std::shared_ptr<DirectoryReader> makeReader(std::string directory);
 };